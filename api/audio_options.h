@@ -73,6 +73,11 @@ struct RTC_EXPORT AudioOptions {
   // true.
   // TODO(webrtc:13566): Remove this option. See issue for details.
   absl::optional<bool> init_recording_on_send;
+  // Send streams of sources with the same group share their encoders when
+  // encoder sharing is enabled, see
+  // cricket::MediaConfig::Audio::shared_encoder_bitrates_bps. Only sources
+  // that deliver the same audio may use the same group.
+  absl::optional<std::string> shared_encoder_group;
 };
 
 }  // namespace cricket
@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <set>
+#include <vector>
+
+#include "api/crypto/aes_gcm_frame_decryptor.h"
+#include "api/crypto/aes_gcm_frame_encryptor.h"
+#include "api/crypto/sframe_header.h"
+#include "api/make_ref_counted.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr uint8_t kKey[16] = {0, 1, 2,  3,  4,  5,  6,  7,
+                              8, 9, 10, 11, 12, 13, 14, 15};
+constexpr uint8_t kSalt[12] = {42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53};
+constexpr uint8_t kOtherKey[32] = {1};
+constexpr uint32_t kSsrc = 1234;
+
+std::vector<uint8_t> Encrypt(AesGcmFrameEncryptor& encryptor,
+                             rtc::ArrayView<const uint8_t> frame,
+                             rtc::ArrayView<const uint8_t> additional_data) {
+  std::vector<uint8_t> encrypted(encryptor.GetMaxCiphertextByteSize(
+      cricket::MEDIA_TYPE_VIDEO, frame.size()));
+  size_t bytes_written = 0;
+  EXPECT_EQ(encryptor.Encrypt(cricket::MEDIA_TYPE_VIDEO, kSsrc,
+                              additional_data, frame, encrypted,
+                              &bytes_written),
+            0);
+  encrypted.resize(bytes_written);
+  return encrypted;
+}
+
+TEST(SFrameHeaderTest, WritesAndParsesInlineAndExtendedValues) {
+  for (uint64_t value : {uint64_t{0}, uint64_t{7}, uint64_t{8}, uint64_t{255},
+                         uint64_t{256}, ~uint64_t{0}}) {
+    SFrameHeader header;
+    header.key_id = value;
+    header.counter = ~value;
+    uint8_t buffer[SFrameHeader::kMaxSize];
+    size_t size = header.Write(buffer);
+    EXPECT_EQ(size, header.size());
+
+    SFrameHeader parsed;
+    EXPECT_EQ(SFrameHeader::Parse(rtc::MakeArrayView(buffer, size), &parsed),
+              size);
+    EXPECT_EQ(parsed.key_id, header.key_id);
+    EXPECT_EQ(parsed.counter, header.counter);
+    // Truncated headers are rejected.
+    EXPECT_EQ(
+        SFrameHeader::Parse(rtc::MakeArrayView(buffer, size - 1), &parsed), 0u);
+  }
+}
+
+TEST(AesGcmFrameCryptoTest, RejectsInvalidKeyMaterial) {
+  EXPECT_FALSE(AesGcmFrameEncryptor::Create(0, rtc::MakeArrayView(kKey, 15),
+                                            kSalt));
+  EXPECT_FALSE(AesGcmFrameEncryptor::Create(0, kKey,
+                                            rtc::MakeArrayView(kSalt, 11)));
+  auto decryptor = rtc::make_ref_counted<AesGcmFrameDecryptor>();
+  EXPECT_FALSE(decryptor->SetKey(0, rtc::MakeArrayView(kKey, 24), kSalt));
+}
+
+TEST(AesGcmFrameCryptoTest, DecryptsInPlace) {
+  auto encryptor = AesGcmFrameEncryptor::Create(3, kKey, kSalt);
+  ASSERT_TRUE(encryptor);
+  auto decryptor = rtc::make_ref_counted<AesGcmFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(3, kKey, kSalt));
+
+  const std::vector<uint8_t> additional_data = {9, 8, 7};
+  for (int i = 0; i < 10; ++i) {
+    const std::vector<uint8_t> frame(100 + i, static_cast<uint8_t>(i));
+    std::vector<uint8_t> buffer = Encrypt(*encryptor, frame, additional_data);
+    EXPECT_GT(buffer.size(), frame.size());
+
+    // The video receive path decrypts within the received frame's buffer.
+    rtc::ArrayView<uint8_t> output(
+        buffer.data(), decryptor->GetMaxPlaintextByteSize(
+                           cricket::MEDIA_TYPE_VIDEO, buffer.size()));
+    FrameDecryptorInterface::Result result = decryptor->Decrypt(
+        cricket::MEDIA_TYPE_VIDEO, {}, additional_data, buffer, output);
+    ASSERT_TRUE(result.IsOk());
+    EXPECT_THAT(output.subview(0, result.bytes_written),
+                ElementsAreArray(frame));
+  }
+}
+
+TEST(AesGcmFrameCryptoTest, RejectsTamperedFrameAndAdditionalData) {
+  auto encryptor = AesGcmFrameEncryptor::Create(0, kKey, kSalt);
+  ASSERT_TRUE(encryptor);
+  auto decryptor = rtc::make_ref_counted<AesGcmFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(0, kKey, kSalt));
+
+  const std::vector<uint8_t> frame(50, 1);
+  const std::vector<uint8_t> additional_data = {9, 8, 7};
+  const std::vector<uint8_t> encrypted =
+      Encrypt(*encryptor, frame, additional_data);
+  std::vector<uint8_t> output(frame.size());
+
+  std::vector<uint8_t> tampered = encrypted;
+  tampered[10] ^= 1;
+  EXPECT_EQ(decryptor
+                ->Decrypt(cricket::MEDIA_TYPE_VIDEO, {}, additional_data,
+                          tampered, output)
+                .status,
+            FrameDecryptorInterface::Status::kFailedToDecrypt);
+
+  const std::vector<uint8_t> other_additional_data = {9, 8, 6};
+  EXPECT_EQ(decryptor
+                ->Decrypt(cricket::MEDIA_TYPE_VIDEO, {}, other_additional_data,
+                          encrypted, output)
+                .status,
+            FrameDecryptorInterface::Status::kFailedToDecrypt);
+
+  EXPECT_TRUE(decryptor
+                  ->Decrypt(cricket::MEDIA_TYPE_VIDEO, {}, additional_data,
+                            encrypted, output)
+                  .IsOk());
+}
+
+TEST(AesGcmFrameCryptoTest, SelectsKeyByKeyId) {
+  auto old_encryptor = AesGcmFrameEncryptor::Create(1, kKey, kSalt);
+  auto new_encryptor = AesGcmFrameEncryptor::Create(2, kOtherKey, kSalt);
+  ASSERT_TRUE(old_encryptor);
+  ASSERT_TRUE(new_encryptor);
+  auto decryptor = rtc::make_ref_counted<AesGcmFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(1, kKey, kSalt));
+
+  const std::vector<uint8_t> frame(20, 5);
+  std::vector<uint8_t> output(frame.size());
+  const std::vector<uint8_t> old_frame = Encrypt(*old_encryptor, frame, {});
+  const std::vector<uint8_t> new_frame = Encrypt(*new_encryptor, frame, {});
+
+  // A frame for a key that has not arrived yet may become decryptable.
+  EXPECT_EQ(
+      decryptor->Decrypt(cricket::MEDIA_TYPE_AUDIO, {}, {}, new_frame, output)
+          .status,
+      FrameDecryptorInterface::Status::kRecoverable);
+
+  ASSERT_TRUE(decryptor->SetKey(2, kOtherKey, kSalt));
+  EXPECT_TRUE(
+      decryptor->Decrypt(cricket::MEDIA_TYPE_AUDIO, {}, {}, old_frame, output)
+          .IsOk());
+  EXPECT_TRUE(
+      decryptor->Decrypt(cricket::MEDIA_TYPE_AUDIO, {}, {}, new_frame, output)
+          .IsOk());
+
+  decryptor->RemoveKey(1);
+  EXPECT_FALSE(
+      decryptor->Decrypt(cricket::MEDIA_TYPE_AUDIO, {}, {}, old_frame, output)
+          .IsOk());
+}
+
+TEST(AesGcmFrameCryptoTest, EncryptorsSharingAKeyNeverReuseANonce) {
+  auto first = AesGcmFrameEncryptor::Create(0, kKey, kSalt);
+  auto second = AesGcmFrameEncryptor::Create(0, kKey, kSalt);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+
+  std::set<uint64_t> counters;
+  const std::vector<uint8_t> frame(10, 3);
+  for (int i = 0; i < 100; ++i) {
+    for (AesGcmFrameEncryptor* encryptor : {first.get(), second.get()}) {
+      SFrameHeader header;
+      ASSERT_GT(SFrameHeader::Parse(Encrypt(*encryptor, frame, {}), &header),
+                0u);
+      // The salt is the same, so a repeated counter is a repeated nonce.
+      EXPECT_TRUE(counters.insert(header.counter).second);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
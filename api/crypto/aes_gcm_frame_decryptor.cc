@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/aes_gcm_frame_decryptor.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kTagSize = rtc::OpenSSLAesGcm::kTagSize;
+
+}  // namespace
+
+AesGcmFrameDecryptor::AesGcmFrameDecryptor() = default;
+
+AesGcmFrameDecryptor::~AesGcmFrameDecryptor() = default;
+
+bool AesGcmFrameDecryptor::SetKey(uint64_t key_id,
+                                  rtc::ArrayView<const uint8_t> key,
+                                  rtc::ArrayView<const uint8_t> salt) {
+  std::unique_ptr<rtc::OpenSSLAesGcm> aead = rtc::OpenSSLAesGcm::Create(key);
+  if (!aead || salt.size() != SFrameHeader::kSaltSize) {
+    return false;
+  }
+  Key entry;
+  entry.aead = std::move(aead);
+  std::copy(salt.begin(), salt.end(), entry.salt.begin());
+  MutexLock lock(&mutex_);
+  keys_[key_id] = std::move(entry);
+  return true;
+}
+
+void AesGcmFrameDecryptor::RemoveKey(uint64_t key_id) {
+  MutexLock lock(&mutex_);
+  keys_.erase(key_id);
+}
+
+AesGcmFrameDecryptor::Result AesGcmFrameDecryptor::Decrypt(
+    cricket::MediaType media_type,
+    const std::vector<uint32_t>& csrcs,
+    rtc::ArrayView<const uint8_t> additional_data,
+    rtc::ArrayView<const uint8_t> encrypted_frame,
+    rtc::ArrayView<uint8_t> frame) {
+  SFrameHeader header;
+  const size_t header_size = SFrameHeader::Parse(encrypted_frame, &header);
+  if (header_size == 0 || encrypted_frame.size() < header_size + kTagSize) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+  const size_t ciphertext_size =
+      encrypted_frame.size() - header_size - kTagSize;
+  if (frame.size() < ciphertext_size) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+
+  MutexLock lock(&mutex_);
+  const auto key = keys_.find(header.key_id);
+  if (key == keys_.end()) {
+    // The key may not have been delivered yet.
+    return Result(Status::kRecoverable, 0);
+  }
+
+  // Decrypting in place is only supported when input and output start at the
+  // same address, so move the ciphertext to the front of `frame` first. The
+  // header and tag it may overwrite are copied out beforehand.
+  std::array<uint8_t, SFrameHeader::kMaxSize> header_bytes;
+  std::array<uint8_t, kTagSize> tag;
+  memcpy(header_bytes.data(), encrypted_frame.data(), header_size);
+  memcpy(tag.data(), encrypted_frame.data() + header_size + ciphertext_size,
+         kTagSize);
+  memmove(frame.data(), encrypted_frame.data() + header_size, ciphertext_size);
+
+  rtc::ArrayView<uint8_t> plaintext = frame.subview(0, ciphertext_size);
+  const rtc::ArrayView<const uint8_t> aad[] = {
+      rtc::ArrayView<const uint8_t>(header_bytes.data(), header_size),
+      additional_data};
+  if (!key->second.aead->Open(
+          SFrameHeader::Nonce(key->second.salt, header.counter), aad,
+          plaintext, tag, plaintext)) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+  return Result(Status::kOk, ciphertext_size);
+}
+
+size_t AesGcmFrameDecryptor::GetMaxPlaintextByteSize(
+    cricket::MediaType media_type,
+    size_t encrypted_frame_size) {
+  // The smallest header is the config byte alone.
+  const size_t min_overhead = 1 + kTagSize;
+  return encrypted_frame_size > min_overhead
+             ? encrypted_frame_size - min_overhead
+             : 0;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_AES_GCM_FRAME_DECRYPTOR_H_
+#define API_CRYPTO_AES_GCM_FRAME_DECRYPTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/crypto/frame_decryptor_interface.h"
+#include "api/crypto/sframe_header.h"
+#include "api/media_types.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/openssl_aes_gcm.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Decrypts frames produced by AesGcmFrameEncryptor. Keys are looked up by the
+// key id in each frame's header, so that the keys of a sender that is rotating
+// them can be installed side by side.
+//
+// `encrypted_frame` and `frame` may share their start address, as they do when
+// called from the video receive path; the frame is then decrypted in place.
+class AesGcmFrameDecryptor : public FrameDecryptorInterface {
+ public:
+  AesGcmFrameDecryptor();
+
+  // Adds, or replaces, the key used for frames with `key_id`. Returns false
+  // unless `key` is 16 or 32 bytes and `salt` is 12 bytes.
+  bool SetKey(uint64_t key_id,
+              rtc::ArrayView<const uint8_t> key,
+              rtc::ArrayView<const uint8_t> salt);
+  void RemoveKey(uint64_t key_id);
+
+  // Implements FrameDecryptorInterface.
+  Result Decrypt(cricket::MediaType media_type,
+                 const std::vector<uint32_t>& csrcs,
+                 rtc::ArrayView<const uint8_t> additional_data,
+                 rtc::ArrayView<const uint8_t> encrypted_frame,
+                 rtc::ArrayView<uint8_t> frame) override;
+  size_t GetMaxPlaintextByteSize(cricket::MediaType media_type,
+                                 size_t encrypted_frame_size) override;
+
+ protected:
+  ~AesGcmFrameDecryptor() override;
+
+ private:
+  struct Key {
+    std::unique_ptr<rtc::OpenSSLAesGcm> aead;
+    std::array<uint8_t, SFrameHeader::kSaltSize> salt;
+  };
+
+  Mutex mutex_;
+  flat_map<uint64_t, Key> keys_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_AES_GCM_FRAME_DECRYPTOR_H_
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/aes_gcm_frame_encryptor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/helpers.h"
+
+namespace webrtc {
+
+rtc::scoped_refptr<AesGcmFrameEncryptor> AesGcmFrameEncryptor::Create(
+    uint64_t key_id,
+    rtc::ArrayView<const uint8_t> key,
+    rtc::ArrayView<const uint8_t> salt) {
+  std::unique_ptr<rtc::OpenSSLAesGcm> aead = rtc::OpenSSLAesGcm::Create(key);
+  if (!aead || salt.size() != SFrameHeader::kSaltSize) {
+    return nullptr;
+  }
+  std::array<uint8_t, SFrameHeader::kSaltSize> salt_array;
+  std::copy(salt.begin(), salt.end(), salt_array.begin());
+  return rtc::make_ref_counted<AesGcmFrameEncryptor>(key_id, std::move(aead),
+                                                     salt_array);
+}
+
+AesGcmFrameEncryptor::AesGcmFrameEncryptor(
+    uint64_t key_id,
+    std::unique_ptr<rtc::OpenSSLAesGcm> aead,
+    const std::array<uint8_t, SFrameHeader::kSaltSize>& salt)
+    : key_id_(key_id),
+      aead_(std::move(aead)),
+      salt_(salt),
+      counter_(rtc::CreateRandomId64()) {}
+
+int AesGcmFrameEncryptor::Encrypt(cricket::MediaType media_type,
+                                  uint32_t ssrc,
+                                  rtc::ArrayView<const uint8_t> additional_data,
+                                  rtc::ArrayView<const uint8_t> frame,
+                                  rtc::ArrayView<uint8_t> encrypted_frame,
+                                  size_t* bytes_written) {
+  SFrameHeader header;
+  header.key_id = key_id_;
+  header.counter = counter_.fetch_add(1, std::memory_order_relaxed);
+  const size_t header_size = header.size();
+  const size_t total_size =
+      header_size + frame.size() + rtc::OpenSSLAesGcm::kTagSize;
+  if (encrypted_frame.size() < total_size) {
+    return static_cast<int>(Status::kBufferTooSmall);
+  }
+
+  header.Write(encrypted_frame);
+  rtc::ArrayView<const uint8_t> header_view =
+      encrypted_frame.subview(0, header_size);
+  rtc::ArrayView<uint8_t> ciphertext =
+      encrypted_frame.subview(header_size, frame.size());
+  rtc::ArrayView<uint8_t> tag = encrypted_frame.subview(
+      header_size + frame.size(), rtc::OpenSSLAesGcm::kTagSize);
+
+  // The header is authenticated along with the caller's data.
+  const rtc::ArrayView<const uint8_t> aad[] = {header_view, additional_data};
+  if (!aead_->Seal(SFrameHeader::Nonce(salt_, header.counter), aad, frame,
+                   ciphertext, tag)) {
+    return static_cast<int>(Status::kEncryptionFailed);
+  }
+  *bytes_written = total_size;
+  return static_cast<int>(Status::kOk);
+}
+
+size_t AesGcmFrameEncryptor::GetMaxCiphertextByteSize(
+    cricket::MediaType media_type,
+    size_t frame_size) {
+  return SFrameHeader::kMaxSize + frame_size + rtc::OpenSSLAesGcm::kTagSize;
+}
+
+}  // namespace webrtc
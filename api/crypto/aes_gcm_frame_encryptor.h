@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_AES_GCM_FRAME_ENCRYPTOR_H_
+#define API_CRYPTO_AES_GCM_FRAME_ENCRYPTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/crypto/frame_encryptor_interface.h"
+#include "api/crypto/sframe_header.h"
+#include "api/media_types.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/openssl_aes_gcm.h"
+
+namespace webrtc {
+
+// Encrypts frames with AES-GCM in the SFrame format (RFC 9605): an SFrame
+// header carrying the key id and a per-frame counter, the ciphertext and a
+// 16 byte tag. The header and any additional data passed to Encrypt() are
+// authenticated. Unlike RFC 9605, the AEAD key and salt are supplied directly
+// instead of being derived from a base key with HKDF.
+//
+// Encrypt() may be called concurrently, e.g. by the per-layer senders of a
+// simulcast stream. To change keys, create a new encryptor with a new key id
+// and attach it to the sender.
+//
+// The GCM nonce is the salt XORed with the frame counter, so it must never
+// repeat for a key. Each encryptor starts its counter at a random 64 bit value
+// instead of at zero, which keeps the nonces of encryptors that share a key
+// and salt (e.g. one recreated after renegotiation) apart. The counter is then
+// always sent in its extended encoding, which costs up to 8 header bytes.
+class AesGcmFrameEncryptor : public FrameEncryptorInterface {
+ public:
+  enum class Status : int {
+    kOk = 0,
+    kBufferTooSmall = 1,
+    kEncryptionFailed = 2,
+  };
+
+  // Returns null unless `key` is 16 or 32 bytes and `salt` is 12 bytes.
+  static rtc::scoped_refptr<AesGcmFrameEncryptor> Create(
+      uint64_t key_id,
+      rtc::ArrayView<const uint8_t> key,
+      rtc::ArrayView<const uint8_t> salt);
+
+  // Implements FrameEncryptorInterface. The ciphertext is written straight
+  // into `encrypted_frame`; no intermediate buffer is used.
+  int Encrypt(cricket::MediaType media_type,
+              uint32_t ssrc,
+              rtc::ArrayView<const uint8_t> additional_data,
+              rtc::ArrayView<const uint8_t> frame,
+              rtc::ArrayView<uint8_t> encrypted_frame,
+              size_t* bytes_written) override;
+  size_t GetMaxCiphertextByteSize(cricket::MediaType media_type,
+                                  size_t frame_size) override;
+
+ protected:
+  AesGcmFrameEncryptor(
+      uint64_t key_id,
+      std::unique_ptr<rtc::OpenSSLAesGcm> aead,
+      const std::array<uint8_t, SFrameHeader::kSaltSize>& salt);
+
+ private:
+  const uint64_t key_id_;
+  const std::unique_ptr<rtc::OpenSSLAesGcm> aead_;
+  const std::array<uint8_t, SFrameHeader::kSaltSize> salt_;
+  // Starts at a random value, see the class comment.
+  std::atomic<uint64_t> counter_;
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_AES_GCM_FRAME_ENCRYPTOR_H_
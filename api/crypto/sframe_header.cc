@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_header.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint8_t kExtendedKeyIdFlag = 0x80;
+constexpr uint8_t kExtendedCounterFlag = 0x08;
+constexpr uint64_t kMaxInlineValue = 7;
+
+// Number of bytes in the minimal big-endian encoding of `value`, at least 1.
+size_t EncodedLength(uint64_t value) {
+  size_t length = 1;
+  while (value > 0xff) {
+    value >>= 8;
+    ++length;
+  }
+  return length;
+}
+
+size_t WriteBigEndian(uint64_t value, size_t length, uint8_t* out) {
+  for (size_t i = 0; i < length; ++i) {
+    out[length - 1 - i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+  return length;
+}
+
+uint64_t ReadBigEndian(const uint8_t* in, size_t length) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    value = (value << 8) | in[i];
+  }
+  return value;
+}
+
+}  // namespace
+
+size_t SFrameHeader::size() const {
+  size_t size = 1;
+  if (key_id > kMaxInlineValue) {
+    size += EncodedLength(key_id);
+  }
+  if (counter > kMaxInlineValue) {
+    size += EncodedLength(counter);
+  }
+  return size;
+}
+
+size_t SFrameHeader::Write(rtc::ArrayView<uint8_t> buffer) const {
+  RTC_DCHECK_GE(buffer.size(), size());
+  uint8_t* out = buffer.data() + 1;
+  uint8_t config = 0;
+  if (key_id > kMaxInlineValue) {
+    size_t length = EncodedLength(key_id);
+    config |= kExtendedKeyIdFlag | static_cast<uint8_t>((length - 1) << 4);
+    out += WriteBigEndian(key_id, length, out);
+  } else {
+    config |= static_cast<uint8_t>(key_id << 4);
+  }
+  if (counter > kMaxInlineValue) {
+    size_t length = EncodedLength(counter);
+    config |= kExtendedCounterFlag | static_cast<uint8_t>(length - 1);
+    out += WriteBigEndian(counter, length, out);
+  } else {
+    config |= static_cast<uint8_t>(counter);
+  }
+  buffer[0] = config;
+  return out - buffer.data();
+}
+
+size_t SFrameHeader::Parse(rtc::ArrayView<const uint8_t> data,
+                           SFrameHeader* header) {
+  if (data.empty()) {
+    return 0;
+  }
+  const uint8_t config = data[0];
+  size_t size = 1;
+  const size_t key_id_field = (config >> 4) & 0x07;
+  if (config & kExtendedKeyIdFlag) {
+    size_t length = key_id_field + 1;
+    if (data.size() < size + length) {
+      return 0;
+    }
+    header->key_id = ReadBigEndian(data.data() + size, length);
+    size += length;
+  } else {
+    header->key_id = key_id_field;
+  }
+  const size_t counter_field = config & 0x07;
+  if (config & kExtendedCounterFlag) {
+    size_t length = counter_field + 1;
+    if (data.size() < size + length) {
+      return 0;
+    }
+    header->counter = ReadBigEndian(data.data() + size, length);
+    size += length;
+  } else {
+    header->counter = counter_field;
+  }
+  return size;
+}
+
+std::array<uint8_t, SFrameHeader::kSaltSize> SFrameHeader::Nonce(
+    const std::array<uint8_t, kSaltSize>& salt,
+    uint64_t counter) {
+  std::array<uint8_t, kSaltSize> nonce = salt;
+  for (size_t i = 0; i < 8; ++i) {
+    nonce[kSaltSize - 1 - i] ^= static_cast<uint8_t>(counter >> (8 * i));
+  }
+  return nonce;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_SFRAME_HEADER_H_
+#define API_CRYPTO_SFRAME_HEADER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// The header that prefixes an SFrame ciphertext (RFC 9605, section 4.3). A
+// config byte holds the key id and the counter directly when they are below 8,
+// and otherwise the length of their big-endian encoding, which then follows.
+struct SFrameHeader {
+  static constexpr size_t kMaxSize = 1 + 8 + 8;
+  static constexpr size_t kSaltSize = 12;
+
+  // Returns the encoded size of the header.
+  size_t size() const;
+
+  // Writes the header to the start of `buffer`, which must hold at least
+  // size() bytes, and returns the number of bytes written.
+  size_t Write(rtc::ArrayView<uint8_t> buffer) const;
+
+  // Parses a header from the start of `data` into `header`. Returns the size of
+  // the header, or 0 if `data` does not start with a complete header.
+  static size_t Parse(rtc::ArrayView<const uint8_t> data,
+                      SFrameHeader* header);
+
+  // Returns the AEAD nonce for `counter`: `salt` XORed with the counter,
+  // big-endian and right-aligned.
+  static std::array<uint8_t, kSaltSize> Nonce(
+      const std::array<uint8_t, kSaltSize>& salt,
+      uint64_t counter);
+
+  uint64_t key_id = 0;
+  uint64_t counter = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_SFRAME_HEADER_H_
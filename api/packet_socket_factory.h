@@ -49,6 +49,10 @@ class RTC_EXPORT PacketSocketFactory {
     OPT_TLS_FAKE = 0x01,      // Fake TLS with a dummy SSL handshake.
     OPT_TLS_INSECURE = 0x08,  // Insecure TLS without certificate validation.
 
+    // Used with OPT_TLS or OPT_TLS_INSECURE: lets the kernel encrypt outgoing
+    // records once the handshake is done, where supported.
+    OPT_TLS_KERNEL_OFFLOAD = 0x10,
+
     // Deprecated, use OPT_TLS_FAKE.
     OPT_SSLTCP = OPT_TLS_FAKE,
   };
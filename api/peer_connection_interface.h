@@ -73,6 +73,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/base/attributes.h"
@@ -119,6 +120,7 @@
 #include "api/transport/network_control.h"
 #include "api/transport/sctp_transport_factory_interface.h"
 #include "api/turn_customizer.h"
+#include "api/units/time_delta.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "call/rtp_transport_controller_send_factory_interface.h"
 #include "media/base/media_config.h"
@@ -376,6 +378,13 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
           audio_rtcp_report_interval_ms;
     }
 
+    const std::vector<int>& shared_audio_encoder_bitrates_bps() const {
+      return media_config.audio.shared_encoder_bitrates_bps;
+    }
+    void set_shared_audio_encoder_bitrates_bps(std::vector<int> bitrates_bps) {
+      media_config.audio.shared_encoder_bitrates_bps = std::move(bitrates_bps);
+    }
+
     int video_rtcp_report_interval_ms() const {
       return media_config.video.rtcp_report_interval_ms;
     }
@@ -1420,6 +1429,11 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   ~PeerConnectionFactoryDependencies();
 
   // Optional dependencies
+  // `worker_thread` may be the same thread as `network_thread`. In that
+  // configuration packets are handed between transports and media streams by
+  // direct calls instead of posted tasks, and blocking calls between the two
+  // are elided. This is intended for deployments that shard PeerConnections
+  // across cores with one thread per shard.
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
@@ -1427,6 +1441,11 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   // The `packet_socket_factory` will only be used if CreatePeerConnection is
   // called without a `port_allocator`.
   std::unique_ptr<rtc::PacketSocketFactory> packet_socket_factory;
+  // If set, the packet socket factory created when `packet_socket_factory` is
+  // null caches DNS results for this long, so that the STUN and TURN servers
+  // are resolved once for all the PeerConnections of the factory instead of
+  // once per port.
+  absl::optional<TimeDelta> dns_cache_ttl;
   std::unique_ptr<TaskQueueFactory> task_queue_factory;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
   std::unique_ptr<CallFactoryInterface> call_factory;
@@ -21,6 +21,7 @@
 #include "api/call/transport.h"
 #include "api/crypto/frame_encryptor_interface.h"
 #include "api/function_view.h"
+#include "api/make_ref_counted.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/task_queue/task_queue_base.h"
 #include "audio/audio_state.h"
@@ -39,6 +40,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/audio_format_to_string.h"
+#include "rtc_base/strings/string_builder.h"
 #include "rtc_base/trace_event.h"
 
 namespace webrtc {
@@ -76,6 +78,32 @@ void UpdateEventLogStreamConfig(RtcEventLog* event_log,
       std::move(rtclog_config)));
 }
 
+// Wraps `encoder` in the CNG and RED encoders enabled by `spec`.
+std::unique_ptr<AudioEncoder> WrapSpeechEncoder(
+    const AudioSendStream::Config::SendCodecSpec& spec,
+    std::unique_ptr<AudioEncoder> encoder,
+    const FieldTrialsView& field_trials) {
+  // Wrap the encoder in an AudioEncoderCNG, if VAD is enabled.
+  if (spec.cng_payload_type) {
+    AudioEncoderCngConfig cng_config;
+    cng_config.num_channels = encoder->NumChannels();
+    cng_config.payload_type = *spec.cng_payload_type;
+    cng_config.speech_encoder = std::move(encoder);
+    cng_config.vad_mode = Vad::kVadNormal;
+    encoder = CreateComfortNoiseEncoder(std::move(cng_config));
+  }
+
+  // Wrap the encoder in a RED encoder, if RED is enabled.
+  if (spec.red_payload_type) {
+    AudioEncoderCopyRed::Config red_config;
+    red_config.payload_type = *spec.red_payload_type;
+    red_config.speech_encoder = std::move(encoder);
+    encoder = std::make_unique<AudioEncoderCopyRed>(std::move(red_config),
+                                                    field_trials);
+  }
+  return encoder;
+}
+
 }  // namespace
 
 constexpr char AudioAllocationConfig::kKey[];
@@ -146,6 +174,7 @@ AudioSendStream::AudioSendStream(
     std::unique_ptr<voe::ChannelSendInterface> channel_send,
     const FieldTrialsView& field_trials)
     : clock_(clock),
+      task_queue_factory_(task_queue_factory),
       field_trials_(field_trials),
       rtp_transport_queue_(rtp_transport->GetWorkerQueue()),
       allocate_audio_without_feedback_(
@@ -634,28 +663,12 @@ bool AudioSendStream::SetupSendCodec(const Config& new_config) {
     }
   }
 
-  // Wrap the encoder in an AudioEncoderCNG, if VAD is enabled.
+  encoder = WrapSpeechEncoder(spec, std::move(encoder), field_trials_);
   if (spec.cng_payload_type) {
-    AudioEncoderCngConfig cng_config;
-    cng_config.num_channels = encoder->NumChannels();
-    cng_config.payload_type = *spec.cng_payload_type;
-    cng_config.speech_encoder = std::move(encoder);
-    cng_config.vad_mode = Vad::kVadNormal;
-    encoder = CreateComfortNoiseEncoder(std::move(cng_config));
-
     RegisterCngPayloadType(*spec.cng_payload_type,
                            new_config.send_codec_spec->format.clockrate_hz);
   }
 
-  // Wrap the encoder in a RED encoder, if RED is enabled.
-  if (spec.red_payload_type) {
-    AudioEncoderCopyRed::Config red_config;
-    red_config.payload_type = *spec.red_payload_type;
-    red_config.speech_encoder = std::move(encoder);
-    encoder = std::make_unique<AudioEncoderCopyRed>(std::move(red_config),
-                                                    field_trials_);
-  }
-
   // Set currently known overhead (used in ANA, opus only).
   // If overhead changes later, it will be updated in UpdateOverheadForEncoder.
   {
@@ -669,10 +682,44 @@ bool AudioSendStream::SetupSendCodec(const Config& new_config) {
   StoreEncoderProperties(encoder->SampleRateHz(), encoder->NumChannels());
   channel_send_->SetEncoder(new_config.send_codec_spec->payload_type,
                             std::move(encoder));
+  SetupSharedEncoder(new_config);
 
   return true;
 }
 
+void AudioSendStream::SetupSharedEncoder(const Config& new_config) {
+  rtc::scoped_refptr<SharedAudioEncoder> shared_encoder;
+  // Only the application knows which streams send the same audio, so only
+  // streams it put in the same group share an encoder.
+  if (!new_config.shared_encoder_bitrates_bps.empty() &&
+      !new_config.shared_encoder_group.empty()) {
+    RTC_DCHECK(new_config.send_codec_spec);
+    const auto& spec = *new_config.send_codec_spec;
+    rtc::StringBuilder key;
+    key << new_config.shared_encoder_group << " " << spec.ToString();
+    for (int bitrate_bps : new_config.shared_encoder_bitrates_bps) {
+      key << " " << bitrate_bps;
+    }
+    shared_encoder = audio_state()->GetSharedEncoder(key.str(), [&] {
+      RTC_LOG(LS_INFO) << "Creating shared encoder for group "
+                       << new_config.shared_encoder_group;
+      return rtc::make_ref_counted<SharedAudioEncoder>(
+          task_queue_factory_, new_config.shared_encoder_bitrates_bps,
+          [&](int bitrate_bps) -> std::unique_ptr<AudioEncoder> {
+            std::unique_ptr<AudioEncoder> encoder =
+                new_config.encoder_factory->MakeAudioEncoder(
+                    spec.payload_type, spec.format, absl::nullopt);
+            if (!encoder) {
+              return nullptr;
+            }
+            encoder->OnReceivedTargetAudioBitrate(bitrate_bps);
+            return WrapSpeechEncoder(spec, std::move(encoder), field_trials_);
+          });
+    });
+  }
+  channel_send_->SetSharedEncoder(std::move(shared_encoder));
+}
+
 bool AudioSendStream::ReconfigureSendCodec(const Config& new_config) {
   const auto& old_config = config_;
 
@@ -686,6 +733,11 @@ bool AudioSendStream::ReconfigureSendCodec(const Config& new_config) {
   if (new_config.send_codec_spec == old_config.send_codec_spec &&
       new_config.audio_network_adaptor_config ==
           old_config.audio_network_adaptor_config) {
+    if (new_config.shared_encoder_group != old_config.shared_encoder_group ||
+        new_config.shared_encoder_bitrates_bps !=
+            old_config.shared_encoder_bitrates_bps) {
+      SetupSharedEncoder(new_config);
+    }
     return true;
   }
 
@@ -715,6 +767,7 @@ bool AudioSendStream::ReconfigureSendCodec(const Config& new_config) {
 
   ReconfigureANA(new_config);
   ReconfigureCNG(new_config);
+  SetupSharedEncoder(new_config);
 
   return true;
 }
@@ -19,6 +19,7 @@
 #include "api/field_trials_view.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "audio/audio_level.h"
 #include "audio/channel_send.h"
 #include "call/audio_send_stream.h"
@@ -138,6 +139,8 @@ class AudioSendStream final : public webrtc::AudioSendStream,
       RTC_RUN_ON(worker_thread_checker_);
   bool ReconfigureSendCodec(const Config& new_config)
       RTC_RUN_ON(worker_thread_checker_);
+  void SetupSharedEncoder(const Config& new_config)
+      RTC_RUN_ON(worker_thread_checker_);
   void ReconfigureANA(const Config& new_config)
       RTC_RUN_ON(worker_thread_checker_);
   void ReconfigureCNG(const Config& new_config)
@@ -169,6 +172,7 @@ class AudioSendStream final : public webrtc::AudioSendStream,
       RTC_RUN_ON(worker_thread_checker_);
 
   Clock* clock_;
+  TaskQueueFactory* const task_queue_factory_;
   const FieldTrialsView& field_trials_;
 
   SequenceChecker worker_thread_checker_;
@@ -246,6 +246,9 @@ struct ConfigHelper {
           .Times(1);
     }
     EXPECT_CALL(*channel_send_, ResetSenderCongestionControlObjects()).Times(1);
+    // Encoder sharing is not configured.
+    EXPECT_CALL(*channel_send_, SetSharedEncoder(Eq(nullptr)))
+        .Times(::testing::AnyNumber());
   }
 
   void SetupMockForSetupSendCodec(bool expect_set_encoder_call) {
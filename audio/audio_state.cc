@@ -121,6 +121,30 @@ void AudioState::RemoveSendingStream(webrtc::AudioSendStream* stream) {
   }
 }
 
+rtc::scoped_refptr<SharedAudioEncoder> AudioState::GetSharedEncoder(
+    absl::string_view key,
+    rtc::FunctionView<rtc::scoped_refptr<SharedAudioEncoder>()> create) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  // Drop the encoders no stream uses anymore.
+  for (auto it = shared_encoders_.begin(); it != shared_encoders_.end();) {
+    if (it->second->HasOneRef()) {
+      it = shared_encoders_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = shared_encoders_.find(key);
+  if (it != shared_encoders_.end()) {
+    return it->second;
+  }
+  rtc::scoped_refptr<SharedAudioEncoder> shared_encoder = create();
+  if (shared_encoder) {
+    shared_encoders_.emplace(std::string(key), shared_encoder);
+  }
+  return shared_encoder;
+}
+
 void AudioState::SetPlayout(bool enabled) {
   RTC_LOG(LS_INFO) << "SetPlayout(" << enabled << ")";
   RTC_DCHECK_RUN_ON(&thread_checker_);
@@ -11,11 +11,17 @@
 #ifndef AUDIO_AUDIO_STATE_H_
 #define AUDIO_AUDIO_STATE_H_
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <string>
 
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "audio/audio_transport_impl.h"
+#include "audio/shared_audio_encoder.h"
 #include "call/audio_state.h"
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/ref_count.h"
@@ -60,6 +66,13 @@ class AudioState : public webrtc::AudioState {
                         size_t num_channels);
   void RemoveSendingStream(webrtc::AudioSendStream* stream);
 
+  // Returns the shared encoder registered under `key`, calling `create` to
+  // make one if there is none. An encoder is kept for as long as some send
+  // stream holds on to it.
+  rtc::scoped_refptr<SharedAudioEncoder> GetSharedEncoder(
+      absl::string_view key,
+      rtc::FunctionView<rtc::scoped_refptr<SharedAudioEncoder>()> create);
+
  private:
   void UpdateAudioTransportWithSendingStreams();
   void UpdateNullAudioPollerState() RTC_RUN_ON(&thread_checker_);
@@ -85,6 +98,9 @@ class AudioState : public webrtc::AudioState {
     size_t num_channels = 0;
   };
   std::map<webrtc::AudioSendStream*, StreamProperties> sending_streams_;
+
+  std::map<std::string, rtc::scoped_refptr<SharedAudioEncoder>, std::less<>>
+      shared_encoders_ RTC_GUARDED_BY(&thread_checker_);
 };
 }  // namespace internal
 }  // namespace webrtc
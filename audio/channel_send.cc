@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/crypto/frame_encryptor_interface.h"
@@ -31,6 +32,7 @@
 #include "modules/audio_processing/rms_level.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
@@ -59,6 +61,7 @@ class VoERtcpObserver;
 class ChannelSend : public ChannelSendInterface,
                     public AudioPacketizationCallback,  // receive encoded
                                                         // packets from the ACM
+                    public SharedAudioEncoder::Sink,
                     public RtcpPacketTypeCounterObserver {
  public:
   ChannelSend(Clock* clock,
@@ -145,6 +148,13 @@ class ChannelSend : public ChannelSendInterface,
       rtc::scoped_refptr<webrtc::FrameTransformerInterface> frame_transformer)
       override;
 
+  void SetSharedEncoder(
+      rtc::scoped_refptr<SharedAudioEncoder> shared_encoder) override;
+
+  // SharedAudioEncoder::Sink.
+  void OnEncodedAudio(
+      const SharedAudioEncoder::EncodedAudio& encoded_audio) override;
+
   // RtcpPacketTypeCounterObserver.
   void RtcpPacketTypesCounterUpdated(
       uint32_t ssrc,
@@ -204,6 +214,9 @@ class ChannelSend : public ChannelSendInterface,
       RTC_GUARDED_BY(audio_thread_race_checker_);
 
   RmsLevel rms_level_ RTC_GUARDED_BY(encoder_queue_);
+  // Level of the audio encoded by `shared_encoder_`, used instead of
+  // `rms_level_` while it is set.
+  absl::optional<int> shared_audio_level_ RTC_GUARDED_BY(encoder_queue_);
   bool input_mute_ RTC_GUARDED_BY(volume_settings_mutex_) = false;
   bool previous_frame_muted_ RTC_GUARDED_BY(encoder_queue_) = false;
 
@@ -222,9 +235,18 @@ class ChannelSend : public ChannelSendInterface,
   std::atomic<bool> encoder_queue_is_active_ = false;
   std::atomic<bool> first_frame_ = true;
 
+  // Held while feeding `shared_encoder_` so that it can't be replaced while
+  // in use from the audio thread.
+  Mutex shared_encoder_mutex_;
+  rtc::scoped_refptr<SharedAudioEncoder> shared_encoder_
+      RTC_GUARDED_BY(shared_encoder_mutex_);
+
   // E2EE Audio Frame Encryption
   rtc::scoped_refptr<FrameEncryptorInterface> frame_encryptor_
       RTC_GUARDED_BY(encoder_queue_);
+  // Holds the encrypted payload of the frame being sent. Kept across frames
+  // to reuse its allocation.
+  rtc::Buffer encrypted_audio_payload_ RTC_GUARDED_BY(encoder_queue_);
   // E2EE Frame Encryption Options
   const webrtc::CryptoOptions crypto_options_;
 
@@ -376,12 +398,11 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
     // Store current audio level in the RTP sender.
     // The level will be used in combination with voice-activity state
     // (frameType) to add an RTP header extension
-    rtp_sender_audio_->SetAudioLevel(rms_level_.Average());
+    rtp_sender_audio_->SetAudioLevel(
+        shared_audio_level_ ? *shared_audio_level_ : rms_level_.Average());
   }
 
   // E2EE Custom Audio Frame Encryption (This is optional).
-  // Keep this buffer around for the lifetime of the send call.
-  rtc::Buffer encrypted_audio_payload;
   // We don't invoke encryptor if payload is empty, which means we are to send
   // DTMF, or the encoder entered DTX.
   // TODO(minyue): see whether DTMF packets should be encrypted or not. In
@@ -392,13 +413,13 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
       // Allocate a buffer to hold the maximum possible encrypted payload.
       size_t max_ciphertext_size = frame_encryptor_->GetMaxCiphertextByteSize(
           cricket::MEDIA_TYPE_AUDIO, payload.size());
-      encrypted_audio_payload.SetSize(max_ciphertext_size);
+      encrypted_audio_payload_.SetSize(max_ciphertext_size);
 
       // Encrypt the audio payload into the buffer.
       size_t bytes_written = 0;
       int encrypt_status = frame_encryptor_->Encrypt(
           cricket::MEDIA_TYPE_AUDIO, rtp_rtcp_->SSRC(),
-          /*additional_data=*/nullptr, payload, encrypted_audio_payload,
+          /*additional_data=*/nullptr, payload, encrypted_audio_payload_,
           &bytes_written);
       if (encrypt_status != 0) {
         RTC_DLOG(LS_ERROR)
@@ -407,9 +428,9 @@ int32_t ChannelSend::SendRtpAudio(AudioFrameType frameType,
         return -1;
       }
       // Resize the buffer to the exact number of bytes actually used.
-      encrypted_audio_payload.SetSize(bytes_written);
+      encrypted_audio_payload_.SetSize(bytes_written);
       // Rewrite the payloadData and size to the new encrypted payload.
-      payload = encrypted_audio_payload;
+      payload = encrypted_audio_payload_;
     } else if (crypto_options_.sframe.require_frame_encryption) {
       RTC_DLOG(LS_ERROR) << "Channel::SendData() failed sending audio payload: "
                             "A frame encryptor is required but one is not set.";
@@ -534,6 +555,11 @@ void ChannelSend::StartSend() {
   // It is now OK to start processing on the encoder task queue.
   first_frame_.store(true);
   encoder_queue_is_active_.store(true);
+
+  MutexLock lock(&shared_encoder_mutex_);
+  if (shared_encoder_) {
+    shared_encoder_->AddSink(this, GetTargetBitrate());
+  }
 }
 
 void ChannelSend::StopSend() {
@@ -543,6 +569,16 @@ void ChannelSend::StopSend() {
   }
   sending_ = false;
   encoder_queue_is_active_.store(false);
+  rtc::scoped_refptr<SharedAudioEncoder> shared_encoder;
+  {
+    MutexLock lock(&shared_encoder_mutex_);
+    shared_encoder = shared_encoder_;
+  }
+  // RemoveSink() waits for the shared encoder's queue, which must not stall
+  // the audio thread on `shared_encoder_mutex_`.
+  if (shared_encoder) {
+    shared_encoder->RemoveSink(this);
+  }
 
   // Wait until all pending encode tasks are executed and clear any remaining
   // buffers in the encoder.
@@ -612,6 +648,13 @@ void ChannelSend::OnBitrateAllocation(BitrateAllocationUpdate update) {
     encoder->OnReceivedUplinkAllocation(update);
   });
   retransmission_rate_limiter_->SetMaxRate(update.target_bitrate.bps());
+
+  // Let the own encoder work out the codec bitrate, and pick the closest one
+  // of the shared encoder.
+  MutexLock lock(&shared_encoder_mutex_);
+  if (shared_encoder_) {
+    shared_encoder_->SetSinkBitrate(this, GetTargetBitrate());
+  }
 }
 
 int ChannelSend::GetTargetBitrate() const {
@@ -834,6 +877,19 @@ void ChannelSend::ProcessAndEncodeAudio(
   timestamp_ += audio_frame->samples_per_channel_;
   last_capture_timestamp_ms_ = audio_frame->absolute_capture_timestamp_ms();
 
+  {
+    MutexLock lock(&shared_encoder_mutex_);
+    if (shared_encoder_) {
+      // Muting only applies to this stream. While it is muted, the shared
+      // encoder doesn't send to it, and the muted audio is encoded below.
+      bool muted = InputMute();
+      shared_encoder_->OnAudioFrame(this, *audio_frame, muted);
+      if (!muted) {
+        return;
+      }
+    }
+  }
+
   // Profile time between when the audio frame is added to the task queue and
   // when the task is actually executed.
   audio_frame->UpdateProfileTimeStamp();
@@ -865,6 +921,7 @@ void ChannelSend::ProcessAndEncodeAudio(
           }
         }
         previous_frame_muted_ = is_muted;
+        shared_audio_level_ = absl::nullopt;
 
         // This call will trigger AudioPacketizationCallback::SendData if
         // encoding is done and payload is ready for packetization and
@@ -926,6 +983,50 @@ void ChannelSend::OnReceivedRtt(int64_t rtt_ms) {
       [rtt_ms](AudioEncoder* encoder) { encoder->OnReceivedRtt(rtt_ms); });
 }
 
+void ChannelSend::SetSharedEncoder(
+    rtc::scoped_refptr<SharedAudioEncoder> shared_encoder) {
+  RTC_DCHECK_RUN_ON(&worker_thread_checker_);
+  rtc::scoped_refptr<SharedAudioEncoder> old_shared_encoder;
+  {
+    MutexLock lock(&shared_encoder_mutex_);
+    if (shared_encoder == shared_encoder_) {
+      return;
+    }
+    // Added before it is fed, so that no frame is dropped in between.
+    if (sending_ && shared_encoder) {
+      shared_encoder->AddSink(this, GetTargetBitrate());
+    }
+    old_shared_encoder = std::exchange(shared_encoder_, shared_encoder);
+  }
+  if (!sending_) {
+    return;
+  }
+  // Outside the lock, as RemoveSink() waits for the shared encoder's queue.
+  if (old_shared_encoder) {
+    old_shared_encoder->RemoveSink(this);
+  }
+  // Audio buffered in the encoder that is switched away from is not sent.
+  CallEncoder([](AudioEncoder* encoder) { encoder->Reset(); });
+}
+
+void ChannelSend::OnEncodedAudio(
+    const SharedAudioEncoder::EncodedAudio& encoded_audio) {
+  if (!encoder_queue_is_active_.load()) {
+    return;
+  }
+  encoder_queue_.PostTask([this, encoded_audio]() {
+    RTC_DCHECK_RUN_ON(&encoder_queue_);
+    if (!encoder_queue_is_active_.load()) {
+      return;
+    }
+    shared_audio_level_ = encoded_audio.audio_level_dbov;
+    SendData(encoded_audio.frame_type, encoded_audio.payload_type,
+             encoded_audio.rtp_timestamp, encoded_audio.payload.cdata(),
+             encoded_audio.payload.size(),
+             encoded_audio.absolute_capture_timestamp_ms);
+  });
+}
+
 void ChannelSend::InitFrameTransformerDelegate(
     rtc::scoped_refptr<webrtc::FrameTransformerInterface> frame_transformer) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
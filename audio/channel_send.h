@@ -22,6 +22,7 @@
 #include "api/frame_transformer_interface.h"
 #include "api/function_view.h"
 #include "api/task_queue/task_queue_factory.h"
+#include "audio/shared_audio_encoder.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sender_audio.h"
@@ -124,6 +125,12 @@ class ChannelSendInterface {
   virtual void SetEncoderToPacketizerFrameTransformer(
       rtc::scoped_refptr<webrtc::FrameTransformerInterface>
           frame_transformer) = 0;
+
+  // Sends the output of `shared_encoder` instead of encoding the audio with
+  // the encoder set by SetEncoder(), which must still be set up with the same
+  // payload types. Use nullptr to go back to the own encoder.
+  virtual void SetSharedEncoder(
+      rtc::scoped_refptr<SharedAudioEncoder> shared_encoder) = 0;
 };
 
 std::unique_ptr<ChannelSendInterface> CreateChannelSend(
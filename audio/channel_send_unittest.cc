@@ -10,15 +10,22 @@
 
 #include "audio/channel_send.h"
 
+#include <atomic>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_encoder.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/make_ref_counted.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/scoped_refptr.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "audio/shared_audio_encoder.h"
 #include "call/rtp_transport_controller_send.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/mock_transport.h"
 #include "test/scoped_key_value_config.h"
@@ -28,6 +35,7 @@ namespace webrtc {
 namespace voe {
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
@@ -38,6 +46,42 @@ constexpr int kPayloadType = 1;
 constexpr int kSampleRateHz = 48000;
 constexpr int kRtpRateHz = 48000;
 
+constexpr uint8_t kSharedPayload = 0xab;
+
+// Encodes every 10 ms frame into a packet holding only `kSharedPayload`.
+class SharedFakeEncoder : public AudioEncoder {
+ public:
+  explicit SharedFakeEncoder(std::atomic<int>* encode_count)
+      : encode_count_(encode_count) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override { return 1; }
+  size_t Max10MsFramesInAPacket() const override { return 1; }
+  int GetTargetBitrate() const override { return 32000; }
+  void Reset() override {}
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return absl::nullopt;
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    ++*encode_count_;
+    encoded->AppendData(kSharedPayload);
+    EncodedInfo info;
+    info.encoded_bytes = 1;
+    info.encoded_timestamp = rtp_timestamp;
+    info.payload_type = kPayloadType;
+    return info;
+  }
+
+ private:
+  std::atomic<int>* const encode_count_;
+};
+
 BitrateConstraints GetBitrateConfig() {
   BitrateConstraints bitrate_config;
   bitrate_config.min_bitrate_bps = 10000;
@@ -146,6 +190,88 @@ TEST_F(ChannelSendTest, IncreaseRtpTimestampByPauseDuration) {
   EXPECT_EQ(timestamp_gap_ms, 10020);
 }
 
+TEST_F(ChannelSendTest, StreamsShareEncoderAndMuteIndependently) {
+  NiceMock<MockTransport> other_transport;
+  ON_CALL(other_transport, SendRtcp).WillByDefault(Return(true));
+  std::unique_ptr<ChannelSendInterface> other_channel = voe::CreateChannelSend(
+      time_controller_.GetClock(), time_controller_.GetTaskQueueFactory(),
+      &other_transport, nullptr, &event_log_, nullptr, crypto_options_, false,
+      kRtcpIntervalMs, kSsrc + 1, nullptr, nullptr, field_trials_);
+  other_channel->SetEncoder(
+      kPayloadType, encoder_factory_->MakeAudioEncoder(
+                        kPayloadType, SdpAudioFormat("opus", kRtpRateHz, 2),
+                        {}));
+  other_channel->RegisterSenderCongestionControlObjects(&transport_controller_,
+                                                        nullptr);
+
+  std::atomic<int> encode_count{0};
+  auto shared_encoder = rtc::make_ref_counted<SharedAudioEncoder>(
+      time_controller_.GetTaskQueueFactory(), std::vector<int>{32000},
+      [&](int bitrate_bps) {
+        return std::make_unique<SharedFakeEncoder>(&encode_count);
+      });
+  channel_->SetSharedEncoder(shared_encoder);
+  other_channel->SetSharedEncoder(shared_encoder);
+
+  std::vector<std::vector<uint8_t>> payloads;
+  std::vector<std::vector<uint8_t>> other_payloads;
+  auto record_payloads = [](std::vector<std::vector<uint8_t>>* payloads) {
+    return [payloads](const uint8_t* data, size_t length,
+                      const PacketOptions& options) {
+      RtpPacketReceived packet;
+      EXPECT_TRUE(packet.Parse(data, length));
+      payloads->emplace_back(packet.payload().begin(), packet.payload().end());
+      return true;
+    };
+  };
+  EXPECT_CALL(transport_, SendRtp)
+      .WillRepeatedly(Invoke(record_payloads(&payloads)));
+  EXPECT_CALL(other_transport, SendRtp)
+      .WillRepeatedly(Invoke(record_payloads(&other_payloads)));
+  auto process_frames = [&](int num_frames) {
+    for (int i = 0; i < num_frames; ++i) {
+      channel_->ProcessAndEncodeAudio(CreateAudioFrame());
+      other_channel->ProcessAndEncodeAudio(CreateAudioFrame());
+      time_controller_.AdvanceTime(TimeDelta::Millis(10));
+    }
+    // Let the pacer send the last packets.
+    time_controller_.AdvanceTime(TimeDelta::Millis(50));
+  };
+
+  channel_->StartSend();
+  other_channel->StartSend();
+  process_frames(4);
+  // Each frame is encoded once for both streams.
+  EXPECT_EQ(encode_count, 4);
+  ASSERT_EQ(payloads.size(), 4u);
+  ASSERT_EQ(other_payloads.size(), 4u);
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    EXPECT_THAT(payloads[i], ElementsAre(kSharedPayload));
+    EXPECT_THAT(other_payloads[i], ElementsAre(kSharedPayload));
+  }
+
+  // Muting the other stream leaves this one unmuted, and the other stream
+  // encodes its muted audio with its own encoder.
+  other_channel->SetInputMute(true);
+  payloads.clear();
+  other_payloads.clear();
+  process_frames(4);
+  EXPECT_EQ(encode_count, 8);
+  ASSERT_EQ(payloads.size(), 4u);
+  for (const auto& payload : payloads) {
+    EXPECT_THAT(payload, ElementsAre(kSharedPayload));
+  }
+  ASSERT_FALSE(other_payloads.empty());
+  for (const auto& payload : other_payloads) {
+    EXPECT_NE(payload, std::vector<uint8_t>{kSharedPayload});
+  }
+
+  other_channel->StopSend();
+  channel_->StopSend();
+  other_channel->SetSharedEncoder(nullptr);
+  channel_->SetSharedEncoder(nullptr);
+}
+
 }  // namespace
 }  // namespace voe
 }  // namespace webrtc
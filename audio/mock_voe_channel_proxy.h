@@ -179,6 +179,10 @@ class MockChannelSend : public voe::ChannelSendInterface {
       SetEncoderToPacketizerFrameTransformer,
       (rtc::scoped_refptr<webrtc::FrameTransformerInterface> frame_transformer),
       (override));
+  MOCK_METHOD(void,
+              SetSharedEncoder,
+              (rtc::scoped_refptr<SharedAudioEncoder> shared_encoder),
+              (override));
 };
 }  // namespace test
 }  // namespace webrtc
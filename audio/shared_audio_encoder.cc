@@ -0,0 +1,337 @@
+/*
+ *  Copyright (c) 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/sequence_checker.h"
+#include "modules/audio_coding/include/audio_coding_module.h"
+#include "modules/audio_processing/rms_level.h"
+#include "modules/include/module_common_types_public.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+
+// One of the bitrates the track is encoded at. Only used on the encoder queue.
+class SharedAudioEncoder::Tier : public AudioPacketizationCallback {
+ public:
+  Tier(SharedAudioEncoder* owner,
+       size_t index,
+       int bitrate_bps,
+       std::unique_ptr<AudioEncoder> encoder)
+      : owner_(owner),
+        index_(index),
+        bitrate_bps_(bitrate_bps),
+        audio_coding_(AudioCodingModule::Create()) {
+    audio_coding_->SetEncoder(std::move(encoder));
+    int error = audio_coding_->RegisterTransportCallback(this);
+    RTC_DCHECK_EQ(0, error);
+  }
+
+  ~Tier() override { audio_coding_->RegisterTransportCallback(nullptr); }
+
+  int bitrate_bps() const { return bitrate_bps_; }
+
+  // Index of the next frame the tier expects.
+  int64_t next_frame_index() const { return next_frame_index_; }
+
+  // Drops the audio buffered for an unfinished packet.
+  void Reset() {
+    audio_coding_->ModifyEncoder([](std::unique_ptr<AudioEncoder>* encoder) {
+      if (*encoder)
+        (*encoder)->Reset();
+    });
+  }
+
+  void Encode(const AudioFrame& audio_frame, int64_t frame_index) {
+    next_frame_index_ = frame_index + 1;
+    if (!first_input_timestamp_) {
+      first_input_timestamp_ = audio_frame.timestamp_;
+      input_sample_rate_hz_ = audio_frame.sample_rate_hz_;
+    }
+
+    size_t length =
+        audio_frame.samples_per_channel_ * audio_frame.num_channels_;
+    RTC_CHECK_LE(length, AudioFrame::kMaxDataSizeBytes);
+    rms_level_.Analyze(
+        rtc::ArrayView<const int16_t>(audio_frame.data(), length));
+
+    // This call will trigger SendData() if encoding is done and a payload is
+    // ready for packetization.
+    if (audio_coding_->Add10MsData(audio_frame) < 0) {
+      RTC_DLOG(LS_ERROR) << "ACM::Add10MsData() failed.";
+    }
+  }
+
+  // AudioPacketizationCallback implementation.
+  int32_t SendData(AudioFrameType frame_type,
+                   uint8_t payload_type,
+                   uint32_t timestamp,
+                   const uint8_t* payload_data,
+                   size_t payload_len_bytes,
+                   int64_t absolute_capture_timestamp_ms) override {
+    RTC_DCHECK(first_input_timestamp_);
+    EncodedAudio encoded_audio;
+    encoded_audio.frame_type = frame_type;
+    encoded_audio.payload_type = payload_type;
+    // The audio coding module starts counting at the first input timestamp,
+    // translate to the timestamps of the tiers that started earlier.
+    encoded_audio.rtp_timestamp =
+        owner_->ToRtpTimestamp(*first_input_timestamp_, input_sample_rate_hz_) +
+        (timestamp - *first_input_timestamp_);
+    encoded_audio.payload.SetData(payload_data, payload_len_bytes);
+    encoded_audio.absolute_capture_timestamp_ms = absolute_capture_timestamp_ms;
+    encoded_audio.audio_level_dbov = rms_level_.Average();
+    owner_->DeliverEncodedAudio(index_, encoded_audio);
+    return 0;
+  }
+
+ private:
+  SharedAudioEncoder* const owner_;
+  const size_t index_;
+  const int bitrate_bps_;
+  const std::unique_ptr<AudioCodingModule> audio_coding_;
+  RmsLevel rms_level_;
+  int64_t next_frame_index_ = 0;
+  absl::optional<uint32_t> first_input_timestamp_;
+  int input_sample_rate_hz_ = 0;
+};
+
+SharedAudioEncoder::SharedAudioEncoder(
+    TaskQueueFactory* task_queue_factory,
+    std::vector<int> bitrates_bps,
+    rtc::FunctionView<std::unique_ptr<AudioEncoder>(int bitrate_bps)>
+        create_encoder)
+    : encoder_queue_(task_queue_factory->CreateTaskQueue(
+          "SharedAudioEncoder",
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_DCHECK(!bitrates_bps.empty());
+  std::sort(bitrates_bps.begin(), bitrates_bps.end());
+  bitrates_bps.erase(std::unique(bitrates_bps.begin(), bitrates_bps.end()),
+                     bitrates_bps.end());
+  for (int bitrate_bps : bitrates_bps) {
+    std::unique_ptr<AudioEncoder> encoder = create_encoder(bitrate_bps);
+    RTC_CHECK(encoder);
+    RTC_DCHECK(rtp_timestamp_rate_hz_ == 0 ||
+               rtp_timestamp_rate_hz_ == encoder->RtpTimestampRateHz());
+    rtp_timestamp_rate_hz_ = encoder->RtpTimestampRateHz();
+    RTC_DCHECK(tiers_.empty() ||
+               frames_per_packet_ == encoder->Num10MsFramesInNextPacket());
+    frames_per_packet_ = std::max<size_t>(encoder->Num10MsFramesInNextPacket(),
+                                          1);
+    tiers_.push_back(std::make_unique<Tier>(this, tiers_.size(), bitrate_bps,
+                                            std::move(encoder)));
+  }
+}
+
+SharedAudioEncoder::~SharedAudioEncoder() {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(sinks_.empty());
+}
+
+void SharedAudioEncoder::AddSink(Sink* sink, int target_bitrate_bps) {
+  RTC_DCHECK(sink);
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(FindSink(sink) == sinks_.end());
+  SinkState state;
+  state.tier = TierForBitrate(target_bitrate_bps);
+  state.encoding_tier = state.tier;
+  sinks_.emplace_back(sink, state);
+}
+
+void SharedAudioEncoder::RemoveSink(Sink* sink) {
+  RTC_DCHECK(!encoder_queue_.IsCurrent());
+  {
+    MutexLock lock(&mutex_);
+    auto it = FindSink(sink);
+    if (it == sinks_.end()) {
+      return;
+    }
+    sinks_.erase(it);
+  }
+  // The sinks are called without holding `mutex_`, so `sink` may still be in
+  // the middle of a delivery. Deliveries only happen on the encoder queue,
+  // once the queue gets to this task there are no more.
+  rtc::Event done;
+  encoder_queue_.PostTask([&done] { done.Set(); });
+  done.Wait(rtc::Event::kForever);
+}
+
+void SharedAudioEncoder::SetSinkBitrate(Sink* sink, int target_bitrate_bps) {
+  MutexLock lock(&mutex_);
+  auto it = FindSink(sink);
+  if (it == sinks_.end()) {
+    return;
+  }
+  it->second.tier = TierForBitrate(target_bitrate_bps);
+}
+
+int SharedAudioEncoder::GetSinkBitrate(const Sink* sink) const {
+  MutexLock lock(&mutex_);
+  auto it = FindSink(sink);
+  return it != sinks_.end() ? tiers_[it->second.tier]->bitrate_bps() : 0;
+}
+
+void SharedAudioEncoder::OnAudioFrame(const Sink* sink,
+                                      const AudioFrame& audio_frame,
+                                      bool muted) {
+  MutexLock lock(&mutex_);
+  auto it = FindSink(sink);
+  if (it == sinks_.end()) {
+    return;
+  }
+  SinkState& state = it->second;
+  state.muted = muted;
+  if (!state.has_timestamp_offset) {
+    // The sinks feed the same audio at the same pace, so a constant offset
+    // maps our timestamps to the sink's. Since it is taken when the sink
+    // feeds its first frame, it may be off by a frame, which is harmless as
+    // long as the sink doesn't get packets from before it joined.
+    state.has_timestamp_offset = true;
+    state.input_timestamp_offset = audio_frame.timestamp_ - input_timestamp_;
+    state.input_sample_rate_hz = audio_frame.sample_rate_hz_;
+    state.first_rtp_timestamp =
+        ToRtpTimestamp(audio_frame.timestamp_, audio_frame.sample_rate_hz_);
+  }
+  if (it != sinks_.begin()) {
+    return;
+  }
+
+  // The audio is encoded unmuted even if the first sink is muted, the sinks
+  // that are not muted still send it.
+  auto frame = std::make_unique<AudioFrame>();
+  frame->CopyFrom(audio_frame);
+  frame->timestamp_ = input_timestamp_;
+  input_timestamp_ += frame->samples_per_channel_;
+  encoder_queue_.PostTask([this, frame = std::move(frame)]() mutable {
+    Encode(std::move(frame));
+  });
+}
+
+SharedAudioEncoder::SinkList::const_iterator SharedAudioEncoder::FindSink(
+    const Sink* sink) const {
+  return std::find_if(
+      sinks_.begin(), sinks_.end(),
+      [sink](const auto& entry) { return entry.first == sink; });
+}
+
+SharedAudioEncoder::SinkList::iterator SharedAudioEncoder::FindSink(
+    const Sink* sink) {
+  return std::find_if(
+      sinks_.begin(), sinks_.end(),
+      [sink](const auto& entry) { return entry.first == sink; });
+}
+
+size_t SharedAudioEncoder::TierForBitrate(int bitrate_bps) const {
+  size_t tier = 0;
+  while (tier + 1 < tiers_.size() &&
+         tiers_[tier + 1]->bitrate_bps() <= bitrate_bps) {
+    ++tier;
+  }
+  return tier;
+}
+
+uint32_t SharedAudioEncoder::ToRtpTimestamp(uint32_t input_timestamp,
+                                            int input_sample_rate_hz) const {
+  if (input_sample_rate_hz == rtp_timestamp_rate_hz_ ||
+      input_sample_rate_hz <= 0) {
+    return input_timestamp;
+  }
+  return static_cast<uint32_t>(uint64_t{input_timestamp} *
+                               rtp_timestamp_rate_hz_ / input_sample_rate_hz);
+}
+
+uint32_t SharedAudioEncoder::ToSinkTimestamp(const SinkState& state,
+                                             uint32_t rtp_timestamp) const {
+  int64_t offset = static_cast<int32_t>(state.input_timestamp_offset);
+  if (state.input_sample_rate_hz > 0) {
+    offset = offset * rtp_timestamp_rate_hz_ / state.input_sample_rate_hz;
+  }
+  return rtp_timestamp + static_cast<uint32_t>(offset);
+}
+
+void SharedAudioEncoder::Encode(std::unique_ptr<AudioFrame> audio_frame) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  TRACE_EVENT0("webrtc", "SharedAudioEncoder::Encode");
+  active_tiers_.assign(tiers_.size(), false);
+  {
+    MutexLock lock(&mutex_);
+    for (auto& [sink, state] : sinks_) {
+      state.encoding_tier = state.tier;
+      if (!state.muted) {
+        active_tiers_[state.tier] = true;
+      }
+    }
+  }
+
+  const int64_t packet_start_index =
+      frame_index_ - static_cast<int64_t>(packet_frames_.size());
+  for (size_t i = 0; i < tiers_.size(); ++i) {
+    // Nobody listens to this bitrate, don't spend time encoding it.
+    if (!active_tiers_[i]) {
+      continue;
+    }
+    Tier& tier = *tiers_[i];
+    if (tier.next_frame_index() < packet_start_index) {
+      // Audio buffered before the tier went idle would shift its packets
+      // against those of the other tiers.
+      tier.Reset();
+    }
+    // Catch up with the frames of this packet that the tier missed while it
+    // was idle, so that sinks switching to it don't lose them.
+    for (int64_t index = std::max(tier.next_frame_index(), packet_start_index);
+         index < frame_index_; ++index) {
+      tier.Encode(*packet_frames_[index - packet_start_index], index);
+    }
+    tier.Encode(*audio_frame, frame_index_);
+  }
+
+  ++frame_index_;
+  packet_frames_.push_back(std::move(audio_frame));
+  if (packet_frames_.size() == frames_per_packet_) {
+    packet_frames_.clear();
+  }
+}
+
+void SharedAudioEncoder::DeliverEncodedAudio(size_t tier,
+                                             EncodedAudio& encoded_audio) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  const uint32_t rtp_timestamp = encoded_audio.rtp_timestamp;
+  deliveries_.clear();
+  {
+    MutexLock lock(&mutex_);
+    for (const auto& [sink, state] : sinks_) {
+      if (state.encoding_tier != tier || state.muted ||
+          !state.has_timestamp_offset) {
+        continue;
+      }
+      uint32_t sink_rtp_timestamp = ToSinkTimestamp(state, rtp_timestamp);
+      if (IsNewerTimestamp(state.first_rtp_timestamp, sink_rtp_timestamp)) {
+        continue;
+      }
+      deliveries_.emplace_back(sink, sink_rtp_timestamp);
+    }
+  }
+  // Calling the sinks without the lock keeps them from holding up the audio
+  // thread. RemoveSink() waits for this to finish instead.
+  for (const auto& [sink, sink_rtp_timestamp] : deliveries_) {
+    encoded_audio.rtp_timestamp = sink_rtp_timestamp;
+    sink->OnEncodedAudio(encoded_audio);
+  }
+}
+
+}  // namespace webrtc
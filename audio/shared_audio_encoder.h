@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef AUDIO_SHARED_AUDIO_ENCODER_H_
+#define AUDIO_SHARED_AUDIO_ENCODER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/function_view.h"
+#include "api/ref_counted_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/audio_coding/include/audio_coding_module_typedefs.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encodes the audio of one track for any number of send streams with
+// identical codec configuration, so that sending a track to many peers costs
+// one encode per packet instead of one per peer. The track is encoded once
+// for each of a small set of bitrates, and each stream is switched between
+// them according to its own target bitrate.
+//
+// All streams feed the same audio, but only the frames of the first stream
+// added are encoded; the others only provide the mapping between the RTP
+// timestamps of the shared encoder and their own. Muting applies to each
+// stream on its own: muted streams get no encoded audio, and are expected to
+// encode their muted audio themselves.
+//
+// All bitrates put the same frames in each packet. A bitrate that starts being
+// used in the middle of a packet first encodes the frames of that packet it
+// missed, so a stream that switches bitrates gets neither a gap nor repeated
+// audio.
+class SharedAudioEncoder
+    : public rtc::RefCountedNonVirtual<SharedAudioEncoder> {
+ public:
+  struct EncodedAudio {
+    AudioFrameType frame_type = AudioFrameType::kEmptyFrame;
+    uint8_t payload_type = 0;
+    // In the timestamp domain of the receiving sink.
+    uint32_t rtp_timestamp = 0;
+    rtc::CopyOnWriteBuffer payload;
+    int64_t absolute_capture_timestamp_ms = 0;
+    // Level of the encoded audio, for the audio level header extension.
+    int audio_level_dbov = 0;
+  };
+
+  class Sink {
+   public:
+    // Called on the task queue of the shared encoder, without holding any
+    // lock. Implementations should not block; the payload buffer may be kept
+    // without copying it.
+    virtual void OnEncodedAudio(const EncodedAudio& encoded_audio) = 0;
+
+   protected:
+    virtual ~Sink() = default;
+  };
+
+  // Creates one encoder per distinct entry in `bitrates_bps` by calling
+  // `create_encoder`, which must return encoders with the same payload types,
+  // RTP timestamp rate and packet duration.
+  SharedAudioEncoder(
+      TaskQueueFactory* task_queue_factory,
+      std::vector<int> bitrates_bps,
+      rtc::FunctionView<std::unique_ptr<AudioEncoder>(int bitrate_bps)>
+          create_encoder);
+  ~SharedAudioEncoder();
+
+  SharedAudioEncoder(const SharedAudioEncoder&) = delete;
+  SharedAudioEncoder& operator=(const SharedAudioEncoder&) = delete;
+
+  // Lets a pool of shared encoders tell which ones are no longer used.
+  using rtc::RefCountedNonVirtual<SharedAudioEncoder>::HasOneRef;
+
+  // Adds or removes a sink. Once RemoveSink() returns, `sink` gets no more
+  // callbacks, so RemoveSink() waits for a delivery that is in progress. It
+  // must not be called from a callback.
+  void AddSink(Sink* sink, int target_bitrate_bps);
+  void RemoveSink(Sink* sink);
+
+  // Switches `sink` to the highest bitrate not above `target_bitrate_bps`, or
+  // the lowest bitrate if all are above it.
+  void SetSinkBitrate(Sink* sink, int target_bitrate_bps);
+  // Returns the bitrate `sink` currently receives, or 0 if it isn't added.
+  int GetSinkBitrate(const Sink* sink) const;
+
+  // Called by each sink with every captured frame, timestamped in the sink's
+  // own timestamp domain, and the mute state of the sink. Only the frames of
+  // the first sink are copied for encoding.
+  void OnAudioFrame(const Sink* sink,
+                    const AudioFrame& audio_frame,
+                    bool muted);
+
+ private:
+  class Tier;
+  struct SinkState {
+    size_t tier = 0;
+    // The tier the sink gets packets from, taken from `tier` when a frame is
+    // encoded, so that a packet is not lost to a switch while it is encoded.
+    size_t encoding_tier = 0;
+    // The mute state given with the last frame from the sink.
+    bool muted = false;
+    // Set by the first frame from the sink: the difference between the
+    // sink's input timestamps and ours, and the first RTP timestamp it can
+    // be sent without going back in time.
+    bool has_timestamp_offset = false;
+    uint32_t input_timestamp_offset = 0;
+    int input_sample_rate_hz = 0;
+    uint32_t first_rtp_timestamp = 0;
+  };
+
+  using SinkList = std::vector<std::pair<Sink*, SinkState>>;
+
+  SinkList::const_iterator FindSink(const Sink* sink) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  SinkList::iterator FindSink(const Sink* sink)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  size_t TierForBitrate(int bitrate_bps) const;
+  uint32_t ToRtpTimestamp(uint32_t input_timestamp,
+                          int input_sample_rate_hz) const;
+  uint32_t ToSinkTimestamp(const SinkState& state,
+                           uint32_t rtp_timestamp) const;
+  void Encode(std::unique_ptr<AudioFrame> audio_frame);
+  void DeliverEncodedAudio(size_t tier, EncodedAudio& encoded_audio);
+
+  // Ordered by increasing bitrate.
+  std::vector<std::unique_ptr<Tier>> tiers_;
+  int rtp_timestamp_rate_hz_ = 0;
+  size_t frames_per_packet_ = 1;
+
+  mutable Mutex mutex_;
+  // Ordered by insertion, the first sink is the one whose frames are encoded.
+  SinkList sinks_ RTC_GUARDED_BY(mutex_);
+  // Input timestamp of the next encoded frame.
+  uint32_t input_timestamp_ RTC_GUARDED_BY(mutex_) = 0;
+
+  // Scratch space, kept to avoid allocating for every packet. Whether any
+  // unmuted sink receives each tier, and the sinks a packet is delivered to,
+  // with their RTP timestamps.
+  std::vector<bool> active_tiers_ RTC_GUARDED_BY(encoder_queue_);
+  std::vector<std::pair<Sink*, uint32_t>> deliveries_
+      RTC_GUARDED_BY(encoder_queue_);
+  // The frames of the packet being encoded, for the tiers that start being
+  // used before it is complete, and the index of the next frame.
+  std::vector<std::unique_ptr<AudioFrame>> packet_frames_
+      RTC_GUARDED_BY(encoder_queue_);
+  int64_t frame_index_ RTC_GUARDED_BY(encoder_queue_) = 0;
+
+  // Defined last to ensure that there are no running tasks when the other
+  // members are destroyed.
+  rtc::TaskQueue encoder_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // AUDIO_SHARED_AUDIO_ENCODER_H_
@@ -0,0 +1,378 @@
+/*
+ *  Copyright (c) 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/shared_audio_encoder.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kSamplesPerFrame = kSampleRateHz / 100;
+constexpr uint8_t kPayloadType = 111;
+constexpr int kLowBitrateBps = 16000;
+constexpr int kHighBitrateBps = 32000;
+
+// Sends one packet per `frames_per_packet` 10 ms frames, holding a single
+// byte: the bitrate in kbps.
+class FakeEncoder : public AudioEncoder {
+ public:
+  FakeEncoder(int bitrate_bps,
+              std::atomic<int>* encode_count,
+              size_t frames_per_packet = 1)
+      : bitrate_bps_(bitrate_bps),
+        encode_count_(encode_count),
+        frames_per_packet_(frames_per_packet) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override {
+    return frames_per_packet_;
+  }
+  size_t Max10MsFramesInAPacket() const override { return frames_per_packet_; }
+  int GetTargetBitrate() const override { return bitrate_bps_; }
+  void Reset() override { buffered_frames_ = 0; }
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return absl::nullopt;
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    ++*encode_count_;
+    if (buffered_frames_++ == 0) {
+      packet_timestamp_ = rtp_timestamp;
+    }
+    if (buffered_frames_ < frames_per_packet_) {
+      return EncodedInfo();
+    }
+    buffered_frames_ = 0;
+    encoded->AppendData(static_cast<uint8_t>(bitrate_bps_ / 1000));
+    EncodedInfo info;
+    info.encoded_bytes = 1;
+    info.encoded_timestamp = packet_timestamp_;
+    info.payload_type = kPayloadType;
+    return info;
+  }
+
+ private:
+  const int bitrate_bps_;
+  std::atomic<int>* const encode_count_;
+  const size_t frames_per_packet_;
+  size_t buffered_frames_ = 0;
+  uint32_t packet_timestamp_ = 0;
+};
+
+class FakeSink : public SharedAudioEncoder::Sink {
+ public:
+  void OnEncodedAudio(
+      const SharedAudioEncoder::EncodedAudio& encoded_audio) override {
+    MutexLock lock(&mutex_);
+    packets_.push_back(encoded_audio);
+    received_.Set();
+  }
+
+  // Waits until at least `count` packets have been received.
+  bool WaitForPackets(size_t count) {
+    while (true) {
+      {
+        MutexLock lock(&mutex_);
+        if (packets_.size() >= count)
+          return true;
+      }
+      if (!received_.Wait(TimeDelta::Seconds(5)))
+        return false;
+    }
+  }
+
+  std::vector<SharedAudioEncoder::EncodedAudio> packets() {
+    MutexLock lock(&mutex_);
+    return packets_;
+  }
+
+ private:
+  Mutex mutex_;
+  std::vector<SharedAudioEncoder::EncodedAudio> packets_
+      RTC_GUARDED_BY(mutex_);
+  rtc::Event received_;
+};
+
+std::unique_ptr<AudioFrame> CreateFrame(uint32_t timestamp) {
+  auto frame = std::make_unique<AudioFrame>();
+  frame->UpdateFrame(timestamp, nullptr, kSamplesPerFrame, kSampleRateHz,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadActive, 1);
+  return frame;
+}
+
+class SharedAudioEncoderTest : public ::testing::Test {
+ protected:
+  SharedAudioEncoderTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        shared_encoder_(rtc::make_ref_counted<SharedAudioEncoder>(
+            task_queue_factory_.get(),
+            std::vector<int>{kHighBitrateBps, kLowBitrateBps},
+            [this](int bitrate_bps) {
+              return std::make_unique<FakeEncoder>(
+                  bitrate_bps, bitrate_bps == kLowBitrateBps
+                                   ? &low_encode_count_
+                                   : &high_encode_count_);
+            })) {}
+
+  std::atomic<int> low_encode_count_{0};
+  std::atomic<int> high_encode_count_{0};
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  rtc::scoped_refptr<SharedAudioEncoder> shared_encoder_;
+};
+
+TEST_F(SharedAudioEncoderTest, EncodesOncePerBitrateForAllSinks) {
+  constexpr size_t kNumFrames = 10;
+  FakeSink low_sinks[2];
+  FakeSink high_sink;
+  shared_encoder_->AddSink(&low_sinks[0], kLowBitrateBps);
+  shared_encoder_->AddSink(&low_sinks[1], kLowBitrateBps);
+  shared_encoder_->AddSink(&high_sink, kHighBitrateBps);
+
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    for (const FakeSink* sink : {&low_sinks[0], &low_sinks[1], &high_sink}) {
+      shared_encoder_->OnAudioFrame(sink, *CreateFrame(i * kSamplesPerFrame),
+                                    /*muted=*/false);
+    }
+  }
+  ASSERT_TRUE(low_sinks[0].WaitForPackets(kNumFrames));
+  ASSERT_TRUE(low_sinks[1].WaitForPackets(kNumFrames - 1));
+  ASSERT_TRUE(high_sink.WaitForPackets(kNumFrames - 1));
+  shared_encoder_->RemoveSink(&low_sinks[0]);
+  shared_encoder_->RemoveSink(&low_sinks[1]);
+  shared_encoder_->RemoveSink(&high_sink);
+
+  EXPECT_EQ(low_encode_count_, static_cast<int>(kNumFrames));
+  EXPECT_EQ(high_encode_count_, static_cast<int>(kNumFrames));
+  for (const auto& packet : low_sinks[1].packets()) {
+    EXPECT_EQ(packet.payload_type, kPayloadType);
+    ASSERT_EQ(packet.payload.size(), 1u);
+    EXPECT_EQ(packet.payload[0], kLowBitrateBps / 1000);
+  }
+  for (const auto& packet : high_sink.packets()) {
+    ASSERT_EQ(packet.payload.size(), 1u);
+    EXPECT_EQ(packet.payload[0], kHighBitrateBps / 1000);
+  }
+}
+
+TEST_F(SharedAudioEncoderTest, DoesNotEncodeUnusedBitrates) {
+  FakeSink sink;
+  shared_encoder_->AddSink(&sink, kLowBitrateBps);
+  for (size_t i = 0; i < 3; ++i) {
+    shared_encoder_->OnAudioFrame(&sink, *CreateFrame(i * kSamplesPerFrame),
+                                  /*muted=*/false);
+  }
+  ASSERT_TRUE(sink.WaitForPackets(3));
+  shared_encoder_->RemoveSink(&sink);
+  EXPECT_EQ(low_encode_count_, 3);
+  EXPECT_EQ(high_encode_count_, 0);
+}
+
+TEST_F(SharedAudioEncoderTest, PicksHighestBitrateNotAboveTarget) {
+  FakeSink sink;
+  shared_encoder_->AddSink(&sink, kHighBitrateBps + 1000);
+  EXPECT_EQ(shared_encoder_->GetSinkBitrate(&sink), kHighBitrateBps);
+  shared_encoder_->SetSinkBitrate(&sink, kHighBitrateBps - 1000);
+  EXPECT_EQ(shared_encoder_->GetSinkBitrate(&sink), kLowBitrateBps);
+  shared_encoder_->SetSinkBitrate(&sink, kLowBitrateBps / 2);
+  EXPECT_EQ(shared_encoder_->GetSinkBitrate(&sink), kLowBitrateBps);
+  shared_encoder_->RemoveSink(&sink);
+  EXPECT_EQ(shared_encoder_->GetSinkBitrate(&sink), 0);
+}
+
+TEST_F(SharedAudioEncoderTest, SwitchesSinkBetweenBitrates) {
+  FakeSink sink;
+  shared_encoder_->AddSink(&sink, kLowBitrateBps);
+  shared_encoder_->OnAudioFrame(&sink, *CreateFrame(0), /*muted=*/false);
+  ASSERT_TRUE(sink.WaitForPackets(1));
+  shared_encoder_->SetSinkBitrate(&sink, kHighBitrateBps);
+  shared_encoder_->OnAudioFrame(&sink, *CreateFrame(kSamplesPerFrame),
+                                /*muted=*/false);
+  ASSERT_TRUE(sink.WaitForPackets(2));
+  shared_encoder_->RemoveSink(&sink);
+
+  std::vector<SharedAudioEncoder::EncodedAudio> packets = sink.packets();
+  EXPECT_EQ(packets[0].payload[0], kLowBitrateBps / 1000);
+  EXPECT_EQ(packets[1].payload[0], kHighBitrateBps / 1000);
+  EXPECT_EQ(packets[1].rtp_timestamp - packets[0].rtp_timestamp,
+            kSamplesPerFrame);
+}
+
+TEST(SharedAudioEncoderPacketTest, SwitchesBitratesWithoutLosingAudio) {
+  constexpr size_t kFramesPerPacket = 2;
+  constexpr uint32_t kPacketSamples = kFramesPerPacket * kSamplesPerFrame;
+  std::atomic<int> encode_count{0};
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  auto shared_encoder = rtc::make_ref_counted<SharedAudioEncoder>(
+      task_queue_factory.get(),
+      std::vector<int>{kLowBitrateBps, kHighBitrateBps},
+      [&](int bitrate_bps) {
+        return std::make_unique<FakeEncoder>(bitrate_bps, &encode_count,
+                                             kFramesPerPacket);
+      });
+  FakeSink sink;
+  shared_encoder->AddSink(&sink, kLowBitrateBps);
+  for (size_t i = 0; i < 3; ++i) {
+    shared_encoder->OnAudioFrame(&sink, *CreateFrame(i * kSamplesPerFrame),
+                                 /*muted=*/false);
+  }
+  ASSERT_TRUE(sink.WaitForPackets(1));
+  // Switch in the middle of the second packet. The high bitrate encodes the
+  // frame of that packet it missed, instead of starting a packet later.
+  shared_encoder->SetSinkBitrate(&sink, kHighBitrateBps);
+  for (size_t i = 3; i < 6; ++i) {
+    shared_encoder->OnAudioFrame(&sink, *CreateFrame(i * kSamplesPerFrame),
+                                 /*muted=*/false);
+  }
+  ASSERT_TRUE(sink.WaitForPackets(3));
+  shared_encoder->RemoveSink(&sink);
+
+  std::vector<SharedAudioEncoder::EncodedAudio> packets = sink.packets();
+  ASSERT_EQ(packets.size(), 3u);
+  EXPECT_EQ(packets[0].payload[0], kLowBitrateBps / 1000);
+  EXPECT_EQ(packets[1].payload[0], kHighBitrateBps / 1000);
+  EXPECT_EQ(packets[2].payload[0], kHighBitrateBps / 1000);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(packets[i].rtp_timestamp, i * kPacketSamples);
+  }
+}
+
+TEST_F(SharedAudioEncoderTest, MapsTimestampsToEachSink) {
+  constexpr uint32_t kOtherStartTimestamp = 123456;
+  constexpr size_t kNumFrames = 5;
+  FakeSink feeding_sink;
+  FakeSink other_sink;
+  shared_encoder_->AddSink(&feeding_sink, kLowBitrateBps);
+  shared_encoder_->AddSink(&other_sink, kLowBitrateBps);
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    shared_encoder_->OnAudioFrame(
+        &feeding_sink, *CreateFrame(i * kSamplesPerFrame), /*muted=*/false);
+    shared_encoder_->OnAudioFrame(
+        &other_sink, *CreateFrame(kOtherStartTimestamp + i * kSamplesPerFrame),
+        /*muted=*/false);
+  }
+  ASSERT_TRUE(feeding_sink.WaitForPackets(kNumFrames));
+  // The first packet was encoded before the other sink gave its timestamps.
+  ASSERT_TRUE(other_sink.WaitForPackets(kNumFrames - 1));
+  shared_encoder_->RemoveSink(&feeding_sink);
+  shared_encoder_->RemoveSink(&other_sink);
+
+  std::vector<SharedAudioEncoder::EncodedAudio> packets =
+      feeding_sink.packets();
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(packets[i].rtp_timestamp, i * kSamplesPerFrame);
+  }
+  packets = other_sink.packets();
+  ASSERT_EQ(packets.size(), kNumFrames - 1);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(packets[i].rtp_timestamp,
+              kOtherStartTimestamp + i * kSamplesPerFrame);
+  }
+}
+
+TEST_F(SharedAudioEncoderTest, NextSinkFeedsWhenFirstIsRemoved) {
+  FakeSink first_sink;
+  FakeSink second_sink;
+  shared_encoder_->AddSink(&first_sink, kLowBitrateBps);
+  shared_encoder_->AddSink(&second_sink, kLowBitrateBps);
+  shared_encoder_->OnAudioFrame(&first_sink, *CreateFrame(0), /*muted=*/false);
+  shared_encoder_->OnAudioFrame(&second_sink, *CreateFrame(0),
+                                /*muted=*/false);
+  ASSERT_TRUE(first_sink.WaitForPackets(1));
+  shared_encoder_->RemoveSink(&first_sink);
+
+  // Frames from the second sink are now encoded, and the removed sink gets
+  // nothing.
+  shared_encoder_->OnAudioFrame(&first_sink, *CreateFrame(kSamplesPerFrame),
+                                /*muted=*/false);
+  shared_encoder_->OnAudioFrame(&second_sink, *CreateFrame(kSamplesPerFrame),
+                                /*muted=*/false);
+  ASSERT_TRUE(second_sink.WaitForPackets(1));
+  shared_encoder_->RemoveSink(&second_sink);
+  EXPECT_EQ(first_sink.packets().size(), 1u);
+  EXPECT_EQ(low_encode_count_, 2);
+}
+
+TEST_F(SharedAudioEncoderTest, MutedSinksGetNoAudio) {
+  FakeSink muted_sink;
+  FakeSink unmuted_sink;
+  shared_encoder_->AddSink(&muted_sink, kLowBitrateBps);
+  shared_encoder_->AddSink(&unmuted_sink, kHighBitrateBps);
+  for (size_t i = 0; i < 3; ++i) {
+    shared_encoder_->OnAudioFrame(
+        &muted_sink, *CreateFrame(i * kSamplesPerFrame), /*muted=*/true);
+    shared_encoder_->OnAudioFrame(
+        &unmuted_sink, *CreateFrame(i * kSamplesPerFrame), /*muted=*/false);
+  }
+  // The first frame was encoded before the unmuted sink gave its timestamps.
+  ASSERT_TRUE(unmuted_sink.WaitForPackets(2));
+  shared_encoder_->RemoveSink(&muted_sink);
+  shared_encoder_->RemoveSink(&unmuted_sink);
+
+  // The audio of the muted, feeding sink is still encoded for the other sink,
+  // but nobody needs the bitrate of the muted sink.
+  EXPECT_TRUE(muted_sink.packets().empty());
+  EXPECT_EQ(unmuted_sink.packets()[0].payload[0], kHighBitrateBps / 1000);
+  EXPECT_EQ(low_encode_count_, 0);
+}
+
+TEST_F(SharedAudioEncoderTest, DeliversWithoutBlockingAudioFrames) {
+  // Blocks in its first callback until released.
+  class BlockingSink : public FakeSink {
+   public:
+    void OnEncodedAudio(
+        const SharedAudioEncoder::EncodedAudio& encoded_audio) override {
+      if (!blocked_) {
+        blocked_ = true;
+        entered_.Set();
+        release_.Wait(TimeDelta::Seconds(5));
+      }
+      FakeSink::OnEncodedAudio(encoded_audio);
+    }
+
+    rtc::Event entered_;
+    rtc::Event release_;
+
+   private:
+    bool blocked_ = false;
+  };
+
+  BlockingSink sink;
+  shared_encoder_->AddSink(&sink, kLowBitrateBps);
+  shared_encoder_->OnAudioFrame(&sink, *CreateFrame(0), /*muted=*/false);
+  ASSERT_TRUE(sink.entered_.Wait(TimeDelta::Seconds(5)));
+  // The sink is being called, which must not block the audio thread.
+  shared_encoder_->OnAudioFrame(&sink, *CreateFrame(kSamplesPerFrame),
+                                /*muted=*/false);
+  shared_encoder_->SetSinkBitrate(&sink, kHighBitrateBps);
+  EXPECT_EQ(shared_encoder_->GetSinkBitrate(&sink), kHighBitrateBps);
+  sink.release_.Set();
+  ASSERT_TRUE(sink.WaitForPackets(2));
+  shared_encoder_->RemoveSink(&sink);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -37,6 +37,19 @@ std::string AudioSendStream::Config::ToString() const {
   ss << ", has_dscp: " << (has_dscp ? "true" : "false");
   ss << ", send_codec_spec: "
      << (send_codec_spec ? send_codec_spec->ToString() : "<unset>");
+  if (!shared_encoder_group.empty()) {
+    ss << ", shared_encoder_group: " << shared_encoder_group;
+  }
+  if (!shared_encoder_bitrates_bps.empty()) {
+    ss << ", shared_encoder_bitrates_bps: [";
+    for (size_t i = 0; i < shared_encoder_bitrates_bps.size(); ++i) {
+      ss << shared_encoder_bitrates_bps[i];
+      if (i != shared_encoder_bitrates_bps.size() - 1) {
+        ss << ", ";
+      }
+    }
+    ss << "]";
+  }
   ss << "}";
   return ss.Release();
 }
@@ -156,6 +156,15 @@ class AudioSendStream : public AudioSender {
     // Track ID as specified during track creation.
     std::string track_id;
 
+    // If both are set, streams with the same shared encoder group, send codec
+    // spec and bitrates share their encoder, which encodes at each of these
+    // codec bitrates. Each stream sends the highest of them that fits its
+    // allocated bitrate. The group is chosen by the application, and must only
+    // be shared by streams that send the same audio. Audio network adaptation
+    // and packet loss feedback are not applied to shared encoders.
+    std::string shared_encoder_group;
+    std::vector<int> shared_encoder_bitrates_bps;
+
     // Per PeerConnection crypto options.
     webrtc::CryptoOptions crypto_options;
 
@@ -24,6 +24,7 @@
 #include "absl/functional/bind_front.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/media_types.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/sequence_checker.h"
@@ -241,6 +242,11 @@ class Call final : public webrtc::Call,
       RtpPacketReceived packet,
       OnUndemuxablePacketHandler undemuxable_packet_handler) override;
 
+  void DeliverRtpPackets(
+      MediaType media_type,
+      std::vector<RtpPacketReceived> packets,
+      OnUndemuxablePacketHandler undemuxable_packet_handler) override;
+
   void SignalChannelNetworkState(MediaType media, NetworkState state) override;
 
   void OnAudioTransportOverheadChanged(
@@ -332,6 +338,19 @@ class Call final : public webrtc::Call,
       absl::string_view sync_group) RTC_RUN_ON(worker_thread_);
   void ConfigureSync(absl::string_view sync_group) RTC_RUN_ON(worker_thread_);
 
+  // Repairs the arrival time of a received RTP packet and reports the packet
+  // to the bandwidth estimator. Returns false if the packet is a keep-alive
+  // packet that should not be demuxed.
+  bool PrepareReceivedRtpPacket(MediaType media_type,
+                                RtpPacketReceived& packet)
+      RTC_RUN_ON(worker_thread_);
+  // Demuxes `packets`, which all have the same SSRC, with a single lookup of
+  // the receive stream.
+  void DemuxRtpPackets(MediaType media_type,
+                       rtc::ArrayView<const RtpPacketReceived> packets,
+                       OnUndemuxablePacketHandler& undemuxable_packet_handler)
+      RTC_RUN_ON(worker_thread_);
+
   void NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
                                  MediaType media_type)
       RTC_RUN_ON(worker_thread_);
@@ -1191,14 +1210,19 @@ void Call::SignalChannelNetworkState(MediaType media, NetworkState state) {
 
 void Call::OnAudioTransportOverheadChanged(int transport_overhead_per_packet) {
   RTC_DCHECK_RUN_ON(network_thread_);
-  worker_thread_->PostTask(
-      SafeTask(task_safety_.flag(), [this, transport_overhead_per_packet]() {
-        // TODO(bugs.webrtc.org/11993): Move this over to the network thread.
-        RTC_DCHECK_RUN_ON(worker_thread_);
-        for (auto& kv : audio_send_ssrcs_) {
-          kv.second->SetTransportOverhead(transport_overhead_per_packet);
-        }
-      }));
+  auto closure = [this, transport_overhead_per_packet]() {
+    // TODO(bugs.webrtc.org/11993): Move this over to the network thread.
+    RTC_DCHECK_RUN_ON(worker_thread_);
+    for (auto& kv : audio_send_ssrcs_) {
+      kv.second->SetTransportOverhead(transport_overhead_per_packet);
+    }
+  };
+
+  if (network_thread_ == worker_thread_) {
+    closure();
+  } else {
+    worker_thread_->PostTask(SafeTask(task_safety_.flag(), std::move(closure)));
+  }
 }
 
 void Call::UpdateAggregateNetworkState() {
@@ -1402,6 +1426,49 @@ void Call::DeliverRtpPacket(
     RtpPacketReceived packet,
     OnUndemuxablePacketHandler undemuxable_packet_handler) {
   RTC_DCHECK_RUN_ON(worker_thread_);
+  if (!PrepareReceivedRtpPacket(media_type, packet)) {
+    return;
+  }
+  DemuxRtpPackets(media_type, rtc::MakeArrayView(&packet, 1),
+                  undemuxable_packet_handler);
+}
+
+void Call::DeliverRtpPackets(
+    MediaType media_type,
+    std::vector<RtpPacketReceived> packets,
+    OnUndemuxablePacketHandler undemuxable_packet_handler) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  size_t num_packets = 0;
+  for (RtpPacketReceived& packet : packets) {
+    if (PrepareReceivedRtpPacket(media_type, packet)) {
+      if (&packets[num_packets] != &packet) {
+        packets[num_packets] = std::move(packet);
+      }
+      ++num_packets;
+    }
+  }
+  packets.resize(num_packets);
+
+  // Demux each run of consecutive packets with the same SSRC at once, so that
+  // the receive stream is looked up once per run. Packets are not reordered,
+  // since e.g. RTX and FlexFEC packets must not overtake the media packets
+  // that arrived before them.
+  rtc::ArrayView<const RtpPacketReceived> remaining(packets);
+  while (!remaining.empty()) {
+    const uint32_t ssrc = remaining[0].Ssrc();
+    size_t group_size = 1;
+    while (group_size < remaining.size() &&
+           remaining[group_size].Ssrc() == ssrc) {
+      ++group_size;
+    }
+    DemuxRtpPackets(media_type, remaining.subview(0, group_size),
+                    undemuxable_packet_handler);
+    remaining = remaining.subview(group_size);
+  }
+}
+
+bool Call::PrepareReceivedRtpPacket(MediaType media_type,
+                                    RtpPacketReceived& packet) {
   RTC_DCHECK(packet.arrival_time().IsFinite());
 
   if (receive_time_calculator_) {
@@ -1423,36 +1490,57 @@ void Call::DeliverRtpPacket(
 
   if (media_type != MediaType::AUDIO && media_type != MediaType::VIDEO) {
     RTC_DCHECK(is_keep_alive_packet);
-    return;
+    return false;
   }
+  return true;
+}
 
+void Call::DemuxRtpPackets(
+    MediaType media_type,
+    rtc::ArrayView<const RtpPacketReceived> packets,
+    OnUndemuxablePacketHandler& undemuxable_packet_handler) {
+  RTC_DCHECK(!packets.empty());
   RtpStreamReceiverController& receiver_controller =
       media_type == MediaType::AUDIO ? audio_receiver_controller_
                                      : video_receiver_controller_;
 
-  if (!receiver_controller.OnRtpPacket(packet)) {
+  // The controller demuxes by SSRC only, so the packets are either all
+  // forwarded or all dropped.
+  size_t forwarded = receiver_controller.OnRtpPackets(packets);
+  while (forwarded == 0) {
     // Demuxing failed.  Allow the caller to create a
     // receive stream in order to handle unsignalled SSRCs and try again.
+    // Like for packets delivered one by one, the caller sees every packet
+    // that could not be demuxed.
     // Note that we dont want to call NotifyBweOfReceivedPacket twice per
     // packet.
-    if (!undemuxable_packet_handler(packet)) {
-      return;
+    if (undemuxable_packet_handler(packets[0])) {
+      forwarded = receiver_controller.OnRtpPackets(packets);
+      if (forwarded > 0) {
+        break;
+      }
+      RTC_LOG(LS_INFO) << "Failed to demux packet " << packets[0].Ssrc();
     }
-    if (!receiver_controller.OnRtpPacket(packet)) {
-      RTC_LOG(LS_INFO) << "Failed to demux packet " << packet.Ssrc();
+    packets = packets.subview(1);
+    if (packets.empty()) {
       return;
     }
+    forwarded = receiver_controller.OnRtpPackets(packets);
   }
-  event_log_->Log(std::make_unique<RtcEventRtpPacketIncoming>(packet));
+  RTC_DCHECK_EQ(forwarded, packets.size());
 
-  // RateCounters expect input parameter as int, save it as int,
-  // instead of converting each time it is passed to RateCounter::Add below.
-  int length = static_cast<int>(packet.size());
-  if (media_type == MediaType::AUDIO) {
-    receive_stats_.AddReceivedAudioBytes(length, packet.arrival_time());
-  }
-  if (media_type == MediaType::VIDEO) {
-    receive_stats_.AddReceivedVideoBytes(length, packet.arrival_time());
+  for (const RtpPacketReceived& packet : packets) {
+    event_log_->Log(std::make_unique<RtcEventRtpPacketIncoming>(packet));
+
+    // RateCounters expect input parameter as int, save it as int,
+    // instead of converting each time it is passed to RateCounter::Add below.
+    int length = static_cast<int>(packet.size());
+    if (media_type == MediaType::AUDIO) {
+      receive_stats_.AddReceivedAudioBytes(length, packet.arrival_time());
+    }
+    if (media_type == MediaType::VIDEO) {
+      receive_stats_.AddReceivedVideoBytes(length, packet.arrival_time());
+    }
   }
 }
 
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
@@ -23,6 +24,7 @@
 #include "api/test/mock_audio_mixer.h"
 #include "api/test/video/function_video_encoder_factory.h"
 #include "api/transport/field_trial_based_config.h"
+#include "api/units/timestamp.h"
 #include "api/video/builtin_video_bitrate_allocator_factory.h"
 #include "audio/audio_receive_stream.h"
 #include "audio/audio_send_stream.h"
@@ -31,6 +33,7 @@
 #include "call/audio_state.h"
 #include "modules/audio_device/include/mock_audio_device.h"
 #include "modules/audio_processing/include/mock_audio_processing.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "test/fake_encoder.h"
 #include "test/gtest.h"
@@ -42,6 +45,7 @@ namespace {
 
 using ::testing::_;
 using ::testing::Contains;
+using ::testing::ElementsAre;
 using ::testing::NiceMock;
 using ::testing::StrictMock;
 
@@ -351,6 +355,28 @@ TEST(CallTest, RecreatingAudioStreamWithSameSsrcReusesRtpState) {
   }
 }
 
+TEST(CallTest, DeliverRtpPacketsOffersUndemuxablePacketsInArrivalOrder) {
+  CallHelper call(true);
+  std::vector<RtpPacketReceived> packets;
+  for (uint32_t ssrc : {1u, 1u, 2u, 1u, 2u}) {
+    RtpPacketReceived packet;
+    packet.SetSsrc(ssrc);
+    packet.SetPayloadType(111);
+    packet.SetPayloadSize(10);
+    packet.set_arrival_time(Timestamp::Millis(1));
+    packets.push_back(std::move(packet));
+  }
+
+  std::vector<uint32_t> undemuxable_ssrcs;
+  call->Receiver()->DeliverRtpPackets(
+      MediaType::AUDIO, std::move(packets),
+      [&](const RtpPacketReceived& packet) {
+        undemuxable_ssrcs.push_back(packet.Ssrc());
+        return false;
+      });
+  EXPECT_THAT(undemuxable_ssrcs, ElementsAre(1u, 1u, 2u, 1u, 2u));
+}
+
 TEST(CallTest, AddAdaptationResourceAfterCreatingVideoSendStream) {
   CallHelper call(true);
   // Create a VideoSendStream.
@@ -10,6 +10,9 @@
 #ifndef CALL_PACKET_RECEIVER_H_
 #define CALL_PACKET_RECEIVER_H_
 
+#include <utility>
+#include <vector>
+
 #include "absl/functional/any_invocable.h"
 #include "api/media_types.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
@@ -34,6 +37,23 @@ class PacketReceiver {
       RtpPacketReceived packet,
       OnUndemuxablePacketHandler undemuxable_packet_handler) = 0;
 
+  // Demux a batch of RTP packets of the same media type. Must be called on the
+  // worker thread. Packets are delivered in order, and
+  // `undemuxable_packet_handler` is invoked once for every packet that can not
+  // be demuxed. The default delivers the packets one by one.
+  virtual void DeliverRtpPackets(
+      MediaType media_type,
+      std::vector<RtpPacketReceived> packets,
+      OnUndemuxablePacketHandler undemuxable_packet_handler) {
+    for (RtpPacketReceived& packet : packets) {
+      DeliverRtpPacket(media_type, std::move(packet),
+                       [&undemuxable_packet_handler](
+                           const RtpPacketReceived& parsed_packet) {
+                         return undemuxable_packet_handler(parsed_packet);
+                       });
+    }
+  }
+
  protected:
   virtual ~PacketReceiver() {}
 };
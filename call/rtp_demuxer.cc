@@ -159,6 +159,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  InvalidateSinkCache();
 
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
@@ -252,6 +253,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  InvalidateSinkCache();
   return num_removed > 0;
 }
 
@@ -264,8 +266,60 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
   return false;
 }
 
+size_t RtpDemuxer::OnRtpPackets(
+    rtc::ArrayView<const RtpPacketReceived> packets) {
+  size_t forwarded = 0;
+  RtpPacketSinkInterface* last_sink = nullptr;
+  uint32_t last_ssrc = 0;
+  uint8_t last_payload_type = 0;
+  for (const RtpPacketReceived& packet : packets) {
+    RtpPacketSinkInterface* sink;
+    // A packet without MID or RSID/RRID can only be routed by what is already
+    // latched for its SSRC, which the previous packet's resolution reflects.
+    if (last_sink != nullptr && packet.Ssrc() == last_ssrc &&
+        packet.PayloadType() == last_payload_type &&
+        !(use_mid_ && packet.HasExtension<RtpMid>()) &&
+        !packet.HasExtension<RtpStreamId>() &&
+        !packet.HasExtension<RepairedRtpStreamId>()) {
+      sink = last_sink;
+    } else {
+      sink = ResolveSink(packet);
+    }
+    last_sink = sink;
+    last_ssrc = packet.Ssrc();
+    last_payload_type = packet.PayloadType();
+    if (sink != nullptr) {
+      sink->OnRtpPacket(packet);
+      ++forwarded;
+    }
+  }
+  return forwarded;
+}
+
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  uint32_t ssrc = packet.Ssrc();
+  // Packets carrying demux header extensions may update the SSRC latching and
+  // must always run the full algorithm. Without them the outcome only depends
+  // on the demuxer state, which the cache generation tracks.
+  bool has_demux_extension = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                             packet.HasExtension<RtpStreamId>() ||
+                             packet.HasExtension<RepairedRtpStreamId>();
+  if (!has_demux_extension) {
+    const auto it = sink_cache_by_ssrc_.find(ssrc);
+    if (it != sink_cache_by_ssrc_.end() &&
+        it->second.generation == sink_generation_) {
+      return it->second.sink;
+    }
+  }
+
+  RtpPacketSinkInterface* sink = ResolveSinkUncached(packet);
+  UpdateSinkCache(ssrc, sink);
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkUncached(
+    const RtpPacketReceived& packet) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -436,4 +490,35 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
   }
 }
 
+void RtpDemuxer::UpdateSinkCache(uint32_t ssrc,
+                                 RtpPacketSinkInterface* sink) {
+  // A sink that could not be bound to the SSRC (e.g. because the binding limit
+  // was reached) may have been chosen by payload type, which can differ for
+  // the next packet, so only bound sinks are cached.
+  const auto bound = sink_by_ssrc_.find(ssrc);
+  if (sink == nullptr || bound == sink_by_ssrc_.end() ||
+      bound->second != sink) {
+    sink_cache_by_ssrc_.erase(ssrc);
+    return;
+  }
+
+  // Stale entries are only ever overwritten, so prune them once they make up
+  // the bulk of the cache.
+  if (sink_cache_by_ssrc_.size() >= 2 * sink_by_ssrc_.size()) {
+    for (auto it = sink_cache_by_ssrc_.begin();
+         it != sink_cache_by_ssrc_.end();) {
+      if (it->second.generation != sink_generation_) {
+        it = sink_cache_by_ssrc_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  sink_cache_by_ssrc_[ssrc] = {sink, sink_generation_};
+}
+
+void RtpDemuxer::InvalidateSinkCache() {
+  ++sink_generation_;
+}
+
 }  // namespace webrtc
@@ -13,10 +13,12 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/containers/flat_set.h"
 
@@ -155,6 +157,12 @@ class RtpDemuxer {
   // if the packet was forwarded and false if the packet was dropped.
   bool OnRtpPacket(const RtpPacketReceived& packet);
 
+  // Demuxes a batch of packets, in order, forwarding each to its chosen sink.
+  // Consecutive packets with the same SSRC and payload type that carry no
+  // MID/RSID/RRID header extension reuse the sink resolved for the previous
+  // packet. Returns the number of packets that were forwarded.
+  size_t OnRtpPackets(rtc::ArrayView<const RtpPacketReceived> packets);
+
  private:
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
@@ -164,7 +172,10 @@ class RtpDemuxer {
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
+  // Packets without MID/RSID/RRID header extensions are first looked up in
+  // `sink_cache_by_ssrc_`.
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  RtpPacketSinkInterface* ResolveSinkUncached(const RtpPacketReceived& packet);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(absl::string_view mid,
@@ -210,6 +221,25 @@ class RtpDemuxer {
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
+  // Records the outcome of a full ResolveSink run for `ssrc`. Only outcomes
+  // that later packets without demux header extensions are bound to repeat,
+  // i.e. a sink that is now bound to the SSRC, are cached.
+  void UpdateSinkCache(uint32_t ssrc, RtpPacketSinkInterface* sink);
+
+  // Invalidates all entries of `sink_cache_by_ssrc_`.
+  void InvalidateSinkCache();
+
+  // Result of the demux algorithm for packets of an SSRC that carry no MID,
+  // RSID or RRID header extension. Entries are valid as long as their
+  // generation matches `sink_generation_`, which is bumped whenever sinks are
+  // added or removed. Stale entries are overwritten or pruned lazily.
+  struct CachedSink {
+    RtpPacketSinkInterface* sink;
+    uint64_t generation;
+  };
+  std::unordered_map<uint32_t, CachedSink> sink_cache_by_ssrc_;
+  uint64_t sink_generation_ = 0;
+
   const bool use_mid_;
 };
 
@@ -13,6 +13,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "call/test/mock_rtp_packet_sink_interface.h"
@@ -392,6 +393,31 @@ TEST_F(RtpDemuxerTest, PacketsDeliveredInRightOrder) {
   }
 }
 
+TEST_F(RtpDemuxerTest, BatchOfPacketsDeliveredInRightOrder) {
+  constexpr uint32_t ssrcs[] = {101, 102};
+  MockRtpPacketSink sinks[2];
+  AddSinkOnlySsrc(ssrcs[0], &sinks[0]);
+  AddSinkOnlySsrc(ssrcs[1], &sinks[1]);
+
+  // Alternate runs of packets between the two sinks, and add one packet that
+  // no sink accepts.
+  std::vector<RtpPacketReceived> packets;
+  for (size_t i = 0; i < 6; i++) {
+    auto packet = CreatePacketWithSsrc(ssrcs[i / 2 % 2]);
+    packet->SetSequenceNumber(rtc::checked_cast<uint16_t>(i));
+    packets.push_back(*packet);
+  }
+  packets.push_back(*CreatePacketWithSsrc(103));
+
+  InSequence sequence;
+  for (size_t i = 0; i < 6; i++) {
+    EXPECT_CALL(sinks[i / 2 % 2], OnRtpPacket(SamePacketAs(packets[i])))
+        .Times(1);
+  }
+
+  EXPECT_EQ(demuxer_.OnRtpPackets(packets), 6u);
+}
+
 TEST_F(RtpDemuxerTest, SinkMappedToMultipleSsrcs) {
   constexpr uint32_t ssrcs[] = {404, 505, 606};
   MockRtpPacketSink sink;
@@ -1257,6 +1283,56 @@ TEST_F(RtpDemuxerTest, MidMustNotExceedMaximumLength) {
   EXPECT_TRUE(RemoveSink(&sink1));
 }
 
+TEST_F(RtpDemuxerTest, SsrcLatchedByMidFollowsReplacedMidSink) {
+  const std::string mid = "v";
+  constexpr uint32_t ssrc = 10;
+
+  MockRtpPacketSink sink1;
+  AddSinkOnlyMid(mid, &sink1);
+
+  auto packet_with_mid = CreatePacketWithSsrcMid(ssrc, mid);
+  auto packet_without_mid = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*packet_with_mid))).Times(1);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*packet_without_mid))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_with_mid));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_without_mid));
+
+  RemoveSink(&sink1);
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid(mid, &sink2);
+
+  auto packet = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink1, OnRtpPacket(_)).Times(0);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*packet))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet));
+}
+
+TEST_F(RtpDemuxerTest, PacketWithNewMidRebindsLatchedSsrc) {
+  const std::string mid1 = "v1";
+  const std::string mid2 = "v2";
+  constexpr uint32_t ssrc = 10;
+
+  MockRtpPacketSink sink1;
+  AddSinkOnlyMid(mid1, &sink1);
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid(mid2, &sink2);
+
+  auto p1 = CreatePacketWithSsrcMid(ssrc, mid1);
+  auto p2 = CreatePacketWithSsrc(ssrc);
+  auto p3 = CreatePacketWithSsrcMid(ssrc, mid2);
+  auto p4 = CreatePacketWithSsrc(ssrc);
+
+  InSequence sequence;
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*p1))).Times(1);
+  EXPECT_CALL(sink1, OnRtpPacket(SamePacketAs(*p2))).Times(1);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*p3))).Times(1);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*p4))).Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p2));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p3));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*p4));
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST_F(RtpDemuxerDeathTest, CriteriaMustBeNonEmpty) {
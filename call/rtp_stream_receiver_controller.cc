@@ -50,6 +50,12 @@ bool RtpStreamReceiverController::OnRtpPacket(const RtpPacketReceived& packet) {
   return demuxer_.OnRtpPacket(packet);
 }
 
+size_t RtpStreamReceiverController::OnRtpPackets(
+    rtc::ArrayView<const RtpPacketReceived> packets) {
+  RTC_DCHECK_RUN_ON(&demuxer_sequence_);
+  return demuxer_.OnRtpPackets(packets);
+}
+
 void RtpStreamReceiverController::OnRecoveredPacket(
     const RtpPacketReceived& packet) {
   RTC_DCHECK_RUN_ON(&demuxer_sequence_);
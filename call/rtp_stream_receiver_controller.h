@@ -12,6 +12,7 @@
 
 #include <memory>
 
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "call/rtp_demuxer.h"
 #include "call/rtp_stream_receiver_controller_interface.h"
@@ -38,6 +39,8 @@ class RtpStreamReceiverController : public RtpStreamReceiverControllerInterface,
 
   // TODO(bugs.webrtc.org/7135): Not yet responsible for parsing.
   bool OnRtpPacket(const RtpPacketReceived& packet);
+  // Demuxes `packets` in order. Returns the number of packets forwarded.
+  size_t OnRtpPackets(rtc::ArrayView<const RtpPacketReceived> packets);
 
   // Implements RecoveredPacketReceiver.
   // Responsible for demuxing recovered FLEXFEC packets.
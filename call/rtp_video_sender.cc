@@ -46,7 +46,11 @@ RtpStreamSender::RtpStreamSender(
       sender_video(std::move(sender_video)),
       fec_generator(std::move(fec_generator)) {}
 
-RtpStreamSender::~RtpStreamSender() = default;
+RtpStreamSender::~RtpStreamSender() {
+  // `sender_video` may still be packetizing on its own task queue. Stop it
+  // before the FEC generator and RTP module it sends through go away.
+  sender_video = nullptr;
+}
 
 }  // namespace webrtc_internal_rtp_video_sender
 
@@ -295,6 +299,8 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
     }
     video_config.frame_transformer = frame_transformer;
     video_config.task_queue_factory = task_queue_factory;
+    video_config.packetize_on_task_queue = absl::StartsWith(
+        trials.Lookup("WebRTC-Video-AsyncPacketization"), "Enabled");
     auto sender_video = std::make_unique<RTPSenderVideo>(video_config);
     rtp_streams.emplace_back(std::move(rtp_rtcp), std::move(sender_video),
                              std::move(fec_generator));
@@ -10,25 +10,146 @@
 
 #include "common_audio/include/audio_util.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
+namespace {
+
+// The compilers don't vectorize the int16_t conversions by themselves, because
+// of the rounding away from zero. The vectorized versions below handle 8
+// samples at a time, and return how many samples they converted; the caller
+// converts the rest. They give the same results as the scalar versions.
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+size_t S16ToFloatS16Simd(const int16_t* src,
+                         size_t size,
+                         float scale,
+                         float* dest) {
+  const __m128 scale_128 = _mm_set1_ps(scale);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i s16 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    // Sign extend by moving each sample to the upper half of a 32 bit lane.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s16, s16), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s16, s16), 16);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), scale_128));
+    _mm_storeu_ps(&dest[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(hi), scale_128));
+  }
+  return i;
+}
+
+size_t FloatS16ToS16Simd(const float* src,
+                         size_t size,
+                         float scale,
+                         int16_t* dest) {
+  const __m128 scale_128 = _mm_set1_ps(scale);
+  const __m128 max = _mm_set1_ps(32767.f);
+  const __m128 min = _mm_set1_ps(-32768.f);
+  const __m128 sign_mask = _mm_set1_ps(-0.f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  auto convert = [&](const float* v) {
+    __m128 x = _mm_mul_ps(_mm_loadu_ps(v), scale_128);
+    x = _mm_max_ps(_mm_min_ps(x, max), min);
+    // Truncating `x` + copysign(0.5, `x`) rounds half away from zero.
+    x = _mm_add_ps(x, _mm_or_ps(half, _mm_and_ps(x, sign_mask)));
+    return _mm_cvttps_epi32(x);
+  };
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[i]),
+                     _mm_packs_epi32(convert(&src[i]), convert(&src[i + 4])));
+  }
+  return i;
+}
+
+#elif defined(WEBRTC_HAS_NEON)
+
+size_t S16ToFloatS16Simd(const int16_t* src,
+                         size_t size,
+                         float scale,
+                         float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t s16 = vld1q_s16(&src[i]);
+    vst1q_f32(&dest[i],
+              vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s16))), scale));
+    vst1q_f32(&dest[i + 4],
+              vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s16))), scale));
+  }
+  return i;
+}
+
+size_t FloatS16ToS16Simd(const float* src,
+                         size_t size,
+                         float scale,
+                         int16_t* dest) {
+  const float32x4_t max = vdupq_n_f32(32767.f);
+  const float32x4_t min = vdupq_n_f32(-32768.f);
+  const uint32x4_t sign_mask = vdupq_n_u32(0x80000000u);
+  const uint32x4_t half = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+  auto convert = [&](const float* v) {
+    float32x4_t x = vmulq_n_f32(vld1q_f32(v), scale);
+    x = vmaxq_f32(vminq_f32(x, max), min);
+    // Truncating `x` + copysign(0.5, `x`) rounds half away from zero.
+    const uint32x4_t signed_half =
+        vorrq_u32(half, vandq_u32(vreinterpretq_u32_f32(x), sign_mask));
+    x = vaddq_f32(x, vreinterpretq_f32_u32(signed_half));
+    return vqmovn_s32(vcvtq_s32_f32(x));
+  };
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    vst1q_s16(&dest[i], vcombine_s16(convert(&src[i]), convert(&src[i + 4])));
+  }
+  return i;
+}
+
+#else
+
+size_t S16ToFloatS16Simd(const int16_t* src,
+                         size_t size,
+                         float scale,
+                         float* dest) {
+  return 0;
+}
+
+size_t FloatS16ToS16Simd(const float* src,
+                         size_t size,
+                         float scale,
+                         int16_t* dest) {
+  return 0;
+}
+
+#endif
+
+}  // namespace
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = FloatS16ToS16Simd(src, size, 32768.f, dest); i < size; ++i)
     dest[i] = FloatToS16(src[i]);
 }
 
 void S16ToFloat(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = S16ToFloatS16Simd(src, size, 1.f / 32768.f, dest); i < size;
+       ++i)
     dest[i] = S16ToFloat(src[i]);
 }
 
 void S16ToFloatS16(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = S16ToFloatS16Simd(src, size, 1.f, dest); i < size; ++i)
     dest[i] = src[i];
 }
 
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = FloatS16ToS16Simd(src, size, 1.f, dest); i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
 }
 
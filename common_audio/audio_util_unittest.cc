@@ -53,6 +53,43 @@ TEST(AudioUtilTest, FloatS16ToS16) {
   ExpectArraysEq(kReference, output, kSize);
 }
 
+// The conversions of arrays are vectorized, except for a few samples at the
+// end; check that both give the same results.
+TEST(AudioUtilTest, ArrayConversionsMatchScalarOnes) {
+  static constexpr float kFloatS16Input[] = {
+      0.f,      0.4f,     0.5f,     -0.4f,    -0.5f,   1.5f,    -1.5f,
+      2.5f,     -2.5f,    32766.5f, 32767.f,  32768.f, 1e9f,    -32767.5f,
+      -32768.f, -32769.f, -1e9f,    100.49f,  -100.51f, 12345.6f, -0.f};
+  static constexpr size_t kSize = arraysize(kFloatS16Input);
+  float float_input[kSize];
+  int16_t s16_input[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    float_input[i] = kFloatS16Input[i] / 32768.f;
+    s16_input[i] = FloatS16ToS16(kFloatS16Input[i]);
+  }
+
+  for (size_t size = 0; size <= kSize; ++size) {
+    int16_t s16_output[kSize];
+    float float_output[kSize];
+    FloatS16ToS16(kFloatS16Input, size, s16_output);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(FloatS16ToS16(kFloatS16Input[i]), s16_output[i]);
+    }
+    FloatToS16(float_input, size, s16_output);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(FloatToS16(float_input[i]), s16_output[i]);
+    }
+    S16ToFloat(s16_input, size, float_output);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(S16ToFloat(s16_input[i]), float_output[i]);
+    }
+    S16ToFloatS16(s16_input, size, float_output);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(static_cast<float>(s16_input[i]), float_output[i]);
+    }
+  }
+}
+
 TEST(AudioUtilTest, FloatToFloatS16) {
   static constexpr float kInput[] = {0.f,
                                      0.4f / 32768.f,
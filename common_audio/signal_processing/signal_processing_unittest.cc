@@ -539,18 +539,56 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(SplTest, CrossCorrelationSSE2IsBitExact) {
+  constexpr size_t kMaxSeqDimension = 67;
+  constexpr size_t kCrossCorrelationDimension = 9;
+  constexpr size_t kBufferSize =
+      kMaxSeqDimension + 2 * kCrossCorrelationDimension;
+  int16_t seq1[kBufferSize];
+  int16_t seq2[kBufferSize];
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < kBufferSize; ++i) {
+    seq1[i] = WebRtcSpl_RandU(&seed) * 2 - WEBRTC_SPL_WORD16_MAX;
+    seq2[i] = WebRtcSpl_RandU(&seed) * 2 - WEBRTC_SPL_WORD16_MAX;
+  }
+  // Include extreme values, whose products are the largest possible.
+  seq1[3] = seq2[3] = WEBRTC_SPL_WORD16_MIN;
+  seq1[4] = seq2[4] = WEBRTC_SPL_WORD16_MIN;
+
+  for (size_t dim_seq : {1, 7, 8, 15, 16, 60, 67}) {
+    for (int shift : {0, 1, 6, 15}) {
+      for (int step : {-1, 1}) {
+        // Start in the middle, so that negative steps stay in the buffer.
+        const int16_t* start = &seq2[kCrossCorrelationDimension];
+        int32_t expected[kCrossCorrelationDimension];
+        int32_t actual[kCrossCorrelationDimension];
+        WebRtcSpl_CrossCorrelationC(expected, seq1, start, dim_seq,
+                                    kCrossCorrelationDimension, shift, step);
+        WebRtcSpl_CrossCorrelationSSE2(actual, seq1, start, dim_seq,
+                                       kCrossCorrelationDimension, shift,
+                                       step);
+        for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+          EXPECT_EQ(expected[i], actual[i])
+              << "dim_seq: " << dim_seq << ", shift: " << shift
+              << ", step: " << step << ", index: " << i;
+        }
+      }
+    }
+  }
+}
+#endif
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
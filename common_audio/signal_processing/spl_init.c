@@ -61,7 +61,12 @@ const MaxValueW16 WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16C;
 const MaxValueW32 WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32C;
 const MinValueW16 WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16C;
 const MinValueW32 WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+const CrossCorrelation WebRtcSpl_CrossCorrelation =
+    WebRtcSpl_CrossCorrelationSSE2;
+#else
 const CrossCorrelation WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
+#endif
 const DownsampleFast WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastC;
 const ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound =
     WebRtcSpl_ScaleAndAddVectorsWithRoundC;
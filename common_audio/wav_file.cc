@@ -11,6 +11,7 @@
 #include "common_audio/wav_file.h"
 
 #include <errno.h>
+#include <string.h>
 
 #include <algorithm>
 #include <array>
@@ -22,6 +23,13 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/system/arch.h"
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace webrtc {
 namespace {
 
@@ -61,120 +69,225 @@ class WavHeaderFileReader : public WavHeaderReader {
   int64_t pos_ = 0;
 };
 
+// Reads the header of a memory mapped file.
+class WavHeaderBufferReader : public WavHeaderReader {
+ public:
+  explicit WavHeaderBufferReader(rtc::ArrayView<const uint8_t> buffer)
+      : buffer_(buffer) {}
+
+  WavHeaderBufferReader(const WavHeaderBufferReader&) = delete;
+  WavHeaderBufferReader& operator=(const WavHeaderBufferReader&) = delete;
+
+  size_t Read(void* buf, size_t num_bytes) override {
+    const size_t count = std::min(num_bytes, buffer_.size() - pos_);
+    memcpy(buf, buffer_.data() + pos_, count);
+    pos_ += count;
+    return count;
+  }
+  bool SeekForward(uint32_t num_bytes) override {
+    if (buffer_.size() - pos_ < num_bytes) {
+      return false;
+    }
+    pos_ += num_bytes;
+    return true;
+  }
+  int64_t GetPosition() override { return pos_; }
+
+ private:
+  const rtc::ArrayView<const uint8_t> buffer_;
+  size_t pos_ = 0;
+};
+
+#if defined(WEBRTC_POSIX)
+// Returns an empty view if the file can't be mapped.
+rtc::ArrayView<const uint8_t> MapFile(absl::string_view filename) {
+  const std::string filename_str(filename);
+  const int fd = open(filename_str.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return {};
+  }
+  struct stat file_stat;
+  void* mapped = MAP_FAILED;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    mapped = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return {};
+  }
+  madvise(mapped, file_stat.st_size, MADV_SEQUENTIAL);
+  return rtc::ArrayView<const uint8_t>(static_cast<const uint8_t*>(mapped),
+                                       file_stat.st_size);
+}
+#endif
+
 constexpr size_t kMaxChunksize = 4096;
 
+// WavWriter writes blocks of this many bytes, which is a multiple of the size
+// of both sample formats.
+constexpr size_t kWriteBufferSize = 64 * 1024;
+
 }  // namespace
 
-WavReader::WavReader(absl::string_view filename)
-    : WavReader(FileWrapper::OpenReadOnly(filename)) {}
+WavReader::WavReader(absl::string_view filename) {
+#if defined(WEBRTC_POSIX)
+  mapped_file_ = MapFile(filename);
+  if (!mapped_file_.empty()) {
+    WavHeaderBufferReader readable(mapped_file_);
+    ReadHeader(&readable);
+    size_t data_size = std::min(mapped_file_.size() - data_start_pos_,
+                                num_samples_in_file_ * bytes_per_sample_);
+    data_size -= data_size % bytes_per_sample_;
+    mapped_samples_ = mapped_file_.subview(data_start_pos_, data_size);
+    return;
+  }
+#endif
+  file_ = FileWrapper::OpenReadOnly(filename);
+  RTC_CHECK(file_.is_open())
+      << "Invalid file. Could not create file handle for wav file.";
+  WavHeaderFileReader readable(&file_);
+  ReadHeader(&readable);
+}
 
 WavReader::WavReader(FileWrapper file) : file_(std::move(file)) {
   RTC_CHECK(file_.is_open())
       << "Invalid file. Could not create file handle for wav file.";
 
   WavHeaderFileReader readable(&file_);
-  size_t bytes_per_sample;
-  RTC_CHECK(ReadWavHeader(&readable, &num_channels_, &sample_rate_, &format_,
-                          &bytes_per_sample, &num_samples_in_file_,
+  ReadHeader(&readable);
+}
+
+void WavReader::ReadHeader(WavHeaderReader* readable) {
+  RTC_CHECK(ReadWavHeader(readable, &num_channels_, &sample_rate_, &format_,
+                          &bytes_per_sample_, &num_samples_in_file_,
                           &data_start_pos_));
   num_unread_samples_ = num_samples_in_file_;
   RTC_CHECK(FormatSupported(format_)) << "Non-implemented wav-format";
 }
 
 void WavReader::Reset() {
-  RTC_CHECK(file_.SeekTo(data_start_pos_))
-      << "Failed to set position in the file to WAV data start position";
+  if (mapped_file_.empty()) {
+    RTC_CHECK(file_.SeekTo(data_start_pos_))
+        << "Failed to set position in the file to WAV data start position";
+  }
   num_unread_samples_ = num_samples_in_file_;
 }
 
-size_t WavReader::ReadSamples(const size_t num_samples,
-                              int16_t* const samples) {
+size_t WavReader::ReadRawSamples(size_t num_samples, void* samples) {
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
 #error "Need to convert samples to big-endian when reading from WAV file"
 #endif
 
-  size_t num_samples_left_to_read = num_samples;
-  size_t next_chunk_start = 0;
-  while (num_samples_left_to_read > 0 && num_unread_samples_ > 0) {
-    const size_t chunk_size = std::min(
-        std::min(kMaxChunksize, num_samples_left_to_read), num_unread_samples_);
-    size_t num_bytes_read;
-    size_t num_samples_read;
+  RTC_DCHECK_LE(num_samples, num_unread_samples_);
+  if (!mapped_file_.empty()) {
+    const size_t position = num_samples_in_file_ - num_unread_samples_;
+    const size_t num_samples_read = std::min(
+        num_samples, mapped_samples_.size() / bytes_per_sample_ - position);
+    memcpy(samples, mapped_samples_.data() + position * bytes_per_sample_,
+           num_samples_read * bytes_per_sample_);
+    num_unread_samples_ -= num_samples_read;
+    return num_samples_read;
+  }
+
+  const size_t num_bytes_read =
+      file_.Read(samples, num_samples * bytes_per_sample_);
+  const size_t num_samples_read = num_bytes_read / bytes_per_sample_;
+  RTC_CHECK(num_samples_read == 0 || (num_bytes_read % num_samples_read) == 0)
+      << "Corrupt file: file ended in the middle of a sample.";
+  RTC_CHECK(num_samples_read == num_samples || file_.ReadEof())
+      << "Corrupt file: payload size does not match header.";
+  num_unread_samples_ -= num_samples_read;
+  return num_samples_read;
+}
+
+size_t WavReader::ReadSamples(const size_t num_samples,
+                              int16_t* const samples) {
+  size_t num_samples_read = 0;
+  while (num_samples_read < num_samples && num_unread_samples_ > 0) {
+    const size_t chunk_size =
+        std::min(std::min(kMaxChunksize, num_samples - num_samples_read),
+                 num_unread_samples_);
+    size_t chunk_samples_read;
     if (format_ == WavFormat::kWavFormatIeeeFloat) {
       std::array<float, kMaxChunksize> samples_to_convert;
-      num_bytes_read = file_.Read(samples_to_convert.data(),
-                                  chunk_size * sizeof(samples_to_convert[0]));
-      num_samples_read = num_bytes_read / sizeof(samples_to_convert[0]);
-
-      for (size_t j = 0; j < num_samples_read; ++j) {
-        samples[next_chunk_start + j] = FloatToS16(samples_to_convert[j]);
-      }
+      chunk_samples_read =
+          ReadRawSamples(chunk_size, samples_to_convert.data());
+      FloatToS16(samples_to_convert.data(), chunk_samples_read,
+                 &samples[num_samples_read]);
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatPcm);
-      num_bytes_read = file_.Read(&samples[next_chunk_start],
-                                  chunk_size * sizeof(samples[0]));
-      num_samples_read = num_bytes_read / sizeof(samples[0]);
+      chunk_samples_read =
+          ReadRawSamples(chunk_size, &samples[num_samples_read]);
+    }
+    num_samples_read += chunk_samples_read;
+    if (chunk_samples_read < chunk_size) {
+      // End of a truncated file.
+      break;
     }
-    RTC_CHECK(num_samples_read == 0 || (num_bytes_read % num_samples_read) == 0)
-        << "Corrupt file: file ended in the middle of a sample.";
-    RTC_CHECK(num_samples_read == chunk_size || file_.ReadEof())
-        << "Corrupt file: payload size does not match header.";
-
-    next_chunk_start += num_samples_read;
-    num_unread_samples_ -= num_samples_read;
-    num_samples_left_to_read -= num_samples_read;
   }
-
-  return num_samples - num_samples_left_to_read;
+  return num_samples_read;
 }
 
 size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
-#ifndef WEBRTC_ARCH_LITTLE_ENDIAN
-#error "Need to convert samples to big-endian when reading from WAV file"
-#endif
-
-  size_t num_samples_left_to_read = num_samples;
-  size_t next_chunk_start = 0;
-  while (num_samples_left_to_read > 0 && num_unread_samples_ > 0) {
-    const size_t chunk_size = std::min(
-        std::min(kMaxChunksize, num_samples_left_to_read), num_unread_samples_);
-    size_t num_bytes_read;
-    size_t num_samples_read;
+  size_t num_samples_read = 0;
+  while (num_samples_read < num_samples && num_unread_samples_ > 0) {
+    const size_t chunk_size =
+        std::min(std::min(kMaxChunksize, num_samples - num_samples_read),
+                 num_unread_samples_);
+    size_t chunk_samples_read;
     if (format_ == WavFormat::kWavFormatPcm) {
-      std::array<int16_t, kMaxChunksize> samples_to_convert;
-      num_bytes_read = file_.Read(samples_to_convert.data(),
-                                  chunk_size * sizeof(samples_to_convert[0]));
-      num_samples_read = num_bytes_read / sizeof(samples_to_convert[0]);
-
-      for (size_t j = 0; j < num_samples_read; ++j) {
-        samples[next_chunk_start + j] =
-            static_cast<float>(samples_to_convert[j]);
+      if (CanReadSampleView()) {
+        rtc::ArrayView<const int16_t> view = ReadSampleView(chunk_size);
+        chunk_samples_read = view.size();
+        S16ToFloatS16(view.data(), view.size(), &samples[num_samples_read]);
+      } else {
+        std::array<int16_t, kMaxChunksize> samples_to_convert;
+        chunk_samples_read =
+            ReadRawSamples(chunk_size, samples_to_convert.data());
+        S16ToFloatS16(samples_to_convert.data(), chunk_samples_read,
+                      &samples[num_samples_read]);
       }
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
-      num_bytes_read = file_.Read(&samples[next_chunk_start],
-                                  chunk_size * sizeof(samples[0]));
-      num_samples_read = num_bytes_read / sizeof(samples[0]);
-
-      for (size_t j = 0; j < num_samples_read; ++j) {
-        samples[next_chunk_start + j] =
-            FloatToFloatS16(samples[next_chunk_start + j]);
-      }
+      chunk_samples_read =
+          ReadRawSamples(chunk_size, &samples[num_samples_read]);
+      FloatToFloatS16(&samples[num_samples_read], chunk_samples_read,
+                      &samples[num_samples_read]);
+    }
+    num_samples_read += chunk_samples_read;
+    if (chunk_samples_read < chunk_size) {
+      // End of a truncated file.
+      break;
     }
-    RTC_CHECK(num_samples_read == 0 || (num_bytes_read % num_samples_read) == 0)
-        << "Corrupt file: file ended in the middle of a sample.";
-    RTC_CHECK(num_samples_read == chunk_size || file_.ReadEof())
-        << "Corrupt file: payload size does not match header.";
-
-    next_chunk_start += num_samples_read;
-    num_unread_samples_ -= num_samples_read;
-    num_samples_left_to_read -= num_samples_read;
   }
+  return num_samples_read;
+}
 
-  return num_samples - num_samples_left_to_read;
+bool WavReader::CanReadSampleView() const {
+  return !mapped_file_.empty() && format_ == WavFormat::kWavFormatPcm &&
+         data_start_pos_ % alignof(int16_t) == 0;
+}
+
+rtc::ArrayView<const int16_t> WavReader::ReadSampleView(size_t num_samples) {
+  RTC_CHECK(CanReadSampleView());
+  const size_t position = num_samples_in_file_ - num_unread_samples_;
+  const size_t num_samples_read =
+      std::min(std::min(num_samples, num_unread_samples_),
+               mapped_samples_.size() / sizeof(int16_t) - position);
+  num_unread_samples_ -= num_samples_read;
+  return rtc::ArrayView<const int16_t>(
+      reinterpret_cast<const int16_t*>(mapped_samples_.data()) + position,
+      num_samples_read);
 }
 
 void WavReader::Close() {
+#if defined(WEBRTC_POSIX)
+  if (!mapped_file_.empty()) {
+    munmap(const_cast<uint8_t*>(mapped_file_.data()), mapped_file_.size());
+    mapped_file_ = rtc::ArrayView<const uint8_t>();
+    mapped_samples_ = rtc::ArrayView<const uint8_t>();
+  }
+#endif
   file_.Close();
 }
 
@@ -199,7 +312,8 @@ WavWriter::WavWriter(FileWrapper file,
       format_(sample_format == SampleFormat::kInt16
                   ? WavFormat::kWavFormatPcm
                   : WavFormat::kWavFormatIeeeFloat),
-      file_(std::move(file)) {
+      file_(std::move(file)),
+      buffer_(kWriteBufferSize) {
   // Handle errors from the OpenWriteOnly call in above constructor.
   RTC_CHECK(file_.is_open()) << "Invalid file. Could not create wav file.";
 
@@ -212,34 +326,46 @@ WavWriter::WavWriter(FileWrapper file,
   RTC_CHECK(file_.Write(blank_header, WavHeaderSize(format_)));
 }
 
+template <typename T>
+rtc::ArrayView<T> WavWriter::GetBufferSpace(size_t num_samples) {
+  if (buffer_size_ == buffer_.size()) {
+    Flush();
+  }
+  const size_t num_samples_to_write =
+      std::min(num_samples, (buffer_.size() - buffer_size_) / sizeof(T));
+  rtc::ArrayView<T> space(reinterpret_cast<T*>(&buffer_[buffer_size_]),
+                          num_samples_to_write);
+  buffer_size_ += num_samples_to_write * sizeof(T);
+  return space;
+}
+
+void WavWriter::Flush() {
+  if (buffer_size_ > 0) {
+    RTC_CHECK(file_.Write(buffer_.data(), buffer_size_));
+    buffer_size_ = 0;
+  }
+}
+
 void WavWriter::WriteSamples(const int16_t* samples, size_t num_samples) {
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
 #error "Need to convert samples to little-endian when writing to WAV file"
 #endif
 
-  for (size_t i = 0; i < num_samples; i += kMaxChunksize) {
-    const size_t num_remaining_samples = num_samples - i;
-    const size_t num_samples_to_write =
-        std::min(kMaxChunksize, num_remaining_samples);
-
+  for (size_t i = 0; i < num_samples;) {
     if (format_ == WavFormat::kWavFormatPcm) {
-      RTC_CHECK(
-          file_.Write(&samples[i], num_samples_to_write * sizeof(samples[0])));
+      rtc::ArrayView<int16_t> space = GetBufferSpace<int16_t>(num_samples - i);
+      std::copy(&samples[i], &samples[i] + space.size(), space.begin());
+      i += space.size();
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
-      std::array<float, kMaxChunksize> converted_samples;
-      for (size_t j = 0; j < num_samples_to_write; ++j) {
-        converted_samples[j] = S16ToFloat(samples[i + j]);
-      }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      rtc::ArrayView<float> space = GetBufferSpace<float>(num_samples - i);
+      S16ToFloat(&samples[i], space.size(), space.data());
+      i += space.size();
     }
-
-    num_samples_written_ += num_samples_to_write;
-    RTC_CHECK_GE(num_samples_written_,
-                 num_samples_to_write);  // detect size_t overflow
   }
+
+  num_samples_written_ += num_samples;
+  RTC_CHECK_GE(num_samples_written_, num_samples);  // detect size_t overflow
 }
 
 void WavWriter::WriteSamples(const float* samples, size_t num_samples) {
@@ -247,37 +373,25 @@ void WavWriter::WriteSamples(const float* samples, size_t num_samples) {
 #error "Need to convert samples to little-endian when writing to WAV file"
 #endif
 
-  for (size_t i = 0; i < num_samples; i += kMaxChunksize) {
-    const size_t num_remaining_samples = num_samples - i;
-    const size_t num_samples_to_write =
-        std::min(kMaxChunksize, num_remaining_samples);
-
+  for (size_t i = 0; i < num_samples;) {
     if (format_ == WavFormat::kWavFormatPcm) {
-      std::array<int16_t, kMaxChunksize> converted_samples;
-      for (size_t j = 0; j < num_samples_to_write; ++j) {
-        converted_samples[j] = FloatS16ToS16(samples[i + j]);
-      }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      rtc::ArrayView<int16_t> space = GetBufferSpace<int16_t>(num_samples - i);
+      FloatS16ToS16(&samples[i], space.size(), space.data());
+      i += space.size();
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
-      std::array<float, kMaxChunksize> converted_samples;
-      for (size_t j = 0; j < num_samples_to_write; ++j) {
-        converted_samples[j] = FloatS16ToFloat(samples[i + j]);
-      }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      rtc::ArrayView<float> space = GetBufferSpace<float>(num_samples - i);
+      FloatS16ToFloat(&samples[i], space.size(), space.data());
+      i += space.size();
     }
-
-    num_samples_written_ += num_samples_to_write;
-    RTC_CHECK(num_samples_written_ >=
-              num_samples_to_write);  // detect size_t overflow
   }
+
+  num_samples_written_ += num_samples;
+  RTC_CHECK_GE(num_samples_written_, num_samples);  // detect size_t overflow
 }
 
 void WavWriter::Close() {
+  Flush();
   RTC_CHECK(file_.Rewind());
   std::array<uint8_t, MaxWavHeaderSize()> header;
   size_t header_size;
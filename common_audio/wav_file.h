@@ -15,7 +15,9 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
+#include "api/array_view.h"
 #include "common_audio/wav_header.h"
 #include "rtc_base/system/file_wrapper.h"
 
@@ -65,15 +67,25 @@ class WavWriter final : public WavFile {
   size_t num_samples() const override { return num_samples_written_; }
 
  private:
+  // Reserves room for up to `num_samples` samples in `buffer_`, flushing it to
+  // the file first if it's full, and returns it.
+  template <typename T>
+  rtc::ArrayView<T> GetBufferSpace(size_t num_samples);
+  void Flush();
   void Close();
   const int sample_rate_;
   const size_t num_channels_;
   size_t num_samples_written_;
   WavFormat format_;
   FileWrapper file_;
+  // The samples are collected here and written to the file in large blocks.
+  std::vector<uint8_t> buffer_;
+  size_t buffer_size_ = 0;
 };
 
-// Follows the conventions of WavWriter.
+// Follows the conventions of WavWriter. When opened by name, the file is
+// memory mapped if possible, which avoids reading it in small chunks and lets
+// 16-bit PCM samples be accessed without copying them.
 class WavReader final : public WavFile {
  public:
   // Opens an existing WAV file for reading.
@@ -94,20 +106,37 @@ class WavReader final : public WavFile {
   size_t ReadSamples(size_t num_samples, float* samples);
   size_t ReadSamples(size_t num_samples, int16_t* samples);
 
+  // Whether ReadSampleView() can be used, which is the case for memory mapped
+  // 16-bit PCM files.
+  bool CanReadSampleView() const;
+  // Like ReadSamples(), but returns a view of the samples in the mapped file
+  // instead of copying them. The view is valid until the reader is destroyed.
+  rtc::ArrayView<const int16_t> ReadSampleView(size_t num_samples);
+
   int sample_rate() const override { return sample_rate_; }
   size_t num_channels() const override { return num_channels_; }
   size_t num_samples() const override { return num_samples_in_file_; }
 
  private:
+  // Reads up to `num_samples` samples of the file format into `samples`, and
+  // returns how many were read.
+  size_t ReadRawSamples(size_t num_samples, void* samples);
+  void ReadHeader(WavHeaderReader* readable);
   void Close();
   int sample_rate_;
   size_t num_channels_;
   WavFormat format_;
+  size_t bytes_per_sample_;
   size_t num_samples_in_file_;
   size_t num_unread_samples_;
   FileWrapper file_;
   int64_t
       data_start_pos_;  // Position in the file immediately after WAV header.
+  // The whole file, if it is memory mapped.
+  rtc::ArrayView<const uint8_t> mapped_file_;
+  // The samples of `mapped_file_`, which may be fewer than the header says if
+  // the file is truncated.
+  rtc::ArrayView<const uint8_t> mapped_samples_;
 };
 
 }  // namespace webrtc
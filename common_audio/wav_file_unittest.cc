@@ -15,6 +15,7 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "common_audio/wav_header.h"
 #include "test/gtest.h"
@@ -248,4 +249,69 @@ TEST(WavReaderTest, MAYBE_CPPReset) {
   }
 }
 
+// Reads 16-bit samples from a mapped file without copying them.
+TEST(WavReaderTest, ReadsSampleViews) {
+  const std::string outfile = test::OutputPath() + "wavtest5.wav";
+  std::vector<int16_t> samples(10000);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = static_cast<int16_t>(i * 7);
+  }
+  {
+    WavWriter w(outfile, 16000, 2);
+    w.WriteSamples(samples.data(), samples.size());
+  }
+
+  WavReader r(outfile);
+#if defined(WEBRTC_POSIX)
+  ASSERT_TRUE(r.CanReadSampleView());
+  rtc::ArrayView<const int16_t> view = r.ReadSampleView(9000);
+  ASSERT_EQ(9000u, view.size());
+  EXPECT_EQ(0, memcmp(samples.data(), view.data(), 9000 * sizeof(int16_t)));
+  view = r.ReadSampleView(9000);
+  ASSERT_EQ(1000u, view.size());
+  EXPECT_EQ(samples[9000], view[0]);
+  EXPECT_TRUE(r.ReadSampleView(1).empty());
+  r.Reset();
+#endif
+  std::vector<float> read_samples(samples.size());
+  EXPECT_EQ(samples.size(),
+            r.ReadSamples(read_samples.size(), read_samples.data()));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_EQ(samples[i], read_samples[i]);
+  }
+
+  WavReader file_reader(FileWrapper::OpenReadOnly(outfile));
+  EXPECT_FALSE(file_reader.CanReadSampleView());
+}
+
+// Reads the samples that are present in a truncated file, whether mapped or
+// not.
+TEST(WavReaderTest, ReadsTruncatedFile) {
+  const std::string outfile = test::OutputPath() + "wavtest6.wav";
+  const std::string truncated_file = test::OutputPath() + "wavtest7.wav";
+  constexpr size_t kNumSamples = 5000;
+  {
+    WavWriter w(outfile, 16000, 1, WavFile::SampleFormat::kFloat);
+    std::vector<float> samples(kNumSamples, 1000.f);
+    w.WriteSamples(samples.data(), samples.size());
+  }
+  {
+    FileWrapper in = FileWrapper::OpenReadOnly(outfile);
+    std::vector<uint8_t> contents(in.FileSize());
+    ASSERT_EQ(contents.size(), in.Read(contents.data(), contents.size()));
+    // Drop the last two samples.
+    contents.resize(contents.size() - 2 * sizeof(float));
+    FileWrapper out = FileWrapper::OpenWriteOnly(truncated_file);
+    ASSERT_TRUE(out.Write(contents.data(), contents.size()));
+  }
+
+  WavReader r(truncated_file);
+  EXPECT_EQ(kNumSamples, r.num_samples());
+  std::vector<int16_t> read_samples(kNumSamples);
+  EXPECT_EQ(kNumSamples - 2,
+            r.ReadSamples(read_samples.size(), read_samples.data()));
+  EXPECT_EQ(1000, read_samples[kNumSamples - 3]);
+  EXPECT_EQ(0u, r.ReadSamples(read_samples.size(), read_samples.data()));
+}
+
 }  // namespace webrtc
@@ -0,0 +1,337 @@
+/*
+ *  Copyright (c) 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_RELAY_FACTORY_POOL_H_
+#define EXAMPLES_RELAY_FACTORY_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/call/call_factory_interface.h"
+#include "api/media_stream_interface.h"
+#include "api/peer_connection_interface.h"
+#include "api/rtc_event_log/rtc_event_log_factory.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "media/base/video_broadcaster.h"
+#include "media/engine/webrtc_media_engine.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "pc/video_track_source.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/thread.h"
+
+namespace receiver {
+
+// One PeerConnectionFactory and the thread that runs both its network and
+// worker duties. PeerConnections created from the same shard never hop threads
+// on the media path; PeerConnections on different shards only meet through the
+// relay sources below.
+class factory_shard {
+ public:
+  factory_shard(std::size_t index,
+                rtc::Thread* signal_thread,
+                rtc::scoped_refptr<webrtc::AudioEncoderFactory> audio_encoders,
+                rtc::scoped_refptr<webrtc::AudioDecoderFactory> audio_decoders)
+      : index{index},
+        signal_thread{signal_thread},
+        media_thread{rtc::Thread::CreateWithSocketServer()},
+        factory{},
+        peer_count{} {
+    media_thread->SetName("relay_media_" + std::to_string(index), nullptr);
+    media_thread->Start();
+
+    // The same thread is passed as both network and worker thread, which
+    // turns every network <-> worker hop into a direct call.
+    webrtc::PeerConnectionFactoryDependencies dependencies;
+    dependencies.network_thread = media_thread.get();
+    dependencies.worker_thread = media_thread.get();
+    dependencies.signaling_thread = signal_thread;
+    dependencies.socket_factory = media_thread->socketserver();
+    // Peers joining at the same time would otherwise each resolve the STUN and
+    // TURN servers themselves.
+    dependencies.dns_cache_ttl = webrtc::TimeDelta::Minutes(5);
+    dependencies.task_queue_factory = webrtc::CreateDefaultTaskQueueFactory();
+    dependencies.call_factory = webrtc::CreateCallFactory();
+    dependencies.event_log_factory =
+        std::make_unique<webrtc::RtcEventLogFactory>(
+            dependencies.task_queue_factory.get());
+
+    cricket::MediaEngineDependencies media_dependencies;
+    media_dependencies.task_queue_factory =
+        dependencies.task_queue_factory.get();
+    // No ADM is passed, as with the default_adm of
+    // CreatePeerConnectionFactory(), so each shard's voice engine creates the
+    // platform ADM on its own worker thread.
+    media_dependencies.adm = nullptr;
+    media_dependencies.audio_encoder_factory = audio_encoders;
+    media_dependencies.audio_decoder_factory = audio_decoders;
+    media_dependencies.audio_processing =
+        webrtc::AudioProcessingBuilder().Create();
+    media_dependencies.video_encoder_factory =
+        webrtc::CreateBuiltinVideoEncoderFactory();
+    media_dependencies.video_decoder_factory =
+        webrtc::CreateBuiltinVideoDecoderFactory();
+    dependencies.media_engine =
+        cricket::CreateMediaEngine(std::move(media_dependencies));
+
+    factory =
+        webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
+
+    if (!factory)
+      throw std::runtime_error{"Failed to create PeerConnectionFactory"};
+  }
+
+  ~factory_shard() {
+    // The factory must be released before the thread it runs on.
+    factory = nullptr;
+  }
+
+  auto operator->() { return factory.operator->(); }
+
+  const std::size_t index;
+  rtc::Thread* const signal_thread;
+
+ private:
+  friend class factory_pool;
+
+  std::unique_ptr<rtc::Thread> media_thread;
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+
+  // Guarded by factory_pool::placement_lock.
+  std::size_t peer_count;
+};
+
+// A fixed set of factory shards, one per core by default, sharing a signaling
+// thread, the audio codec factories and a DTLS certificate. Video codec
+// factories are owned per factory and so are created per shard. The audio
+// device module is left to each factory, since it is bound to the worker
+// thread it was created on.
+class factory_pool {
+ public:
+  explicit factory_pool(std::size_t shard_count = default_shard_count())
+      : signal_thread{rtc::Thread::CreateWithSocketServer()},
+        certificate{},
+        placement_lock{},
+        shards{},
+        next_shard{} {
+    signal_thread->Start();
+
+    const auto audio_encoders = webrtc::CreateBuiltinAudioEncoderFactory();
+    const auto audio_decoders = webrtc::CreateBuiltinAudioDecoderFactory();
+    for (std::size_t i{}; i < shard_count; ++i) {
+      shards.emplace_back(std::make_unique<factory_shard>(
+          i, signal_thread.get(), audio_encoders, audio_decoders));
+    }
+
+    // Generating a certificate is by far the most expensive part of creating a
+    // PeerConnection; do it once and hand the same one to every connection.
+    certificate = rtc::RTCCertificateGenerator::GenerateCertificate(
+        rtc::KeyParams::ECDSA(), absl::nullopt);
+
+    if (!certificate)
+      throw std::runtime_error{"Failed to generate DTLS certificate"};
+  }
+
+  ~factory_pool() {
+    // Shards share the signaling thread, so they must go first.
+    shards.clear();
+  }
+
+  static std::size_t default_shard_count() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Placement policy: the least loaded shard wins, ties are broken round-robin
+  // so that an idle pool fills evenly. Every call must be paired with a call to
+  // release() once the PeerConnection is closed.
+  factory_shard& place() {
+    std::lock_guard guard{placement_lock};
+    auto* best = shards[next_shard].get();
+    for (std::size_t i{1}; i < shards.size(); ++i) {
+      auto* candidate = shards[(next_shard + i) % shards.size()].get();
+      if (candidate->peer_count < best->peer_count)
+        best = candidate;
+    }
+
+    next_shard = (best->index + 1) % shards.size();
+    ++best->peer_count;
+    return *best;
+  }
+
+  void release(factory_shard& shard) {
+    std::lock_guard guard{placement_lock};
+    --shard.peer_count;
+  }
+
+  // Applies the settings shared by every PeerConnection in the pool.
+  void configure(webrtc::PeerConnectionInterface::RTCConfiguration& config) {
+    config.certificates = {certificate};
+    // Peers of a shard receiving the same track share its audio encoders,
+    // see relay_audio_source.
+    config.set_shared_audio_encoder_bitrates_bps({16000, 32000});
+  }
+
+  rtc::Thread* signaling_thread() { return signal_thread.get(); }
+
+ private:
+  std::unique_ptr<rtc::Thread> signal_thread;
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate;
+
+  std::mutex placement_lock;
+  std::vector<std::unique_ptr<factory_shard>> shards;
+  std::size_t next_shard;
+};
+
+// Video source that re-publishes the frames of a track owned by another shard.
+// Frames are delivered on the upstream shard's thread and handed straight to
+// the downstream encoders, which queue them on their own task queues. The
+// wants of the downstream sinks are aggregated by the broadcaster and
+// forwarded upstream, so that the upstream source adapts to them.
+class relay_video_source : public webrtc::VideoTrackSource {
+ public:
+  relay_video_source(rtc::scoped_refptr<webrtc::VideoTrackInterface> upstream,
+                     rtc::Thread* signal_thread)
+      : webrtc::VideoTrackSource{/*remote=*/false},
+        upstream{upstream},
+        signal_thread{signal_thread},
+        broadcaster{} {
+    upstream->AddOrUpdateSink(&broadcaster, broadcaster.wants());
+    SetState(kLive);
+  }
+
+  ~relay_video_source() override { upstream->RemoveSink(&broadcaster); }
+
+  void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+                       const rtc::VideoSinkWants& wants) override {
+    webrtc::VideoTrackSource::AddOrUpdateSink(sink, wants);
+    forward_wants();
+  }
+
+  void RemoveSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override {
+    webrtc::VideoTrackSource::RemoveSink(sink);
+    forward_wants();
+  }
+
+ protected:
+  rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
+    return &broadcaster;
+  }
+
+ private:
+  // Sinks are updated on this shard's worker thread, while the upstream track
+  // lives on another shard. Going through the signaling thread, which is
+  // allowed to block on any shard, keeps two shards from blocking on each
+  // other.
+  void forward_wants() {
+    signal_thread->PostTask(
+        [self = rtc::scoped_refptr<relay_video_source>(this)] {
+          self->upstream->AddOrUpdateSink(&self->broadcaster,
+                                          self->broadcaster.wants());
+        });
+  }
+
+  rtc::scoped_refptr<webrtc::VideoTrackInterface> upstream;
+  rtc::Thread* const signal_thread;
+  rtc::VideoBroadcaster broadcaster;
+};
+
+// Audio counterpart of relay_video_source. All relay sources of the same
+// upstream track use the same shared encoder group, so that the peers of a
+// shard forwarding that track encode it once per bitrate.
+class relay_audio_source
+    : public webrtc::Notifier<webrtc::AudioSourceInterface>,
+      public webrtc::AudioTrackSinkInterface {
+ public:
+  explicit relay_audio_source(
+      rtc::scoped_refptr<webrtc::AudioTrackInterface> upstream)
+      : upstream{upstream}, audio_options{}, sink_lock{}, sinks{} {
+    audio_options.shared_encoder_group = std::to_string(
+        reinterpret_cast<std::uintptr_t>(upstream.get()));
+    upstream->AddSink(this);
+  }
+
+  ~relay_audio_source() override { upstream->RemoveSink(this); }
+
+  SourceState state() const override { return kLive; }
+  bool remote() const override { return false; }
+  const cricket::AudioOptions options() const override {
+    return audio_options;
+  }
+
+  void AddSink(webrtc::AudioTrackSinkInterface* sink) override {
+    std::lock_guard guard{sink_lock};
+    sinks.insert(sink);
+  }
+
+  void RemoveSink(webrtc::AudioTrackSinkInterface* sink) override {
+    std::lock_guard guard{sink_lock};
+    sinks.erase(sink);
+  }
+
+  void OnData(const void* audio_data,
+              int bits_per_sample,
+              int sample_rate,
+              size_t number_of_channels,
+              size_t number_of_frames,
+              absl::optional<int64_t> absolute_capture_timestamp_ms) override {
+    std::lock_guard guard{sink_lock};
+    for (auto sink : sinks) {
+      sink->OnData(audio_data, bits_per_sample, sample_rate, number_of_channels,
+                   number_of_frames, absolute_capture_timestamp_ms);
+    }
+  }
+
+ private:
+  rtc::scoped_refptr<webrtc::AudioTrackInterface> upstream;
+  cricket::AudioOptions audio_options;
+
+  std::mutex sink_lock;
+  std::set<webrtc::AudioTrackSinkInterface*> sinks;
+};
+
+// Returns a track that can be added to a PeerConnection created by `shard`.
+// Video tracks from the same shard are used as-is; other video tracks and all
+// audio tracks are wrapped in a relay source owned by `shard`.
+inline rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> import_track(
+    factory_shard& shard,
+    const factory_shard& owner,
+    rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track) {
+  if (track->kind() == webrtc::MediaStreamTrackInterface::kVideoKind) {
+    if (&shard == &owner)
+      return track;
+    const auto source = rtc::make_ref_counted<relay_video_source>(
+        rtc::scoped_refptr<webrtc::VideoTrackInterface>(
+            static_cast<webrtc::VideoTrackInterface*>(track.get())),
+        shard.signal_thread);
+    return shard->CreateVideoTrack(track->id(), source.get());
+  }
+
+  const auto source = rtc::make_ref_counted<relay_audio_source>(
+      rtc::scoped_refptr<webrtc::AudioTrackInterface>(
+          static_cast<webrtc::AudioTrackInterface*>(track.get())));
+  return shard->CreateAudioTrack(track->id(), source.get());
+}
+
+}  // namespace receiver
+
+#endif  // EXAMPLES_RELAY_FACTORY_POOL_H_
@@ -18,6 +18,7 @@
 #include "api/jsep.h"
 #include "api/video_codecs/builtin_video_decoder_factory.h"
 #include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "examples/relay/factory_pool.h"
 #include "websocketpp/config/asio_no_tls.hpp"
 #include "websocketpp/server.hpp"
 
@@ -59,27 +60,6 @@ void log(level severity, types&&... args) {
   log_to(log_file, severity, std::forward<types>(args)...);
 }
 
-struct webrtc_factory {
-  std::unique_ptr<rtc::Thread> signal_thread;
-  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory{};
-
-  webrtc_factory()
-      : signal_thread{rtc::Thread::CreateWithSocketServer()}, factory{} {
-    signal_thread->Start();
-    factory = webrtc::CreatePeerConnectionFactory(
-        nullptr, nullptr, signal_thread.get(), nullptr,
-        webrtc::CreateBuiltinAudioEncoderFactory(),
-        webrtc::CreateBuiltinAudioDecoderFactory(),
-        webrtc::CreateBuiltinVideoEncoderFactory(),
-        webrtc::CreateBuiltinVideoDecoderFactory(), nullptr, nullptr);
-
-    if (!factory)
-      throw std::runtime_error{"Failed to create PeerConnectionFactory"};
-  }
-
-  auto operator->() { return factory.operator->(); }
-};
-
 template <typename derived>
 class socket_server {
  public:
@@ -134,7 +114,8 @@ class socket_server {
 };
 
 using track_callback =
-    std::function<void(rtc::scoped_refptr<webrtc::RtpTransceiverInterface>)>;
+    std::function<void(rtc::scoped_refptr<webrtc::RtpTransceiverInterface>,
+                       const factory_shard&)>;
 
 class local_desc_observer
     : public webrtc::SetLocalDescriptionObserverInterface {
@@ -212,10 +193,11 @@ class remote_desc_observer
 // TODO: implement renegotiation so the source can be switched out?
 class webrtc_observer : public webrtc::PeerConnectionObserver {
  public:
-  webrtc_observer(webrtc_factory& factory,
+  webrtc_observer(factory_pool& pool,
                   server_type::connection_ptr signal_socket,
                   track_callback on_track)
-      : factory{factory},
+      : pool{pool},
+        factory{pool.place()},
         peer{},
         signal_socket{signal_socket},
         on_track{on_track},
@@ -228,7 +210,10 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
                server_type::message_ptr message) { on_message(hdl, message); });
   }
 
-  ~webrtc_observer() { close(); }
+  ~webrtc_observer() {
+    close();
+    pool.release(factory);
+  }
 
   template <typename... types>
   static auto make(types&&... args) {
@@ -236,7 +221,8 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
   }
 
   void switch_track(
-      rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver) {
+      rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver,
+      const factory_shard& owner) {
     if (current_sender) {
       log(level::info, "removing existing track sender");
       const auto maybe_removed = peer->RemoveTrackOrError(current_sender);
@@ -248,7 +234,10 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
       }
     }
 
-    const auto real_track = transceiver->receiver()->track();
+    // The track may belong to another shard, in which case it is re-published
+    // through a relay source on ours.
+    const auto real_track =
+        import_track(factory, owner, transceiver->receiver()->track());
     const auto sender = peer->AddTrack(real_track, {"mirrored_stream"});
     if (!sender.ok())
       log(level::error, "failed to add track:", sender.error().message());
@@ -259,7 +248,8 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
  private:
   static constexpr auto polite = false;
 
-  webrtc_factory& factory;
+  factory_pool& pool;
+  factory_shard& factory;
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer;
   server_type::connection_ptr signal_socket;
   track_callback on_track;
@@ -282,6 +272,7 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
     turner.username = "user";
     turner.password = "root";
     config.servers.emplace_back(std::move(turner));
+    host->pool.configure(config);
 
     const auto maybe_pc = host->factory->CreatePeerConnectionOrError(
         config, webrtc::PeerConnectionDependencies{host});
@@ -437,7 +428,7 @@ class webrtc_observer : public webrtc::PeerConnectionObserver {
 
   void OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
       override {
-    on_track(transceiver);
+    on_track(transceiver, factory);
   }
 };
 
@@ -446,12 +437,13 @@ using peer_ptr =
 
 class sink_server : public socket_server<sink_server> {
  public:
-  sink_server(webrtc_factory& factory)
+  sink_server(factory_pool& factory)
       : socket_server{},
         factory{factory},
         connections{},
         track_lock{},
-        transceiver{} {}
+        transceiver{},
+        transceiver_owner{} {}
 
   template <typename... types>
   void on_open(websocketpp::connection_hdl hdl, types&&...) {
@@ -463,7 +455,7 @@ class sink_server : public socket_server<sink_server> {
           webrtc_observer::make(factory, new_connection, [](auto&&...) {});
 
       if (transceiver)
-        peer->switch_track(transceiver);
+        peer->switch_track(transceiver, *transceiver_owner);
 
       connections[new_connection] = peer;
     }
@@ -496,25 +488,28 @@ class sink_server : public socket_server<sink_server> {
   }
 
   void switch_source(
-      rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver) {
+      rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver,
+      const factory_shard& owner) {
     log(level::info, "switching sources");
     this->transceiver = transceiver;
+    transceiver_owner = &owner;
     // TODO: OnNegotiationNeeded?
     for (const auto& [conn, peer] : connections)
-      peer->switch_track(transceiver);
+      peer->switch_track(transceiver, owner);
   }
 
  private:
-  webrtc_factory& factory;
+  factory_pool& factory;
   std::map<decltype(server)::connection_ptr, peer_ptr> connections{};
 
   std::mutex track_lock{};
   rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver{};
+  const factory_shard* transceiver_owner{};
 };
 
 class source_server : public socket_server<source_server> {
  public:
-  source_server(webrtc_factory& factory, sink_server& sink)
+  source_server(factory_pool& factory, sink_server& sink)
       : socket_server{}, sink{sink}, connection{}, factory{factory}, peer{} {}
 
   template <typename... types>
@@ -528,9 +523,8 @@ class source_server : public socket_server<source_server> {
     connection = new_connection;
     peer = webrtc_observer::make(
         factory, connection,
-        [this](rtc::scoped_refptr<webrtc::RtpTransceiverInterface> track) {
-          on_track(track);
-        });
+        [this](rtc::scoped_refptr<webrtc::RtpTransceiverInterface> track,
+               const factory_shard& owner) { on_track(track, owner); });
   }
 
   void on_close(websocketpp::connection_hdl hdl) {
@@ -545,7 +539,8 @@ class source_server : public socket_server<source_server> {
   template <typename... types>
   void on_message(types&&...) {}
 
-  void on_track(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> track) {
+  void on_track(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> track,
+                const factory_shard& owner) {
     log(level::info, "track added",
         reinterpret_cast<std::uintptr_t>(track.get()));
 
@@ -553,7 +548,7 @@ class source_server : public socket_server<source_server> {
       log(level::info, "track enabled",
           reinterpret_cast<std::uintptr_t>(track.get()));
 
-    sink.switch_source(track);
+    sink.switch_source(track, owner);
   }
 
   void close_all() {
@@ -569,7 +564,7 @@ class source_server : public socket_server<source_server> {
  private:
   sink_server& sink;
   decltype(server)::connection_ptr connection;
-  webrtc_factory& factory;
+  factory_pool& factory;
   peer_ptr peer;
 };
 
@@ -590,9 +585,10 @@ class scoped_session {
 int main() {
   using namespace receiver;
 
-  // For reasons I genuinely cannot explain, it is *imperative* that all WebRTC
-  // objects in this process share the same factory and signal thread
-  webrtc_factory factory{};
+  // All WebRTC objects in this process share one signal thread, but media is
+  // spread over a pool of factories with one network/worker thread per core.
+  // Tracks that cross shards are re-published through relay sources.
+  factory_pool factory{};
   try {
     rtc::LogMessage::LogToDebug(rtc::LS_ERROR);
     sink_server sink{factory};
@@ -11,6 +11,8 @@
 #ifndef MEDIA_BASE_MEDIA_CONFIG_H_
 #define MEDIA_BASE_MEDIA_CONFIG_H_
 
+#include <vector>
+
 namespace cricket {
 
 // Construction-time settings, passed on when creating
@@ -68,6 +70,13 @@ struct MediaConfig {
   struct Audio {
     // Time interval between RTCP report for audio
     int rtcp_report_interval_ms = 5000;
+
+    // If not empty, send streams whose sources have the same
+    // AudioOptions::shared_encoder_group and the same codec configuration
+    // share one encoder per listed codec bitrate, instead of each encoding the
+    // audio on its own. Meant for sending a track to many peers, see
+    // webrtc::AudioSendStream::Config.
+    std::vector<int> shared_encoder_bitrates_bps;
   } audio;
 
   bool operator==(const MediaConfig& o) const {
@@ -82,7 +91,9 @@ struct MediaConfig {
            video.experiment_cpu_load_estimator ==
                o.video.experiment_cpu_load_estimator &&
            video.rtcp_report_interval_ms == o.video.rtcp_report_interval_ms &&
-           audio.rtcp_report_interval_ms == o.audio.rtcp_report_interval_ms;
+           audio.rtcp_report_interval_ms == o.audio.rtcp_report_interval_ms &&
+           audio.shared_encoder_bitrates_bps ==
+               o.audio.shared_encoder_bitrates_bps;
   }
 
   bool operator!=(const MediaConfig& o) const { return !(*this == o); }
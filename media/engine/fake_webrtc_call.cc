@@ -649,6 +649,15 @@ void FakeCall::DeliverRtpPacket(
   last_received_rtp_packet_ = packet;
 }
 
+void FakeCall::DeliverRtpPackets(
+    webrtc::MediaType media_type,
+    std::vector<webrtc::RtpPacketReceived> packets,
+    OnUndemuxablePacketHandler undemuxable_packet_handler) {
+  ++delivered_rtp_batches_;
+  webrtc::PacketReceiver::DeliverRtpPackets(
+      media_type, std::move(packets), std::move(undemuxable_packet_handler));
+}
+
 bool FakeCall::DeliverPacketInternal(webrtc::MediaType media_type,
                                      uint32_t ssrc,
                                      const rtc::CopyOnWriteBuffer& packet,
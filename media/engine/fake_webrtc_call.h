@@ -385,6 +385,8 @@ class FakeCall final : public webrtc::Call, public webrtc::PacketReceiver {
     auto it = delivered_packets_by_ssrc_.find(ssrc);
     return it != delivered_packets_by_ssrc_.end() ? it->second : 0u;
   }
+  // Number of times DeliverRtpPackets has been called.
+  size_t delivered_rtp_batches() const { return delivered_rtp_batches_; }
 
   // This is useful if we care about the last media packet (with id populated)
   // but not the last ICE packet (with -1 ID).
@@ -443,6 +445,10 @@ class FakeCall final : public webrtc::Call, public webrtc::PacketReceiver {
       webrtc::MediaType media_type,
       webrtc::RtpPacketReceived packet,
       OnUndemuxablePacketHandler un_demuxable_packet_handler) override;
+  void DeliverRtpPackets(
+      webrtc::MediaType media_type,
+      std::vector<webrtc::RtpPacketReceived> packets,
+      OnUndemuxablePacketHandler un_demuxable_packet_handler) override;
 
   bool DeliverPacketInternal(webrtc::MediaType media_type,
                              uint32_t ssrc,
@@ -492,6 +498,7 @@ class FakeCall final : public webrtc::Call, public webrtc::PacketReceiver {
   std::vector<FakeAudioReceiveStream*> audio_receive_streams_;
   std::vector<FakeFlexfecReceiveStream*> flexfec_receive_streams_;
   std::map<uint32_t, size_t> delivered_packets_by_ssrc_;
+  size_t delivered_rtp_batches_ = 0;
 
   int num_created_send_streams_;
   int num_created_receive_streams_;
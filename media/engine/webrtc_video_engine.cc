@@ -1763,27 +1763,63 @@ void WebRtcVideoChannel::OnPacketReceived(
   // consistency it would be good to move the interaction with call_->Receiver()
   // to a common implementation and provide a callback on the worker thread
   // for the exception case (DELIVERY_UNKNOWN_SSRC) and how retry is attempted.
-  worker_thread_->PostTask(
-      SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-        RTC_DCHECK_RUN_ON(&thread_checker_);
-
-        // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
-        // in RtpTransport and does not neccessarily include extensions specific
-        // to this channel/MID. Also see comment in
-        // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
-        // It would likely be good if extensions where merged per BUNDLE and
-        // applied directly in RtpTransport::DemuxPacket;
-        packet.IdentifyExtensions(recv_rtp_extension_map_);
-        packet.set_payload_type_frequency(webrtc::kVideoPayloadTypeFrequency);
-        if (!packet.arrival_time().IsFinite()) {
-          packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
-        }
+  if (worker_thread_->IsCurrent()) {
+    // The network and worker threads are the same; deliver without a hop.
+    RTC_DCHECK_RUN_ON(&thread_checker_);
+    {
+      webrtc::MutexLock lock(&pending_packets_lock_);
+      pending_packets_.push_back(packet);
+    }
+    DeliverPendingPackets();
+    return;
+  }
+
+  bool post_delivery_task;
+  {
+    webrtc::MutexLock lock(&pending_packets_lock_);
+    pending_packets_.push_back(packet);
+    // Only the packet that starts a new batch needs to schedule a delivery;
+    // later packets ride along until the worker thread picks the batch up.
+    post_delivery_task = pending_packets_.size() == 1;
+  }
+  if (!post_delivery_task) {
+    return;
+  }
+  worker_thread_->PostTask(SafeTask(task_safety_.flag(), [this]() {
+    RTC_DCHECK_RUN_ON(&thread_checker_);
+    DeliverPendingPackets();
+  }));
+}
+
+void WebRtcVideoChannel::DeliverPendingPackets() {
+  std::vector<webrtc::RtpPacketReceived> packets;
+  {
+    webrtc::MutexLock lock(&pending_packets_lock_);
+    packets.swap(pending_packets_);
+  }
+  if (packets.empty()) {
+    return;
+  }
+
+  const webrtc::Timestamp now = webrtc::Timestamp::Micros(rtc::TimeMicros());
+  for (webrtc::RtpPacketReceived& packet : packets) {
+    // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
+    // in RtpTransport and does not neccessarily include extensions specific
+    // to this channel/MID. Also see comment in
+    // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
+    // It would likely be good if extensions where merged per BUNDLE and
+    // applied directly in RtpTransport::DemuxPacket;
+    packet.IdentifyExtensions(recv_rtp_extension_map_);
+    packet.set_payload_type_frequency(webrtc::kVideoPayloadTypeFrequency);
+    if (!packet.arrival_time().IsFinite()) {
+      packet.set_arrival_time(now);
+    }
+  }
 
-        call_->Receiver()->DeliverRtpPacket(
-            webrtc::MediaType::VIDEO, std::move(packet),
-            absl::bind_front(
-                &WebRtcVideoChannel::MaybeCreateDefaultReceiveStream, this));
-      }));
+  call_->Receiver()->DeliverRtpPackets(
+      webrtc::MediaType::VIDEO, std::move(packets),
+      absl::bind_front(&WebRtcVideoChannel::MaybeCreateDefaultReceiveStream,
+                       this));
 }
 
 bool WebRtcVideoChannel::MaybeCreateDefaultReceiveStream(
@@ -1917,15 +1953,19 @@ void WebRtcVideoChannel::OnNetworkRouteChanged(
     absl::string_view transport_name,
     const rtc::NetworkRoute& network_route) {
   RTC_DCHECK_RUN_ON(&network_thread_checker_);
-  worker_thread_->PostTask(SafeTask(
-      task_safety_.flag(),
-      [this, name = std::string(transport_name), route = network_route] {
-        RTC_DCHECK_RUN_ON(&thread_checker_);
-        webrtc::RtpTransportControllerSendInterface* transport =
-            call_->GetTransportControllerSend();
-        transport->OnNetworkRouteChanged(name, route);
-        transport->OnTransportOverheadChanged(route.packet_overhead);
-      }));
+  auto update = [this, name = std::string(transport_name),
+                 route = network_route] {
+    RTC_DCHECK_RUN_ON(&thread_checker_);
+    webrtc::RtpTransportControllerSendInterface* transport =
+        call_->GetTransportControllerSend();
+    transport->OnNetworkRouteChanged(name, route);
+    transport->OnTransportOverheadChanged(route.packet_overhead);
+  };
+  if (worker_thread_->IsCurrent()) {
+    update();
+  } else {
+    worker_thread_->PostTask(SafeTask(task_safety_.flag(), std::move(update)));
+  }
 }
 
 void WebRtcVideoChannel::SetInterface(MediaChannelNetworkInterface* iface) {
@@ -328,6 +328,8 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   bool MaybeCreateDefaultReceiveStream(
       const webrtc::RtpPacketReceived& parsed_packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
+  // Delivers the packets batched up by OnPacketReceived to `call_`.
+  void DeliverPendingPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
   void ReCreateDefaulReceiveStream(uint32_t ssrc,
                                    absl::optional<uint32_t> rtx_ssrc);
   void ConfigureReceiverRtp(
@@ -607,6 +609,13 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker network_thread_checker_;
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker thread_checker_;
 
+  // Packets handed over from the network thread that are waiting for a
+  // delivery task on the worker thread. A task is only posted when the batch
+  // goes from empty to non-empty, so a burst of packets costs a single hop.
+  webrtc::Mutex pending_packets_lock_;
+  std::vector<webrtc::RtpPacketReceived> pending_packets_
+      RTC_GUARDED_BY(pending_packets_lock_);
+
   uint32_t rtcp_receiver_report_ssrc_ RTC_GUARDED_BY(thread_checker_);
   bool sending_ RTC_GUARDED_BY(thread_checker_);
   webrtc::Call* const call_;
@@ -742,6 +742,8 @@ class WebRtcVoiceMediaChannel::WebRtcAudioSendStream
       const std::vector<webrtc::RtpExtension>& extensions,
       int max_send_bitrate_bps,
       int rtcp_report_interval_ms,
+      const std::string& shared_encoder_group,
+      const std::vector<int>& shared_encoder_bitrates_bps,
       const absl::optional<std::string>& audio_network_adaptor_config,
       webrtc::Call* call,
       webrtc::Transport* send_transport,
@@ -769,6 +771,8 @@ class WebRtcVoiceMediaChannel::WebRtcAudioSendStream
     config_.frame_encryptor = frame_encryptor;
     config_.crypto_options = crypto_options;
     config_.rtcp_report_interval_ms = rtcp_report_interval_ms;
+    config_.shared_encoder_group = shared_encoder_group;
+    config_.shared_encoder_bitrates_bps = shared_encoder_bitrates_bps;
     rtp_parameters_.encodings[0].ssrc = ssrc;
     rtp_parameters_.rtcp.cname = c_name;
     rtp_parameters_.header_extensions = extensions;
@@ -840,6 +844,15 @@ class WebRtcVoiceMediaChannel::WebRtcAudioSendStream
     ReconfigureAudioSendStream(nullptr);
   }
 
+  void SetSharedEncoderGroup(const std::string& shared_encoder_group) {
+    RTC_DCHECK_RUN_ON(&worker_thread_checker_);
+    if (config_.shared_encoder_group == shared_encoder_group) {
+      return;
+    }
+    config_.shared_encoder_group = shared_encoder_group;
+    ReconfigureAudioSendStream(nullptr);
+  }
+
   bool SetMaxSendBitrate(int bps) {
     RTC_DCHECK_RUN_ON(&worker_thread_checker_);
     RTC_DCHECK(config_.send_codec_spec);
@@ -1491,6 +1504,8 @@ bool WebRtcVoiceMediaChannel::SetOptions(const AudioOptions& options) {
       GetAudioNetworkAdaptorConfig(options_);
   for (auto& it : send_streams_) {
     it.second->SetAudioNetworkAdaptorConfig(audio_network_adaptor_config);
+    it.second->SetSharedEncoderGroup(
+        options_.shared_encoder_group.value_or(""));
   }
 
   RTC_LOG(LS_INFO) << "Set voice channel options. Current options: "
@@ -1855,7 +1870,9 @@ bool WebRtcVoiceMediaChannel::AddSendStream(const StreamParams& sp) {
   WebRtcAudioSendStream* stream = new WebRtcAudioSendStream(
       ssrc, mid_, sp.cname, sp.id, send_codec_spec_, ExtmapAllowMixed(),
       send_rtp_extensions_, max_send_bitrate_bps_,
-      audio_config_.rtcp_report_interval_ms, audio_network_adaptor_config,
+      audio_config_.rtcp_report_interval_ms,
+      options_.shared_encoder_group.value_or(""),
+      audio_config_.shared_encoder_bitrates_bps, audio_network_adaptor_config,
       call_, this, engine()->encoder_factory_, codec_pair_id_, nullptr,
       crypto_options_);
   send_streams_.insert(std::make_pair(ssrc, stream));
@@ -2170,27 +2187,62 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(
   // call_->Receiver() to a common implementation and provide a callback on
   // the worker thread for the exception case (DELIVERY_UNKNOWN_SSRC) and
   // how retry is attempted.
-  worker_thread_->PostTask(
-      SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-        RTC_DCHECK_RUN_ON(worker_thread_);
-
-        // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
-        // in RtpTransport and does not neccessarily include extensions specific
-        // to this channel/MID. Also see comment in
-        // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
-        // It would likely be good if extensions where merged per BUNDLE and
-        // applied directly in RtpTransport::DemuxPacket;
-        packet.IdentifyExtensions(recv_rtp_extension_map_);
-        if (!packet.arrival_time().IsFinite()) {
-          packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
-        }
+  if (worker_thread_->IsCurrent()) {
+    // The network and worker threads are the same; deliver without a hop.
+    {
+      webrtc::MutexLock lock(&pending_packets_lock_);
+      pending_packets_.push_back(packet);
+    }
+    DeliverPendingPackets();
+    return;
+  }
+
+  bool post_delivery_task;
+  {
+    webrtc::MutexLock lock(&pending_packets_lock_);
+    pending_packets_.push_back(packet);
+    // Only the packet that starts a new batch needs to schedule a delivery;
+    // later packets ride along until the worker thread picks the batch up.
+    post_delivery_task = pending_packets_.size() == 1;
+  }
+  if (!post_delivery_task) {
+    return;
+  }
+  worker_thread_->PostTask(SafeTask(task_safety_.flag(), [this]() {
+    RTC_DCHECK_RUN_ON(worker_thread_);
+    DeliverPendingPackets();
+  }));
+}
+
+void WebRtcVoiceMediaChannel::DeliverPendingPackets() {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  std::vector<webrtc::RtpPacketReceived> packets;
+  {
+    webrtc::MutexLock lock(&pending_packets_lock_);
+    packets.swap(pending_packets_);
+  }
+  if (packets.empty()) {
+    return;
+  }
+
+  const webrtc::Timestamp now = webrtc::Timestamp::Micros(rtc::TimeMicros());
+  for (webrtc::RtpPacketReceived& packet : packets) {
+    // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
+    // in RtpTransport and does not neccessarily include extensions specific
+    // to this channel/MID. Also see comment in
+    // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
+    // It would likely be good if extensions where merged per BUNDLE and
+    // applied directly in RtpTransport::DemuxPacket;
+    packet.IdentifyExtensions(recv_rtp_extension_map_);
+    if (!packet.arrival_time().IsFinite()) {
+      packet.set_arrival_time(now);
+    }
+  }
 
-        call_->Receiver()->DeliverRtpPacket(
-            webrtc::MediaType::AUDIO, std::move(packet),
-            absl::bind_front(
-                &WebRtcVoiceMediaChannel::MaybeCreateDefaultReceiveStream,
-                this));
-      }));
+  call_->Receiver()->DeliverRtpPackets(
+      webrtc::MediaType::AUDIO, std::move(packets),
+      absl::bind_front(
+          &WebRtcVoiceMediaChannel::MaybeCreateDefaultReceiveStream, this));
 }
 
 bool WebRtcVoiceMediaChannel::MaybeCreateDefaultReceiveStream(
@@ -2258,12 +2310,16 @@ void WebRtcVoiceMediaChannel::OnNetworkRouteChanged(
 
   call_->OnAudioTransportOverheadChanged(network_route.packet_overhead);
 
-  worker_thread_->PostTask(SafeTask(
-      task_safety_.flag(),
-      [this, name = std::string(transport_name), route = network_route] {
-        RTC_DCHECK_RUN_ON(worker_thread_);
-        call_->GetTransportControllerSend()->OnNetworkRouteChanged(name, route);
-      }));
+  auto update = [this, name = std::string(transport_name),
+                 route = network_route] {
+    RTC_DCHECK_RUN_ON(worker_thread_);
+    call_->GetTransportControllerSend()->OnNetworkRouteChanged(name, route);
+  };
+  if (worker_thread_->IsCurrent()) {
+    update();
+  } else {
+    worker_thread_->PostTask(SafeTask(task_safety_.flag(), std::move(update)));
+  }
 }
 
 bool WebRtcVoiceMediaChannel::MuteStream(uint32_t ssrc, bool muted) {
@@ -32,7 +32,9 @@
 #include "modules/async_audio_processing/async_audio_processing.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/network_route.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 class AudioFrameProcessor;
@@ -280,6 +282,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   // can not be demuxed. Returns true if a default receive stream has been
   // created.
   bool MaybeCreateDefaultReceiveStream(const webrtc::RtpPacketReceived& packet);
+  // Delivers the packets batched up by OnPacketReceived to `call_`.
+  void DeliverPendingPackets();
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
@@ -288,6 +292,13 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   webrtc::ScopedTaskSafety task_safety_;
   webrtc::SequenceChecker network_thread_checker_;
 
+  // Packets handed over from the network thread that are waiting for a
+  // delivery task on the worker thread. A task is only posted when the batch
+  // goes from empty to non-empty, so a burst of packets costs a single hop.
+  webrtc::Mutex pending_packets_lock_;
+  std::vector<webrtc::RtpPacketReceived> pending_packets_
+      RTC_GUARDED_BY(pending_packets_lock_);
+
   WebRtcVoiceEngine* const engine_ = nullptr;
   std::vector<AudioCodec> send_codecs_;
 
@@ -36,6 +36,8 @@
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 #include "test/mock_audio_decoder_factory.h"
 #include "test/mock_audio_encoder_factory.h"
@@ -2598,6 +2600,40 @@ TEST_P(WebRtcVoiceEngineTestFake, Recv) {
       GetRecvStream(1).VerifyLastPacket(kPcmuFrame, sizeof(kPcmuFrame)));
 }
 
+// Test that packets arriving on the network thread before the worker thread
+// runs are delivered to Call as a single batch.
+TEST_P(WebRtcVoiceEngineTestFake, RecvBatchesPacketsPerWorkerTask) {
+  EXPECT_TRUE(SetupChannel());
+  EXPECT_TRUE(AddRecvStream(1));
+  webrtc::RtpPacketReceived packet;
+  ASSERT_TRUE(packet.Parse(kPcmuFrame, sizeof(kPcmuFrame)));
+  std::unique_ptr<rtc::Thread> network_thread = rtc::Thread::Create();
+  network_thread->Start();
+  webrtc::SendTask(network_thread.get(), [&] {
+    receive_channel_->OnPacketReceived(packet);
+    receive_channel_->OnPacketReceived(packet);
+    receive_channel_->OnPacketReceived(packet);
+  });
+  EXPECT_EQ(0, GetRecvStream(1).received_packets());
+  rtc::Thread::Current()->ProcessMessages(0);
+
+  EXPECT_EQ(1u, call_.delivered_rtp_batches());
+  EXPECT_EQ(3, GetRecvStream(1).received_packets());
+}
+
+// Test that packets are delivered without a thread hop when the network and
+// worker threads are the same.
+TEST_P(WebRtcVoiceEngineTestFake, RecvDeliversDirectlyOnWorkerThread) {
+  EXPECT_TRUE(SetupChannel());
+  EXPECT_TRUE(AddRecvStream(1));
+  webrtc::RtpPacketReceived packet;
+  ASSERT_TRUE(packet.Parse(kPcmuFrame, sizeof(kPcmuFrame)));
+  receive_channel_->OnPacketReceived(packet);
+  EXPECT_EQ(1, GetRecvStream(1).received_packets());
+  receive_channel_->OnPacketReceived(packet);
+  EXPECT_EQ(2, GetRecvStream(1).received_packets());
+}
+
 // Test that we can properly receive packets on multiple streams.
 TEST_P(WebRtcVoiceEngineTestFake, RecvWithMultipleStreams) {
   EXPECT_TRUE(SetupChannel());
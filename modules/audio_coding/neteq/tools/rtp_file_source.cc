@@ -18,6 +18,7 @@
 #endif
 
 #include <memory>
+#include <set>
 
 #include "modules/audio_coding/neteq/tools/packet.h"
 #include "rtc_base/checks.h"
@@ -53,30 +54,21 @@ bool RtpFileSource::RegisterRtpHeaderExtension(RTPExtensionType type,
 }
 
 std::unique_ptr<Packet> RtpFileSource::NextPacket() {
-  while (true) {
-    RtpPacket temp_packet;
-    if (!rtp_reader_->NextPacket(&temp_packet)) {
-      return NULL;
-    }
-    if (temp_packet.original_length == 0) {
-      // May be an RTCP packet.
-      // Read the next one.
-      continue;
-    }
+  while (next_packet_ < rtp_packets_.size()) {
+    RtpPacketView view = rtp_reader_->GetPacket(rtp_packets_[next_packet_++]);
     auto packet = std::make_unique<Packet>(
-        rtc::CopyOnWriteBuffer(temp_packet.data, temp_packet.length),
-        temp_packet.original_length, temp_packet.time_ms,
-        &rtp_header_extension_map_);
+        rtc::CopyOnWriteBuffer(view.data.data(), view.data.size()),
+        view.original_length, view.time_ms, &rtp_header_extension_map_);
     if (!packet->valid_header()) {
       continue;
     }
-    if (filter_.test(packet->header().payloadType) ||
-        (ssrc_filter_ && packet->header().ssrc != *ssrc_filter_)) {
+    if (filter_.test(packet->header().payloadType)) {
       // This payload type should be filtered out. Continue to the next packet.
       continue;
     }
     return packet;
   }
+  return NULL;
 }
 
 RtpFileSource::RtpFileSource(absl::optional<uint32_t> ssrc_filter)
@@ -85,14 +77,21 @@ RtpFileSource::RtpFileSource(absl::optional<uint32_t> ssrc_filter)
 
 bool RtpFileSource::OpenFile(absl::string_view file_name) {
   rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kRtpDump, file_name));
-  if (rtp_reader_)
-    return true;
-  rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kPcap, file_name));
+  if (!rtp_reader_) {
+    rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kPcap, file_name));
+  }
   if (!rtp_reader_) {
     RTC_FATAL()
         << "Couldn't open input file as either a rtpdump or .pcap. Note "
         << "that .pcapng is not supported.";
   }
+  // Look up the packets of the stream in the index, so that RTCP and packets
+  // of other SSRCs are skipped without reading them.
+  std::set<uint32_t> ssrcs;
+  if (ssrc_filter_) {
+    ssrcs.insert(*ssrc_filter_);
+  }
+  rtp_packets_ = rtp_reader_->FindRtpPackets(ssrcs, {});
   return true;
 }
 
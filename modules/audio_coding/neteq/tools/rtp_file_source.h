@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -60,6 +61,9 @@ class RtpFileSource : public PacketSource {
 
   std::unique_ptr<RtpFileReader> rtp_reader_;
   const absl::optional<uint32_t> ssrc_filter_;
+  // Indices in `rtp_reader_` of the RTP packets that pass `ssrc_filter_`.
+  std::vector<size_t> rtp_packets_;
+  size_t next_packet_ = 0;
   RtpHeaderExtensionMap rtp_header_extension_map_;
 };
 
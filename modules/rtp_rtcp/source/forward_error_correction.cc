@@ -13,9 +13,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
@@ -33,6 +33,46 @@ namespace {
 constexpr size_t kTransportOverhead = 28;
 
 constexpr uint16_t kOldSequenceThreshold = 0x3fff;
+
+// Returns the position in the sorted `packets` at which a packet with
+// `seq_num` belongs. Packets mostly arrive in order, so the position is
+// searched for from the back. Sets `duplicate` if a packet with `seq_num` is
+// already present.
+template <typename T>
+typename std::list<std::unique_ptr<T>>::iterator FindSortedPosition(
+    std::list<std::unique_ptr<T>>& packets,
+    uint16_t seq_num,
+    bool* duplicate) {
+  auto it = packets.end();
+  while (it != packets.begin()) {
+    auto prev_it = std::prev(it);
+    if (!IsNewerSequenceNumber((*prev_it)->seq_num, seq_num)) {
+      *duplicate = (*prev_it)->seq_num == seq_num;
+      return it;
+    }
+    it = prev_it;
+  }
+  *duplicate = false;
+  return it;
+}
+
+// XORs `length` bytes of `src` into `dst`. Working on whole words lets the
+// compiler vectorize the loop without having to prove anything about
+// alignment.
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t src_word;
+    uint64_t dst_word;
+    memcpy(&src_word, src + i, sizeof(uint64_t));
+    memcpy(&dst_word, dst + i, sizeof(uint64_t));
+    dst_word ^= src_word;
+    memcpy(dst + i, &dst_word, sizeof(uint64_t));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
@@ -337,6 +377,7 @@ void ForwardErrorCorrection::ResetState(
   // Free the memory for any existing recovered packets, if the caller hasn't.
   recovered_packets->clear();
   received_fec_packets_.clear();
+  covering_fec_packets_.clear();
 }
 
 void ForwardErrorCorrection::InsertMediaPacket(
@@ -344,13 +385,12 @@ void ForwardErrorCorrection::InsertMediaPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, protected_media_ssrc_);
 
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    RTC_DCHECK_EQ(recovered_packet->ssrc, received_packet.ssrc);
-    if (recovered_packet->seq_num == received_packet.seq_num) {
-      // Duplicate packet, no need to add to list.
-      return;
-    }
+  bool duplicate;
+  auto position = FindSortedPosition(*recovered_packets,
+                                     received_packet.seq_num, &duplicate);
+  if (duplicate) {
+    // Duplicate packet, no need to add to list.
+    return;
   }
 
   std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
@@ -361,26 +401,37 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->ssrc = received_packet.ssrc;
   recovered_packet->seq_num = received_packet.seq_num;
   recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
   RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
+  recovered_packets->insert(position, std::move(recovered_packet));
   UpdateCoveringFecPackets(*recovered_packet_ptr);
 }
 
 void ForwardErrorCorrection::UpdateCoveringFecPackets(
     const RecoveredPacket& packet) {
-  for (auto& fec_packet : received_fec_packets_) {
-    // Is this FEC packet protecting the media packet `packet`?
-    auto protected_it = absl::c_lower_bound(
-        fec_packet->protected_packets, &packet, SortablePacket::LessThan());
-    if (protected_it != fec_packet->protected_packets.end() &&
-        (*protected_it)->seq_num == packet.seq_num) {
-      // Found an FEC packet which is protecting `packet`.
-      (*protected_it)->pkt = packet.pkt;
+  auto range = covering_fec_packets_.equal_range(packet.seq_num);
+  for (auto it = range.first; it != range.second; ++it) {
+    // Found an FEC packet which is protecting `packet`.
+    ProtectedPacket* protected_packet = it->second.protected_packet;
+    if (protected_packet->pkt == nullptr) {
+      protected_packet->pkt = packet.pkt;
+      --it->second.fec_packet->num_missing_protected_packets;
+    }
+  }
+}
+
+ForwardErrorCorrection::ReceivedFecPacketList::iterator
+ForwardErrorCorrection::EraseFecPacket(
+    ReceivedFecPacketList::iterator fec_packet_it) {
+  for (const auto& protected_packet : (*fec_packet_it)->protected_packets) {
+    auto range = covering_fec_packets_.equal_range(protected_packet->seq_num);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.protected_packet == protected_packet.get()) {
+        covering_fec_packets_.erase(it);
+        break;
+      }
     }
   }
+  return received_fec_packets_.erase(fec_packet_it);
 }
 
 void ForwardErrorCorrection::InsertFecPacket(
@@ -388,13 +439,12 @@ void ForwardErrorCorrection::InsertFecPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, ssrc_);
 
-  // Check for duplicate.
-  for (const auto& existing_fec_packet : received_fec_packets_) {
-    RTC_DCHECK_EQ(existing_fec_packet->ssrc, received_packet.ssrc);
-    if (existing_fec_packet->seq_num == received_packet.seq_num) {
-      // Drop duplicate FEC packet data.
-      return;
-    }
+  bool duplicate;
+  auto position = FindSortedPosition(received_fec_packets_,
+                                     received_packet.seq_num, &duplicate);
+  if (duplicate) {
+    // Drop duplicate FEC packet data.
+    return;
   }
 
   std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
@@ -444,13 +494,15 @@ void ForwardErrorCorrection::InsertFecPacket(
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
   } else {
     AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
+    for (const auto& protected_packet : fec_packet->protected_packets) {
+      covering_fec_packets_.emplace(
+          protected_packet->seq_num,
+          CoveringFecPacket{fec_packet.get(), protected_packet.get()});
+    }
+    received_fec_packets_.insert(position, std::move(fec_packet));
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
-      received_fec_packets_.pop_front();
+      EraseFecPacket(received_fec_packets_.begin());
     }
     RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
   }
@@ -460,7 +512,7 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
   ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
+  fec_packet->num_missing_protected_packets = protected_packets->size();
 
   // Find intersection between the (sorted) containers `protected_packets`
   // and `recovered_packets`, i.e. all protected packets that have already
@@ -477,6 +529,7 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     } else {  // *it_p == *it_r.
       // This protected packet has already been recovered.
       (*it_p)->pkt = (*it_r)->pkt;
+      --fec_packet->num_missing_protected_packets;
       ++it_p;
       ++it_r;
     }
@@ -502,7 +555,7 @@ void ForwardErrorCorrection::InsertPacket(
     while (it != received_fec_packets_.end()) {
       uint16_t seq_num_diff = MinDiff(received_packet.seq_num, (*it)->seq_num);
       if (seq_num_diff > kOldSequenceThreshold) {
-        it = received_fec_packets_.erase(it);
+        it = EraseFecPacket(it);
       } else {
         // No need to keep iterating, since `received_fec_packets_` is sorted.
         break;
@@ -624,11 +677,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
     dst->data.SetSize(new_size);
     memset(dst->data.MutableData() + old_size, 0, new_size - old_size);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+           dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -657,8 +707,8 @@ void ForwardErrorCorrection::AttemptRecovery(
     RecoveredPacketList* recovered_packets) {
   auto fec_packet_it = received_fec_packets_.begin();
   while (fec_packet_it != received_fec_packets_.end()) {
-    // Search for each FEC packet's protected media packets.
-    int packets_missing = NumCoveredPacketsMissing(**fec_packet_it);
+    const size_t packets_missing =
+        (*fec_packet_it)->num_missing_protected_packets;
 
     // We can only recover one packet with an FEC packet.
     if (packets_missing == 1) {
@@ -667,21 +717,20 @@ void ForwardErrorCorrection::AttemptRecovery(
       recovered_packet->pkt = nullptr;
       if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
         // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+        fec_packet_it = EraseFecPacket(fec_packet_it);
         continue;
       }
 
       auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
+      bool duplicate;
+      auto position = FindSortedPosition(
+          *recovered_packets, recovered_packet_ptr->seq_num, &duplicate);
+      recovered_packets->insert(position, std::move(recovered_packet));
       UpdateCoveringFecPackets(*recovered_packet_ptr);
       DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      EraseFecPacket(fec_packet_it);
 
       // A packet has been recovered. We need to check the FEC list again, as
       // this may allow additional packets to be recovered.
@@ -691,27 +740,13 @@ void ForwardErrorCorrection::AttemptRecovery(
                IsOldFecPacket(**fec_packet_it, recovered_packets)) {
       // Either all protected packets arrived or have been recovered, or the FEC
       // packet is old. We can discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      fec_packet_it = EraseFecPacket(fec_packet_it);
     } else {
       fec_packet_it++;
     }
   }
 }
 
-int ForwardErrorCorrection::NumCoveredPacketsMissing(
-    const ReceivedFecPacket& fec_packet) {
-  int packets_missing = 0;
-  for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
-      ++packets_missing;
-      if (packets_missing > 1) {
-        break;  // We can't recover more than one packet.
-      }
-    }
-  }
-  return packets_missing;
-}
-
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
     RecoveredPacketList* recovered_packets) {
   const size_t max_media_packets = fec_header_reader_->MaxMediaPackets();
@@ -16,6 +16,7 @@
 
 #include <list>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "api/scoped_refptr.h"
@@ -137,6 +138,9 @@ class ForwardErrorCorrection {
     size_t packet_mask_offset;  // Relative start of FEC header.
     size_t packet_mask_size;
     size_t protection_length;
+    // Number of packets in `protected_packets` that have neither been received
+    // nor recovered.
+    size_t num_missing_protected_packets = 0;
     // Raw data.
     rtc::scoped_refptr<ForwardErrorCorrection::Packet> pkt;
   };
@@ -280,11 +284,17 @@ class ForwardErrorCorrection {
   // packets covered by the FEC packet.
   void UpdateCoveringFecPackets(const RecoveredPacket& packet);
 
+  // Erases `fec_packet_it` from `received_fec_packets_`, along with its
+  // entries in `covering_fec_packets_`. Returns the following iterator.
+  ReceivedFecPacketList::iterator EraseFecPacket(
+      ReceivedFecPacketList::iterator fec_packet_it);
+
   // Insert `received_packet` into internal FEC list. Deletes duplicates.
   void InsertFecPacket(const RecoveredPacketList& recovered_packets,
                        const ReceivedPacket& received_packet);
 
-  // Assigns pointers to already recovered packets covered by `fec_packet`.
+  // Assigns pointers to already recovered packets covered by `fec_packet`, and
+  // counts the ones that are still missing.
   static void AssignRecoveredPackets(
       const RecoveredPacketList& recovered_packets,
       ReceivedFecPacket* fec_packet);
@@ -305,7 +315,8 @@ class ForwardErrorCorrection {
 
   // Performs XOR between the payloads of `src` and `dst` and stores the result
   // in `dst`. The parameter `dst_offset` determines at  what byte the
-  // XOR operation starts in `dst`. In total, `payload_length` bytes are XORed.
+  // XOR operation starts in `dst`. In total, `payload_length` bytes are XORed,
+  // a machine word at a time.
   static void XorPayloads(const Packet& src,
                           size_t payload_length,
                           size_t dst_offset,
@@ -320,12 +331,6 @@ class ForwardErrorCorrection {
   static bool RecoverPacket(const ReceivedFecPacket& fec_packet,
                             RecoveredPacket* recovered_packet);
 
-  // Get the number of missing media packets which are covered by `fec_packet`.
-  // An FEC packet can recover at most one packet, and if zero packets are
-  // missing the FEC packet can be discarded. This function returns 2 when two
-  // or more packets are missing.
-  static int NumCoveredPacketsMissing(const ReceivedFecPacket& fec_packet);
-
   // Discards old packets in `recovered_packets`, which are no longer relevant
   // for recovering lost packets.
   void DiscardOldRecoveredPackets(RecoveredPacketList* recovered_packets);
@@ -345,6 +350,15 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
 
+  // The protected packets of `received_fec_packets_`, keyed by sequence
+  // number. Lets a received or recovered media packet be assigned to the FEC
+  // packets covering it without visiting every stored FEC packet.
+  struct CoveringFecPacket {
+    ReceivedFecPacket* fec_packet;
+    ProtectedPacket* protected_packet;
+  };
+  std::unordered_multimap<uint16_t, CoveringFecPacket> covering_fec_packets_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than `kUlpfecMaxMediaPackets` FEC packets generated.)
@@ -633,6 +633,38 @@ TYPED_TEST(RtpFecTest, FecRecoveryWithFecOutOfOrder) {
   EXPECT_TRUE(this->IsRecoveryComplete());
 }
 
+// Recovery chains across the largest supported masks, with all packets
+// received in reverse order.
+TYPED_TEST(RtpFecTest, FecRecoveryWithMaxMediaPacketsReversed) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr uint8_t kProtectionFactor = 255;
+
+  this->media_packets_ =
+      this->media_packet_generator_.ConstructMediaPackets(kMaxMediaPackets);
+
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskRandom, &this->generated_fec_packets_));
+  EXPECT_EQ(kMaxMediaPackets, this->generated_fec_packets_.size());
+
+  // Lose every fourth media packet.
+  memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+  memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+  for (size_t i = 0; i < kMaxMediaPackets; i += 4) {
+    this->media_loss_mask_[i] = 1;
+  }
+  this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+  for (auto it = this->received_packets_.rbegin();
+       it != this->received_packets_.rend(); ++it) {
+    this->fec_.DecodeFec(**it, &this->recovered_packets_);
+  }
+
+  EXPECT_TRUE(this->IsRecoveryComplete());
+}
+
 // Test 50% protection with random mask type: Two cases are considered:
 // a 50% non-consecutive loss which can be fully recovered, and a 50%
 // consecutive loss which cannot be fully recovered.
@@ -71,9 +71,9 @@ RtpPacketizerAv1::RtpPacketizerAv1(rtc::ArrayView<const uint8_t> payload,
       packets_(Packetize(obus_, limits)),
       is_last_frame_in_picture_(is_last_frame_in_picture) {}
 
-std::vector<RtpPacketizerAv1::Obu> RtpPacketizerAv1::ParseObus(
+RtpPacketizerAv1::ObuVector RtpPacketizerAv1::ParseObus(
     rtc::ArrayView<const uint8_t> payload) {
-  std::vector<Obu> result;
+  ObuVector result;
   rtc::ByteBufferReader payload_reader(
       reinterpret_cast<const char*>(payload.data()), payload.size());
   while (payload_reader.Length() > 0) {
@@ -157,6 +157,14 @@ std::vector<RtpPacketizerAv1::Packet> RtpPacketizerAv1::Packetize(
   // Aggregation header is present in all packets.
   limits.max_payload_len -= kAggregationHeaderSize;
 
+  // Large frames, e.g. high resolution screenshare, span hundreds of packets.
+  // Reserve for the common case where packets are filled up to the limit.
+  int total_obu_size = 0;
+  for (const Obu& obu : obus) {
+    total_obu_size += obu.size;
+  }
+  packets.reserve(total_obu_size / limits.max_payload_len + 2);
+
   // Assemble packets. Push to current packet as much as it can hold before
   // considering next one. That would normally cause uneven distribution across
   // packets, specifically last one would be generally smaller.
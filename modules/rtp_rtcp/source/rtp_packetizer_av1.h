@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "api/array_view.h"
 #include "api/video/video_frame_type.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
@@ -51,9 +52,12 @@ class RtpPacketizerAv1 : public RtpPacketizer {
     // Total size consumed by the packet.
     int packet_size = 0;
   };
+  // Most frames consist of one or two OBUs once temporal delimiters are
+  // dropped, so avoid a heap allocation per frame for them.
+  using ObuVector = absl::InlinedVector<Obu, 4>;
 
   // Parses the payload into serie of OBUs.
-  static std::vector<Obu> ParseObus(rtc::ArrayView<const uint8_t> payload);
+  static ObuVector ParseObus(rtc::ArrayView<const uint8_t> payload);
   // Returns the number of additional bytes needed to store the previous OBU
   // element if an additonal OBU element is added to the packet.
   static int AdditionalBytesForPreviousObuElement(const Packet& packet);
@@ -62,7 +66,7 @@ class RtpPacketizerAv1 : public RtpPacketizer {
   uint8_t AggregationHeader() const;
 
   const VideoFrameType frame_type_;
-  const std::vector<Obu> obus_;
+  const ObuVector obus_;
   const std::vector<Packet> packets_;
   const bool is_last_frame_in_picture_;
   size_t packet_index_ = 0;
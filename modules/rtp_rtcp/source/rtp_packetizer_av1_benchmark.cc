@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/video/video_frame_type.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packetizer_av1.h"
+#include "modules/rtp_rtcp/source/rtp_packetizer_av1_test_helper.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_av1.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// A key frame of a high resolution screenshare stream: a sequence header and
+// a single large frame OBU.
+std::vector<uint8_t> BuildFrame(size_t frame_obu_size) {
+  return BuildAv1Frame(
+      {Av1Obu(kAv1ObuTypeSequenceHeader).WithPayload({1, 2, 3, 4, 5, 6}),
+       Av1Obu(kAv1ObuTypeFrame)
+           .WithPayload(std::vector<uint8_t>(frame_obu_size, 0xab))});
+}
+
+std::vector<RtpPacketToSend> Packetize(rtc::ArrayView<const uint8_t> frame) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  RtpPacketizerAv1 packetizer(frame, limits, VideoFrameType::kVideoFrameKey,
+                              /*is_last_frame_in_picture=*/true);
+  std::vector<RtpPacketToSend> packets;
+  packets.reserve(packetizer.NumPackets());
+  while (true) {
+    RtpPacketToSend packet(/*extensions=*/nullptr);
+    if (!packetizer.NextPacket(&packet)) {
+      break;
+    }
+    packets.push_back(std::move(packet));
+  }
+  return packets;
+}
+
+void BM_PacketizeAv1(benchmark::State& state) {
+  const std::vector<uint8_t> frame = BuildFrame(state.range(0));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(Packetize(frame));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+
+void BM_AssembleAv1Frame(benchmark::State& state) {
+  const std::vector<RtpPacketToSend> packets =
+      Packetize(BuildFrame(state.range(0)));
+  std::vector<rtc::ArrayView<const uint8_t>> payloads;
+  size_t payloads_size = 0;
+  for (const RtpPacketToSend& packet : packets) {
+    payloads.push_back(packet.payload());
+    payloads_size += packet.payload_size();
+  }
+
+  VideoRtpDepacketizerAv1 depacketizer;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(depacketizer.AssembleFrame(payloads));
+  }
+  state.SetBytesProcessed(state.iterations() * payloads_size);
+}
+
+// From a typical delta frame up to a 4K screenshare key frame.
+BENCHMARK(BM_PacketizeAv1)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_AssembleAv1Frame)->Range(1 << 12, 1 << 21);
+
+}  // namespace
+}  // namespace webrtc
@@ -175,12 +175,20 @@ RTPSenderVideo::RTPSenderVideo(const Config& config)
               : nullptr),
       include_capture_clock_offset_(!absl::StartsWith(
           config.field_trials->Lookup(kIncludeCaptureClockOffset),
-          "Disabled")) {
+          "Disabled")),
+      packetization_queue_(
+          config.packetize_on_task_queue && !config.frame_transformer &&
+                  config.task_queue_factory
+              ? config.task_queue_factory->CreateTaskQueue(
+                    "video_packetization", TaskQueueFactory::Priority::NORMAL)
+              : nullptr) {
   if (frame_transformer_delegate_)
     frame_transformer_delegate_->Init();
 }
 
 RTPSenderVideo::~RTPSenderVideo() {
+  // Waits for a frame in flight, and drops the queued ones.
+  packetization_queue_ = nullptr;
   if (frame_transformer_delegate_)
     frame_transformer_delegate_->Reset();
 }
@@ -234,6 +242,17 @@ void RTPSenderVideo::SetVideoStructure(
     frame_transformer_delegate_->SetVideoStructureUnderLock(video_structure);
     return;
   }
+  if (packetization_queue_) {
+    // Must apply to the next frame posted, not to the frames still queued.
+    absl::optional<FrameDependencyStructure> structure;
+    if (video_structure) {
+      structure = *video_structure;
+    }
+    packetization_queue_->PostTask([this, structure = std::move(structure)] {
+      SetVideoStructureInternal(structure ? &*structure : nullptr);
+    });
+    return;
+  }
   SetVideoStructureInternal(video_structure);
 }
 
@@ -279,6 +298,13 @@ void RTPSenderVideo::SetVideoLayersAllocation(
         std::move(allocation));
     return;
   }
+  if (packetization_queue_) {
+    packetization_queue_->PostTask(
+        [this, allocation = std::move(allocation)]() mutable {
+          SetVideoLayersAllocationInternal(std::move(allocation));
+        });
+    return;
+  }
   SetVideoLayersAllocationInternal(std::move(allocation));
 }
 
@@ -646,12 +672,12 @@ bool RTPSenderVideo::SendVideo(
     MinimizeDescriptor(&video_header);
   }
 
-  rtc::Buffer encrypted_video_payload;
   if (frame_encryptor_ != nullptr) {
     const size_t max_ciphertext_size =
         frame_encryptor_->GetMaxCiphertextByteSize(cricket::MEDIA_TYPE_VIDEO,
                                                    payload.size());
-    encrypted_video_payload.SetSize(max_ciphertext_size);
+    // Reuses the allocation of previous frames; only grows for larger ones.
+    encrypted_video_payload_.SetSize(max_ciphertext_size);
 
     size_t bytes_written = 0;
 
@@ -663,12 +689,12 @@ bool RTPSenderVideo::SendVideo(
 
     if (frame_encryptor_->Encrypt(
             cricket::MEDIA_TYPE_VIDEO, first_packet->Ssrc(), additional_data,
-            payload, encrypted_video_payload, &bytes_written) != 0) {
+            payload, encrypted_video_payload_, &bytes_written) != 0) {
       return false;
     }
 
-    encrypted_video_payload.SetSize(bytes_written);
-    payload = encrypted_video_payload;
+    encrypted_video_payload_.SetSize(bytes_written);
+    payload = encrypted_video_payload_;
   } else if (require_frame_encryption_) {
     RTC_LOG(LS_WARNING)
         << "No FrameEncryptor is attached to this video sending stream but "
@@ -794,6 +820,25 @@ bool RTPSenderVideo::SendEncodedImage(
         payload_type, codec_type, rtp_timestamp, encoded_image, video_header,
         expected_retransmission_time_ms);
   }
+  if (packetization_queue_) {
+    // The copy of `encoded_image` shares, and keeps alive, the encoded data.
+    // As with frame transformers, the encoder must not write to a buffer it
+    // has delivered.
+    packetization_queue_->PostTask(
+        [this, payload_type, codec_type, rtp_timestamp, encoded_image,
+         video_header = std::move(video_header),
+         expected_retransmission_time_ms,
+         csrcs = rtp_sender_->Csrcs()]() mutable {
+          if (!SendVideo(payload_type, codec_type, rtp_timestamp,
+                         encoded_image.capture_time_ms_, encoded_image,
+                         std::move(video_header),
+                         expected_retransmission_time_ms, std::move(csrcs))) {
+            RTC_LOG(LS_WARNING) << "Dropped video frame with RTP timestamp "
+                                << rtp_timestamp;
+          }
+        });
+    return true;
+  }
   return SendVideo(payload_type, codec_type, rtp_timestamp,
                    encoded_image.capture_time_ms_, encoded_image, video_header,
                    expected_retransmission_time_ms, rtp_sender_->Csrcs());
@@ -35,6 +35,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/one_time_event.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/rate_statistics.h"
@@ -83,6 +84,12 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
     const FieldTrialsView* field_trials = nullptr;
     rtc::scoped_refptr<FrameTransformerInterface> frame_transformer;
     TaskQueueFactory* task_queue_factory = nullptr;
+    // If true, frames passed to SendEncodedImage() are packetized and handed to
+    // the pacer on a task queue owned by the sender instead of on the calling
+    // encoder thread. Frames keep their order. Requires `task_queue_factory`.
+    // Ignored when `frame_transformer` is set, as transformed frames are
+    // already sent from a task queue.
+    bool packetize_on_task_queue = false;
   };
 
   explicit RTPSenderVideo(const Config& config);
@@ -108,6 +115,10 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
                  absl::optional<int64_t> expected_retransmission_time_ms,
                  std::vector<uint32_t> csrcs) override;
 
+  // Returns false if the frame could not be packetized and sent. When frames
+  // are packetized on a task queue (`Config::packetize_on_task_queue`) or go
+  // through a frame transformer, this only reports whether the frame was
+  // queued, and callers can not rely on it to detect send failures.
   bool SendEncodedImage(
       int payload_type,
       absl::optional<VideoCodecType> codec_type,
@@ -214,6 +225,9 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
   absl::optional<VideoLayersAllocation> last_full_sent_allocation_
       RTC_GUARDED_BY(send_checker_);
 
+  // Holds the encrypted payload of the frame being sent.
+  rtc::Buffer encrypted_video_payload_ RTC_GUARDED_BY(send_checker_);
+
   // Current target playout delay.
   VideoPlayoutDelay current_playout_delay_ RTC_GUARDED_BY(send_checker_);
   // Flag indicating if we need to send `current_playout_delay_` in order
@@ -256,6 +270,11 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
       frame_transformer_delegate_;
 
   const bool include_capture_clock_offset_;
+
+  // Runs SendVideo() and the state updates that must be ordered with it when
+  // `Config::packetize_on_task_queue` is set. Deleted first on destruction so
+  // that no queued frame can outlive the sender.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> packetization_queue_;
 };
 
 }  // namespace webrtc
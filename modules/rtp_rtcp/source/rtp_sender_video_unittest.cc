@@ -1717,5 +1717,63 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest,
   EXPECT_EQ(transport_.packets_sent(), 2);
 }
 
+class RtpSenderVideoPacketizationQueueTest : public ::testing::Test {
+ public:
+  RtpSenderVideoPacketizationQueueTest()
+      : time_controller_(kStartTime),
+        retransmission_rate_limiter_(time_controller_.GetClock(), 1000),
+        rtp_module_(ModuleRtpRtcpImpl2::Create([&] {
+          RtpRtcpInterface::Configuration config;
+          config.clock = time_controller_.GetClock();
+          config.outgoing_transport = &transport_;
+          config.retransmission_rate_limiter = &retransmission_rate_limiter_;
+          config.field_trials = &field_trials_;
+          config.local_media_ssrc = kSsrc;
+          return config;
+        }())) {
+    rtp_module_->SetSequenceNumber(kSeqNum);
+    rtp_module_->SetStartTimestamp(0);
+  }
+
+  std::unique_ptr<RTPSenderVideo> CreateSenderWithPacketizationQueue() {
+    RTPSenderVideo::Config config;
+    config.clock = time_controller_.GetClock();
+    config.rtp_sender = rtp_module_->RtpSender();
+    config.field_trials = &field_trials_;
+    config.task_queue_factory = time_controller_.GetTaskQueueFactory();
+    config.packetize_on_task_queue = true;
+    return std::make_unique<RTPSenderVideo>(config);
+  }
+
+ protected:
+  GlobalSimulatedTimeController time_controller_;
+  FieldTrialBasedConfig field_trials_;
+  LoopbackTransportTest transport_;
+  RateLimiter retransmission_rate_limiter_;
+  std::unique_ptr<ModuleRtpRtcpImpl2> rtp_module_;
+};
+
+TEST_F(RtpSenderVideoPacketizationQueueTest, PacketizesOnTaskQueueInOrder) {
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithPacketizationQueue();
+
+  auto encoded_image = CreateDefaultEncodedImage();
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  EXPECT_TRUE(rtp_sender_video->SendEncodedImage(
+      kPayload, kType, kTimestamp, *encoded_image, video_header,
+      kDefaultExpectedRetransmissionTimeMs));
+  video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+  EXPECT_TRUE(rtp_sender_video->SendEncodedImage(
+      kPayload, kType, kTimestamp + 1, *encoded_image, video_header,
+      kDefaultExpectedRetransmissionTimeMs));
+  // Nothing is packetized on the calling thread.
+  EXPECT_EQ(transport_.packets_sent(), 0);
+
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(transport_.packets_sent(), 2);
+  EXPECT_EQ(transport_.last_sent_packet().Timestamp(), kTimestamp + 1);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 #include <utility>
 
@@ -21,6 +22,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/ref_counter.h"
 
 namespace webrtc {
 namespace {
@@ -324,8 +326,76 @@ bool CalculateObuSizes(ObuInfo* obu_info) {
   return true;
 }
 
+// Assembled frames are released by the decoder, typically within a few frames.
+constexpr size_t kMaxPooledBuffers = 8;
+
 }  // namespace
 
+// Buffer that keeps its allocation when it is shrunk, so that one sized for a
+// key frame can be reused for the delta frames that follow it.
+class VideoRtpDepacketizerAv1::PooledBuffer final : public EncodedImageBuffer {
+ public:
+  explicit PooledBuffer(size_t size)
+      : EncodedImageBuffer(size), capacity_(size), pooled_size_(size) {}
+
+  void AddRef() const override { ref_count_.IncRef(); }
+  rtc::RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+      delete this;
+    }
+    return status;
+  }
+
+  // Returns true when the pool holds the only reference.
+  bool IsFree() const { return ref_count_.HasOneRef(); }
+
+  // Contents are not preserved when the buffer grows.
+  void Resize(size_t size) {
+    if (size_ != pooled_size_) {
+      // The holder of the frame resized it with Realloc(), which leaves
+      // exactly size() bytes allocated.
+      capacity_ = size_;
+    }
+    RTC_DCHECK_GE(capacity_, size_);
+    if (size > capacity_) {
+      free(buffer_);
+      buffer_ = static_cast<uint8_t*>(malloc(size));
+      capacity_ = size;
+    }
+    size_ = size;
+    pooled_size_ = size;
+  }
+
+ private:
+  ~PooledBuffer() = default;
+
+  mutable webrtc_impl::RefCounter ref_count_{0};
+  size_t capacity_;
+  // size() as last set by the pool.
+  size_t pooled_size_;
+};
+
+VideoRtpDepacketizerAv1::VideoRtpDepacketizerAv1() = default;
+
+VideoRtpDepacketizerAv1::~VideoRtpDepacketizerAv1() = default;
+
+rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizerAv1::GetBuffer(
+    size_t size) {
+  for (const rtc::scoped_refptr<PooledBuffer>& buffer : buffer_pool_) {
+    if (buffer->IsFree()) {
+      buffer->Resize(size);
+      return buffer;
+    }
+  }
+  rtc::scoped_refptr<PooledBuffer> buffer =
+      rtc::scoped_refptr<PooledBuffer>(new PooledBuffer(size));
+  if (buffer_pool_.size() < kMaxPooledBuffers) {
+    buffer_pool_.push_back(buffer);
+  }
+  return buffer;
+}
+
 rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizerAv1::AssembleFrame(
     rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads) {
   VectorObuInfo obu_infos = ParseObus(rtp_payloads);
@@ -341,8 +411,7 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizerAv1::AssembleFrame(
     frame_size += (obu_info.prefix_size + obu_info.payload_size);
   }
 
-  rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-      EncodedImageBuffer::Create(frame_size);
+  rtc::scoped_refptr<EncodedImageBuffer> bitstream = GetBuffer(frame_size);
   uint8_t* write_at = bitstream->data();
   for (const ObuInfo& obu_info : obu_infos) {
     // Copy the obu_header and obu_size fields.
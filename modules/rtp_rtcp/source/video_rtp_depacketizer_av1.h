@@ -14,6 +14,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
@@ -25,17 +27,28 @@ namespace webrtc {
 
 class VideoRtpDepacketizerAv1 : public VideoRtpDepacketizer {
  public:
-  VideoRtpDepacketizerAv1() = default;
+  VideoRtpDepacketizerAv1();
   VideoRtpDepacketizerAv1(const VideoRtpDepacketizerAv1&) = delete;
   VideoRtpDepacketizerAv1& operator=(const VideoRtpDepacketizerAv1&) = delete;
-  ~VideoRtpDepacketizerAv1() override = default;
+  ~VideoRtpDepacketizerAv1() override;
 
+  // Assembles the frame into a buffer taken from a small pool, that is reused
+  // once the previously assembled frame it held has been released.
   rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
       rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads)
       override;
 
   absl::optional<ParsedRtpPayload> Parse(
       rtc::CopyOnWriteBuffer rtp_payload) override;
+
+ private:
+  class PooledBuffer;
+
+  // Returns a buffer of `size` bytes, reusing a released pooled buffer when
+  // there is one.
+  rtc::scoped_refptr<EncodedImageBuffer> GetBuffer(size_t size);
+
+  std::vector<rtc::scoped_refptr<PooledBuffer>> buffer_pool_;
 };
 
 }  // namespace webrtc
@@ -388,5 +388,56 @@ TEST(VideoRtpDepacketizerAv1Test,
               ElementsAre(0b0'0110'010, 3, 10, 20, 30));
 }
 
+TEST(VideoRtpDepacketizerAv1Test, ReusesBufferOfReleasedFrame) {
+  const uint8_t large_payload[] = {0b00'01'0000, 0b0'0110'000, 1, 2, 3, 4};
+  const uint8_t small_payload[] = {0b00'01'0000, 0b0'0110'000, 5};
+  rtc::ArrayView<const uint8_t> large[] = {large_payload};
+  rtc::ArrayView<const uint8_t> small[] = {small_payload};
+  VideoRtpDepacketizerAv1 depacketizer;
+
+  auto held_frame = depacketizer.AssembleFrame(large);
+  ASSERT_TRUE(held_frame);
+  const uint8_t* const held_data = held_frame->data();
+
+  // A frame that is still referenced is never overwritten.
+  auto frame = depacketizer.AssembleFrame(small);
+  ASSERT_TRUE(frame);
+  EXPECT_NE(frame->data(), held_data);
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(*held_frame),
+              ElementsAre(0b0'0110'010, 4, 1, 2, 3, 4));
+
+  // Once released, the larger buffer is reused for a smaller frame.
+  held_frame = nullptr;
+  frame = nullptr;
+  frame = depacketizer.AssembleFrame(small);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->data(), held_data);
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(*frame),
+              ElementsAre(0b0'0110'010, 1, 5));
+}
+
+TEST(VideoRtpDepacketizerAv1Test, RegrowsBufferShrunkByRealloc) {
+  const uint8_t large_payload[] = {0b00'01'0000, 0b0'0110'000, 1, 2, 3, 4};
+  const uint8_t small_payload[] = {0b00'01'0000, 0b0'0110'000, 5};
+  rtc::ArrayView<const uint8_t> large[] = {large_payload};
+  rtc::ArrayView<const uint8_t> small[] = {small_payload};
+  VideoRtpDepacketizerAv1 depacketizer;
+
+  auto frame = depacketizer.AssembleFrame(small);
+  ASSERT_TRUE(frame);
+  frame = nullptr;
+  // The pooled buffer keeps the capacity of the large frame...
+  frame = depacketizer.AssembleFrame(large);
+  ASSERT_TRUE(frame);
+  // ...until the holder of the frame shrinks the allocation.
+  frame->Realloc(2);
+  frame = nullptr;
+
+  frame = depacketizer.AssembleFrame(large);
+  ASSERT_TRUE(frame);
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(*frame),
+              ElementsAre(0b0'0110'010, 4, 1, 2, 3, 4));
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -23,7 +23,10 @@
 
 #include <new>
 #include <string>
+#include <vector>
 
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
@@ -31,6 +34,71 @@
 
 namespace webrtc {
 namespace videocapturemodule {
+
+class VideoCaptureModuleV4L2::MappedBuffers
+    : public rtc::RefCountedNonVirtual<MappedBuffers> {
+ public:
+  MappedBuffers(int device_fd, int count)
+      : device_fd_(device_fd), buffers_(count) {}
+  ~MappedBuffers() {
+    for (const Buffer& buffer : buffers_) {
+      if (buffer.start != MAP_FAILED)
+        munmap(buffer.start, buffer.length);
+    }
+  }
+
+  bool Map(const struct v4l2_buffer& buffer) {
+    Buffer& mapped = buffers_[buffer.index];
+    mapped.start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, device_fd_, buffer.m.offset);
+    mapped.length = buffer.length;
+    return mapped.start != MAP_FAILED;
+  }
+
+  uint8_t* data(int index) const {
+    return static_cast<uint8_t*>(buffers_[index].start);
+  }
+
+  // Hands a dequeued buffer to a frame, unless that would leave the driver
+  // with fewer than `min_queued` buffers.
+  bool Hold(int min_queued) {
+    MutexLock lock(&lock_);
+    if (static_cast<int>(buffers_.size()) - held_ - 1 < min_queued)
+      return false;
+    ++held_;
+    return true;
+  }
+
+  // Called when the frame holding `buffer` is released, possibly on another
+  // thread.
+  void Requeue(struct v4l2_buffer buffer) {
+    MutexLock lock(&lock_);
+    --held_;
+    if (!stopped_ && ioctl(device_fd_, VIDIOC_QBUF, &buffer) == -1) {
+      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    }
+  }
+
+  // Must be called before the device is closed; buffers released after that
+  // aren't queued again.
+  void Stop() {
+    MutexLock lock(&lock_);
+    stopped_ = true;
+  }
+
+ private:
+  struct Buffer {
+    void* start = MAP_FAILED;
+    size_t length = 0;
+  };
+
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  Mutex lock_;
+  int held_ RTC_GUARDED_BY(lock_) = 0;
+  bool stopped_ RTC_GUARDED_BY(lock_) = false;
+};
+
 VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
       _deviceId(-1),
@@ -40,8 +108,7 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
       _currentHeight(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
-      _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _captureVideoType(VideoType::kI420) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -298,7 +365,7 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
   _buffersAllocatedByDevice = rbuffer.count;
 
   // Map the buffers
-  _pool = new Buffer[rbuffer.count];
+  _pool = rtc::make_ref_counted<MappedBuffers>(_deviceFd, rbuffer.count);
 
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
@@ -311,17 +378,11 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
       return false;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
+    if (!_pool->Map(buffer)) {
+      _pool = nullptr;
       return false;
     }
 
-    _pool[i].length = buffer.length;
-
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
       return false;
     }
@@ -330,11 +391,11 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // The buffers are unmapped once the frames still holding them are released.
+  if (_pool) {
+    _pool->Stop();
+    _pool = nullptr;
+  }
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -399,12 +460,18 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
       frameInfo.height = _currentHeight;
       frameInfo.videoType = _captureVideoType;
 
-      // convert to to I420 if needed
-      IncomingFrame(reinterpret_cast<uint8_t*>(_pool[buf.index].start),
-                    buf.bytesused, frameInfo);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      if (_pool->Hold(kMinQueuedV4L2Buffers)) {
+        // NV12 and YUYV frames are delivered in place, and the buffer is
+        // enqueued again when released.
+        IncomingFrame(_pool->data(buf.index), buf.bytesused, frameInfo,
+                      [pool = _pool, buf] { pool->Requeue(buf); });
+      } else {
+        // convert to to I420 if needed
+        IncomingFrame(_pool->data(buf.index), buf.bytesused, frameInfo);
+        // enqueue the buffer again
+        if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
+          RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+        }
       }
     }
   }
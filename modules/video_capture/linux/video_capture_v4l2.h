@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/platform_thread.h"
@@ -34,7 +35,14 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t CaptureSettings(VideoCaptureCapability& settings) override;
 
  private:
-  enum { kNoOfV4L2Bufffers = 4 };
+  enum { kNoOfV4L2Bufffers = 6 };
+  // Frames are only delivered without a copy while the driver is left with at
+  // least this many buffers to capture into.
+  enum { kMinQueuedV4L2Buffers = 2 };
+
+  // The mapped buffers. They are shared with the frames delivered without a
+  // copy, and outlive the capture if those frames do.
+  class MappedBuffers;
 
   static void CaptureThread(void*);
   bool CaptureProcess();
@@ -53,11 +61,7 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  rtc::scoped_refptr<MappedBuffers> _pool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
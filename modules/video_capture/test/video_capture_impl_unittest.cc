@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/video_capture_impl.h"
+
+#include <utility>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video/video_sink_interface.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+namespace {
+
+constexpr int kWidth = 4;
+constexpr int kHeight = 2;
+
+// Hands out frames from buffers it owns, like the V4L2 capturer hands out its
+// mapped buffers, and tracks which ones are still held by frames.
+class FakeBufferCapturer : public VideoCaptureImpl {
+ public:
+  FakeBufferCapturer() : buffers_(2), held_(2, false) {}
+
+  // Fills buffer `index` with a `type` frame and delivers it.
+  void Capture(int index, VideoType type, const std::vector<uint8_t>& pixels) {
+    buffers_[index] = pixels;
+    held_[index] = true;
+    VideoCaptureCapability frame_info;
+    frame_info.width = kWidth;
+    frame_info.height = kHeight;
+    frame_info.videoType = type;
+    auto release = [this, index] { held_[index] = false; };
+    EXPECT_EQ(IncomingFrame(buffers_[index].data(), buffers_[index].size(),
+                            frame_info, std::move(release)),
+              0);
+  }
+
+  const uint8_t* buffer(int index) const { return buffers_[index].data(); }
+  bool held(int index) const { return held_[index]; }
+
+ private:
+  std::vector<std::vector<uint8_t>> buffers_;
+  std::vector<bool> held_;
+};
+
+class FrameSink : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void OnFrame(const VideoFrame& frame) override { frames_.push_back(frame); }
+
+  std::vector<VideoFrame>& frames() { return frames_; }
+
+ private:
+  std::vector<VideoFrame> frames_;
+};
+
+// A 4x2 NV12 frame: Y 0..7, then U/V pairs (100, 200) and (101, 201).
+std::vector<uint8_t> Nv12Pixels() {
+  return {0, 1, 2, 3, 4, 5, 6, 7, 100, 200, 101, 201};
+}
+
+// A 4x2 YUY2 frame, with the same chroma in both rows.
+std::vector<uint8_t> Yuy2Pixels() {
+  return {0, 100, 1, 200, 2, 101, 3, 201,  //
+          4, 100, 5, 200, 6, 101, 7, 201};
+}
+
+class VideoCaptureImplTest : public ::testing::Test {
+ protected:
+  VideoCaptureImplTest()
+      : capturer_(rtc::make_ref_counted<FakeBufferCapturer>()) {
+    capturer_->RegisterCaptureDataCallback(&sink_);
+  }
+
+  rtc::scoped_refptr<FakeBufferCapturer> capturer_;
+  // Destroyed first, so that the frames it keeps release their buffers.
+  FrameSink sink_;
+};
+
+TEST_F(VideoCaptureImplTest, DeliversNV12WithoutCopy) {
+  capturer_->Capture(0, VideoType::kNV12, Nv12Pixels());
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+      sink_.frames()[0].video_frame_buffer();
+  ASSERT_EQ(buffer->type(), VideoFrameBuffer::Type::kNV12);
+  const NV12BufferInterface* nv12 = buffer->GetNV12();
+  EXPECT_EQ(nv12->DataY(), capturer_->buffer(0));
+  EXPECT_EQ(nv12->DataUV(), capturer_->buffer(0) + kWidth * kHeight);
+  EXPECT_EQ(nv12->StrideUV(), kWidth);
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(i420->DataY()[kWidth + 1], 5);
+  EXPECT_EQ(i420->DataU()[1], 101);
+  EXPECT_EQ(i420->DataV()[0], 200);
+
+  // The buffer goes back to the capturer with the last reference.
+  EXPECT_TRUE(capturer_->held(0));
+  sink_.frames().clear();
+  EXPECT_TRUE(capturer_->held(0));
+  buffer = nullptr;
+  i420 = nullptr;
+  EXPECT_FALSE(capturer_->held(0));
+}
+
+TEST_F(VideoCaptureImplTest, SplitsYUY2IntoI422Planes) {
+  capturer_->Capture(0, VideoType::kYUY2, Yuy2Pixels());
+  EXPECT_FALSE(capturer_->held(0));
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+      sink_.frames()[0].video_frame_buffer();
+  ASSERT_EQ(buffer->type(), VideoFrameBuffer::Type::kI422);
+  const I422BufferInterface* i422 = buffer->GetI422();
+  EXPECT_EQ(i422->width(), kWidth);
+  EXPECT_EQ(i422->height(), kHeight);
+  EXPECT_EQ(i422->DataY()[i422->StrideY() + 2], 6);
+  EXPECT_EQ(i422->DataU()[i422->StrideU() + 1], 101);
+  EXPECT_EQ(i422->DataV()[1], 201);
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(i420->DataY()[kWidth + 2], 6);
+  EXPECT_EQ(i420->DataU()[1], 101);
+  EXPECT_EQ(i420->DataV()[1], 201);
+}
+
+TEST_F(VideoCaptureImplTest, HoldsBuffersOfAllFramesInUse) {
+  capturer_->Capture(0, VideoType::kNV12, Nv12Pixels());
+  capturer_->Capture(1, VideoType::kNV12, Nv12Pixels());
+  EXPECT_TRUE(capturer_->held(0));
+  EXPECT_TRUE(capturer_->held(1));
+  sink_.frames().erase(sink_.frames().begin());
+  EXPECT_FALSE(capturer_->held(0));
+  EXPECT_TRUE(capturer_->held(1));
+}
+
+TEST_F(VideoCaptureImplTest, CopiesFrameToRotate) {
+  capturer_->SetCaptureRotation(kVideoRotation_90);
+  capturer_->SetApplyRotation(true);
+  capturer_->Capture(0, VideoType::kNV12, Nv12Pixels());
+  EXPECT_FALSE(capturer_->held(0));
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].video_frame_buffer()->type(),
+            VideoFrameBuffer::Type::kI420);
+  EXPECT_EQ(sink_.frames()[0].width(), kHeight);
+  EXPECT_EQ(sink_.frames()[0].rotation(), kVideoRotation_0);
+}
+
+TEST_F(VideoCaptureImplTest, LeavesRotationToSinksWithoutCopy) {
+  capturer_->SetCaptureRotation(kVideoRotation_90);
+  capturer_->Capture(0, VideoType::kNV12, Nv12Pixels());
+  EXPECT_TRUE(capturer_->held(0));
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].rotation(), kVideoRotation_90);
+}
+
+TEST_F(VideoCaptureImplTest, CopiesOtherFormats) {
+  capturer_->Capture(0, VideoType::kI420,
+                     std::vector<uint8_t>(
+                         CalcBufferSize(VideoType::kI420, kWidth, kHeight)));
+  EXPECT_FALSE(capturer_->held(0));
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].video_frame_buffer()->type(),
+            VideoFrameBuffer::Type::kI420);
+}
+
+}  // namespace
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -13,7 +13,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <utility>
+
+#include "api/make_ref_counted.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/i422_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_capture/video_capture_config.h"
@@ -25,6 +29,48 @@
 namespace webrtc {
 namespace videocapturemodule {
 
+namespace {
+
+// An NV12 frame in a buffer owned by the capturer.
+class CapturedNV12Buffer : public NV12BufferInterface {
+ public:
+  CapturedNV12Buffer(const uint8_t* data,
+                     int width,
+                     int height,
+                     absl::AnyInvocable<void() &&> release)
+      : data_(data),
+        width_(width),
+        height_(height),
+        release_(std::move(release)) {}
+  ~CapturedNV12Buffer() override { std::move(release_)(); }
+
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  int StrideY() const override { return width_; }
+  int StrideUV() const override { return ChromaWidth() * 2; }
+  const uint8_t* DataY() const override { return data_; }
+  const uint8_t* DataUV() const override { return data_ + width_ * height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    rtc::scoped_refptr<I420Buffer> i420_buffer =
+        I420Buffer::Create(width_, height_);
+    libyuv::NV12ToI420(DataY(), StrideY(), DataUV(), StrideUV(),
+                       i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                       i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                       i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                       width_, height_);
+    return i420_buffer;
+  }
+
+ private:
+  const uint8_t* const data_;
+  const int width_;
+  const int height_;
+  absl::AnyInvocable<void() &&> release_;
+};
+
+}  // namespace
+
 const char* VideoCaptureImpl::CurrentDeviceName() const {
   return _deviceUniqueId;
 }
@@ -224,6 +270,63 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
+                                        size_t videoFrameLength,
+                                        const VideoCaptureCapability& frameInfo,
+                                        absl::AnyInvocable<void() &&> release,
+                                        int64_t captureTime /*=0*/) {
+  {
+    MutexLock lock(&api_lock_);
+
+    // Raw sinks get the bytes only for the duration of the call, and rotating
+    // needs a new buffer anyway.
+    const bool can_wrap =
+        !_rawDataCallBack &&
+        (!apply_rotation_ || _rotateFrame == kVideoRotation_0) &&
+        frameInfo.height > 0 &&
+        (frameInfo.videoType == VideoType::kNV12 ||
+         frameInfo.videoType == VideoType::kYUY2) &&
+        CalcBufferSize(frameInfo.videoType, frameInfo.width,
+                       frameInfo.height) == videoFrameLength;
+    if (can_wrap) {
+      TRACE_EVENT1("webrtc", "VC::IncomingFrame", "capture_time", captureTime);
+      rtc::scoped_refptr<VideoFrameBuffer> buffer;
+      if (frameInfo.videoType == VideoType::kNV12) {
+        buffer = rtc::make_ref_counted<CapturedNV12Buffer>(
+            videoFrame, frameInfo.width, frameInfo.height, std::move(release));
+      } else {
+        // Packed YUY2 can't be wrapped as a planar buffer, but splitting it
+        // into I422 planes keeps the full chroma, and the capture buffer can
+        // go back to the driver right away.
+        rtc::scoped_refptr<I422Buffer> i422_buffer =
+            I422Buffer::Create(frameInfo.width, frameInfo.height);
+        libyuv::YUY2ToI422(videoFrame, frameInfo.width * 2,
+                           i422_buffer->MutableDataY(), i422_buffer->StrideY(),
+                           i422_buffer->MutableDataU(), i422_buffer->StrideU(),
+                           i422_buffer->MutableDataV(), i422_buffer->StrideV(),
+                           frameInfo.width, frameInfo.height);
+        std::move(release)();
+        buffer = std::move(i422_buffer);
+      }
+      VideoFrame captureFrame = VideoFrame::Builder()
+                                    .set_video_frame_buffer(buffer)
+                                    .set_timestamp_rtp(0)
+                                    .set_timestamp_ms(rtc::TimeMillis())
+                                    .set_rotation(_rotateFrame)
+                                    .build();
+      captureFrame.set_ntp_time_ms(captureTime);
+
+      DeliverCapturedFrame(captureFrame);
+      return 0;
+    }
+  }
+
+  const int32_t result =
+      IncomingFrame(videoFrame, videoFrameLength, frameInfo, captureTime);
+  std::move(release)();
+  return result;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   _requestedCapability = capability;
@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "absl/functional/any_invocable.h"
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_rotation.h"
@@ -76,6 +77,19 @@ class RTC_EXPORT VideoCaptureImpl : public VideoCaptureModule {
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
 
+  // Delivers a frame that stays in a buffer owned by the capturer, such as a
+  // mapped V4L2 buffer. NV12 frames are wrapped without a copy and only
+  // converted to I420 if a sink asks for it; `release` is called, on any
+  // thread, once the last reference to the frame is dropped. YUY2 frames are
+  // split into an I422 buffer. Those, other frames, and frames that are
+  // delivered raw or rotated by the module, are converted right away and
+  // `release` is called before this returns.
+  int32_t IncomingFrame(uint8_t* videoFrame,
+                        size_t videoFrameLength,
+                        const VideoCaptureCapability& frameInfo,
+                        absl::AnyInvocable<void() &&> release,
+                        int64_t captureTime = 0);
+
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
   int32_t StopCapture() override;
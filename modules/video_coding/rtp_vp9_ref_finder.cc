@@ -16,6 +16,28 @@
 #include "rtc_base/logging.h"
 
 namespace webrtc {
+namespace {
+
+// Returns the TL0 picture index whose GOF info is needed to find the
+// references of a non-flexible mode frame.
+int64_t RequiredGofInfoTl0(const RtpFrameObject& frame,
+                           const RTPVideoHeaderVP9& codec_header,
+                           int64_t unwrapped_tl0) {
+  if (!codec_header.ss_data_available &&
+      frame.frame_type() != VideoFrameType::kVideoFrameKey &&
+      codec_header.temporal_idx == 0) {
+    return unwrapped_tl0 - 1;
+  }
+  return unwrapped_tl0;
+}
+
+size_t GofInfoIndex(int64_t unwrapped_tl0, size_t ring_size) {
+  int64_t index = unwrapped_tl0 % static_cast<int64_t>(ring_size);
+  return static_cast<size_t>(index < 0 ? index + ring_size : index);
+}
+
+}  // namespace
+
 RtpFrameReferenceFinder::ReturnVector RtpVp9RefFinder::ManageFrame(
     std::unique_ptr<RtpFrameObject> frame) {
   const RTPVideoHeaderVP9& codec_header = absl::get<RTPVideoHeaderVP9>(
@@ -49,6 +71,7 @@ RtpFrameReferenceFinder::ReturnVector RtpVp9RefFinder::ManageFrame(
 
         stashed_frames_.push_front(
             {.unwrapped_tl0 = unwrapped_tl0, .frame = std::move(frame)});
+        SetStashReason(stashed_frames_.front());
       }
     }
   }
@@ -115,17 +138,17 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->Id();
-      gof_info_.emplace(
+      // Stashed frames may refer to the structure that was just replaced.
+      ++missing_frames_version_;
+      EmplaceGofInfo(
           unwrapped_tl0,
           GofInfo(&scalability_structures_[current_ss_idx_], frame->Id()));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (info == nullptr)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->Id(), info);
@@ -137,38 +160,30 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (info == nullptr)
       return kStash;
 
-    info = &gof_info_it->second;
-
     frame->num_references = 0;
     FrameReceivedVp9(frame->Id(), info);
     FlattenFrameIdAndRefs(frame, codec_header.inter_layer_predicted);
     return kHandOff;
   } else {
-    auto gof_info_it = gof_info_.find(
+    info = FindGofInfo(
         (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (info == nullptr)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0,
-                                 GofInfo(gof_info_it->second.gof, frame->Id()))
-                        .first;
+      info = EmplaceGofInfo(unwrapped_tl0, GofInfo(info->gof, frame->Id()));
     }
-
-    info = &gof_info_it->second;
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  min_gof_info_tl0_ =
+      std::max(min_gof_info_tl0_, unwrapped_tl0 - kMaxGofSaved);
 
   FrameReceivedVp9(frame->Id(), info);
 
@@ -291,7 +306,9 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
       return;
     }
 
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    if (missing_frames_for_layer_[temporal_idx].erase(picture_id) > 0) {
+      ++missing_frames_version_;
+    }
   }
 }
 
@@ -315,6 +332,12 @@ void RtpVp9RefFinder::RetryStashedFrames(
   do {
     complete_frame = false;
     for (auto it = stashed_frames_.begin(); it != stashed_frames_.end();) {
+      // Only frames whose missing information may have arrived since they
+      // were stashed are looked at again.
+      if (!MayHandOffStashedFrame(*it)) {
+        ++it;
+        continue;
+      }
       const RTPVideoHeaderVP9& codec_header = absl::get<RTPVideoHeaderVP9>(
           it->frame->GetRtpVideoHeader().video_type_header);
       RTC_DCHECK(!codec_header.flexible_mode);
@@ -323,6 +346,7 @@ void RtpVp9RefFinder::RetryStashedFrames(
 
       switch (decision) {
         case kStash:
+          SetStashReason(*it);
           ++it;
           break;
         case kHandOff:
@@ -336,6 +360,61 @@ void RtpVp9RefFinder::RetryStashedFrames(
   } while (complete_frame);
 }
 
+void RtpVp9RefFinder::SetStashReason(UnwrappedTl0Frame& stashed_frame) const {
+  const RTPVideoHeaderVP9& codec_header = absl::get<RTPVideoHeaderVP9>(
+      stashed_frame.frame->GetRtpVideoHeader().video_type_header);
+  int64_t gof_info_tl0 = RequiredGofInfoTl0(
+      *stashed_frame.frame, codec_header, stashed_frame.unwrapped_tl0);
+  if (FindGofInfo(gof_info_tl0) == nullptr) {
+    stashed_frame.waiting_for_tl0 = gof_info_tl0;
+  } else {
+    stashed_frame.waiting_for_tl0 = absl::nullopt;
+  }
+  stashed_frame.missing_frames_version = missing_frames_version_;
+}
+
+bool RtpVp9RefFinder::MayHandOffStashedFrame(
+    const UnwrappedTl0Frame& stashed_frame) const {
+  if (stashed_frame.waiting_for_tl0) {
+    return FindGofInfo(*stashed_frame.waiting_for_tl0) != nullptr;
+  }
+  return stashed_frame.missing_frames_version != missing_frames_version_;
+}
+
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::FindGofInfo(int64_t unwrapped_tl0) {
+  return const_cast<GofInfo*>(
+      static_cast<const RtpVp9RefFinder*>(this)->FindGofInfo(unwrapped_tl0));
+}
+
+const RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::FindGofInfo(
+    int64_t unwrapped_tl0) const {
+  if (unwrapped_tl0 < min_gof_info_tl0_) {
+    return nullptr;
+  }
+  const GofInfoSlot& slot =
+      gof_info_[GofInfoIndex(unwrapped_tl0, gof_info_.size())];
+  if (!slot.valid || slot.unwrapped_tl0 != unwrapped_tl0) {
+    return nullptr;
+  }
+  return &slot.info;
+}
+
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::EmplaceGofInfo(
+    int64_t unwrapped_tl0,
+    const GofInfo& info) {
+  GofInfo* existing_info = FindGofInfo(unwrapped_tl0);
+  if (existing_info != nullptr) {
+    return existing_info;
+  }
+  // Any info this replaces is older than `kMaxGofSaved` TL0 picture indices,
+  // and would have been cleaned up already.
+  GofInfoSlot& slot = gof_info_[GofInfoIndex(unwrapped_tl0, gof_info_.size())];
+  slot.valid = true;
+  slot.unwrapped_tl0 = unwrapped_tl0;
+  slot.info = info;
+  return &slot.info;
+}
+
 void RtpVp9RefFinder::FlattenFrameIdAndRefs(RtpFrameObject* frame,
                                             bool inter_layer_predicted) {
   for (size_t i = 0; i < frame->num_references; ++i) {
@@ -11,12 +11,15 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 
+#include <array>
 #include <deque>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 #include "modules/rtp_rtcp/source/frame_object.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
@@ -42,15 +45,27 @@ class RtpVp9RefFinder {
   enum FrameDecision { kStash, kHandOff, kDrop };
 
   struct GofInfo {
+    GofInfo() = default;
     GofInfo(GofInfoVP9* gof, uint16_t last_picture_id)
         : gof(gof), last_picture_id(last_picture_id) {}
-    GofInfoVP9* gof;
-    uint16_t last_picture_id;
+    GofInfoVP9* gof = nullptr;
+    uint16_t last_picture_id = 0;
+  };
+
+  struct GofInfoSlot {
+    bool valid = false;
+    int64_t unwrapped_tl0 = 0;
+    GofInfo info;
   };
 
   struct UnwrappedTl0Frame {
     int64_t unwrapped_tl0;
     std::unique_ptr<RtpFrameObject> frame;
+    // What the frame is waiting for: the GOF info of `waiting_for_tl0` if
+    // set, otherwise the arrival of a frame it implicitly depends on.
+    absl::optional<int64_t> waiting_for_tl0;
+    // `missing_frames_version_` when the frame was last stashed.
+    uint64_t missing_frames_version = 0;
   };
 
   FrameDecision ManageFrameFlexible(RtpFrameObject* frame,
@@ -59,6 +74,16 @@ class RtpVp9RefFinder {
                                const RTPVideoHeaderVP9& vp9_header,
                                int64_t unwrapped_tl0);
   void RetryStashedFrames(RtpFrameReferenceFinder::ReturnVector& res);
+  // Records why `stashed_frame` could not be handed off, so that it is only
+  // retried once that may have changed.
+  void SetStashReason(UnwrappedTl0Frame& stashed_frame) const;
+  bool MayHandOffStashedFrame(const UnwrappedTl0Frame& stashed_frame) const;
+
+  GofInfo* FindGofInfo(int64_t unwrapped_tl0);
+  const GofInfo* FindGofInfo(int64_t unwrapped_tl0) const;
+  // Like std::map::emplace, keeps the info already stored for
+  // `unwrapped_tl0`, if any.
+  GofInfo* EmplaceGofInfo(int64_t unwrapped_tl0, const GofInfo& info);
 
   bool MissingRequiredFrameVp9(uint16_t picture_id, const GofInfo& info);
 
@@ -80,8 +105,12 @@ class RtpVp9RefFinder {
   // Holds received scalability structures.
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
-  // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  // Holds the the Gof information for a given unwrapped TL0 picture index,
+  // for the `kMaxGofSaved` indices preceding the most recent one. Indexed by
+  // the unwrapped TL0 picture index modulo the size of the ring.
+  std::array<GofInfoSlot, kMaxGofSaved + 1> gof_info_;
+  // Gof info for TL0 picture indices below this is considered cleaned up.
+  int64_t min_gof_info_tl0_ = std::numeric_limits<int64_t>::min();
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
@@ -92,6 +121,9 @@ class RtpVp9RefFinder {
   std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>,
              kMaxTemporalLayers>
       missing_frames_for_layer_;
+  // Incremented whenever a frame is removed from `missing_frames_for_layer_`
+  // or a scalability structure is replaced.
+  uint64_t missing_frames_version_ = 0;
 
   // Unwrapper used to unwrap VP8/VP9 streams which have their picture id
   // specified.
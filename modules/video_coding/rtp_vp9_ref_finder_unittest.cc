@@ -407,6 +407,27 @@ TEST_F(RtpVp9RefFinderTest, GofTemporalLayersReordered_01) {
   EXPECT_THAT(frames_, HasFrameWithIdAndRefs(45, {40}));
 }
 
+TEST_F(RtpVp9RefFinderTest, GofTemporalLayersReorderedTl0Wrap) {
+  GofInfoVP9 ss;
+  ss.SetGofInfoVP9(kTemporalStructureMode2);  // 01 pattern
+
+  Insert(Frame().Pid(0).SidAndTid(0, 0).Tl0(0).AsKeyFrame().NotAsInterPic().Gof(
+      &ss));
+  // Every TL1 frame arrives before the TL0 frame it depends on, for long
+  // enough for the TL0 picture index to wrap.
+  for (int pid = 2; pid < 600; pid += 2) {
+    Insert(Frame().Pid(pid + 1).SidAndTid(0, 1).Tl0((pid / 2) % 256));
+    Insert(Frame().Pid(pid).SidAndTid(0, 0).Tl0((pid / 2) % 256));
+  }
+
+  ASSERT_EQ(599UL, frames_.size());
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs(0, {}));
+  for (int pid = 2; pid < 600; pid += 2) {
+    EXPECT_THAT(frames_, HasFrameWithIdAndRefs(pid * 5, {(pid - 2) * 5}));
+    EXPECT_THAT(frames_, HasFrameWithIdAndRefs((pid + 1) * 5, {pid * 5}));
+  }
+}
+
 TEST_F(RtpVp9RefFinderTest, GofTemporalLayers_0212) {
   GofInfoVP9 ss;
   ss.SetGofInfoVP9(kTemporalStructureMode3);  // 0212 pattern
@@ -39,13 +39,13 @@ void DecodeTimePercentileFilter::AddTiming(int64_t decode_time_ms,
 
   // Insert new decode time value.
   filter_.Insert(decode_time_ms);
-  history_.emplace(decode_time_ms, now_ms);
+  history_.push_back({decode_time_ms, now_ms});
 
   // Pop old decode time values.
   while (!history_.empty() &&
          now_ms - history_.front().sample_time_ms > kTimeLimitMs) {
     filter_.Erase(history_.front().decode_time_ms);
-    history_.pop();
+    history_.pop_front();
   }
 }
 
@@ -54,8 +54,4 @@ int64_t DecodeTimePercentileFilter::RequiredDecodeTimeMs() const {
   return filter_.GetPercentileValue();
 }
 
-DecodeTimePercentileFilter::Sample::Sample(int64_t decode_time_ms,
-                                           int64_t sample_time_ms)
-    : decode_time_ms(decode_time_ms), sample_time_ms(sample_time_ms) {}
-
 }  // namespace webrtc
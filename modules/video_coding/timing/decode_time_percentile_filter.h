@@ -11,8 +11,9 @@
 #ifndef MODULES_VIDEO_CODING_TIMING_DECODE_TIME_PERCENTILE_FILTER_H_
 #define MODULES_VIDEO_CODING_TIMING_DECODE_TIME_PERCENTILE_FILTER_H_
 
-#include <queue>
+#include <stdint.h>
 
+#include "rtc_base/containers/ring_deque.h"
 #include "rtc_base/numerics/percentile_filter.h"
 
 namespace webrtc {
@@ -35,15 +36,14 @@ class DecodeTimePercentileFilter {
 
  private:
   struct Sample {
-    Sample(int64_t decode_time_ms, int64_t sample_time_ms);
-    int64_t decode_time_ms;
-    int64_t sample_time_ms;
+    int64_t decode_time_ms = 0;
+    int64_t sample_time_ms = 0;
   };
 
   // The number of samples ignored so far.
   int ignored_sample_count_;
   // Queue with history of latest decode time values.
-  std::queue<Sample> history_;
+  RingDeque<Sample> history_;
   // `filter_` contains the same values as `history_`, but in a data structure
   // that allows efficient retrieval of the percentile value.
   PercentileFilter<int64_t> filter_;
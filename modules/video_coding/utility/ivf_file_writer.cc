@@ -201,6 +201,34 @@ bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
   }
 }
 
+bool IvfFileWriter::WriteFrame(const RecordableEncodedFrame& frame) {
+  if (!file_.is_open())
+    return false;
+
+  if (num_frames_ == 0) {
+    // Only the resolution and the timestamps are used from the first frame.
+    EncodedImage first_frame;
+    first_frame._encodedWidth = frame.resolution().width;
+    first_frame._encodedHeight = frame.resolution().height;
+    first_frame.SetTimestamp(0);
+    if (!InitFromFirstFrame(first_frame, frame.codec()))
+      return false;
+  }
+  RTC_DCHECK_EQ(codec_type_, frame.codec());
+  RTC_DCHECK(using_capture_timestamps_);
+
+  int64_t timestamp = frame.render_time().ms();
+  if (last_timestamp_ != -1 && timestamp <= last_timestamp_) {
+    RTC_LOG(LS_WARNING) << "Timestamp no increasing: " << last_timestamp_
+                        << " -> " << timestamp;
+  }
+  last_timestamp_ = timestamp;
+
+  rtc::scoped_refptr<const EncodedImageBufferInterface> buffer =
+      frame.encoded_buffer();
+  return WriteOneSpatialLayer(timestamp, buffer->data(), buffer->size());
+}
+
 bool IvfFileWriter::WriteOneSpatialLayer(int64_t timestamp,
                                          const uint8_t* data,
                                          size_t size) {
@@ -17,6 +17,7 @@
 #include <memory>
 
 #include "api/video/encoded_image.h"
+#include "api/video/recordable_encoded_frame.h"
 #include "api/video/video_codec_type.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 #include "rtc_base/system/file_wrapper.h"
@@ -37,6 +38,10 @@ class IvfFileWriter {
   IvfFileWriter& operator=(const IvfFileWriter&) = delete;
 
   bool WriteFrame(const EncodedImage& encoded_image, VideoCodecType codec_type);
+  // Writes a frame recorded from a receive stream, see
+  // VideoReceiveStreamInterface::SetAndGetRecordingState(). Such frames only
+  // carry a render time, which is written with a 1 kHz clock.
+  bool WriteFrame(const RecordableEncodedFrame& frame);
   bool Close();
 
  private:
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/async_dns_resolver_cache.h"
+
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+class AsyncDnsResolverCache::Resolver final : public AsyncDnsResolverInterface,
+                                              public AsyncDnsResolverResult {
+ public:
+  explicit Resolver(rtc::scoped_refptr<AsyncDnsResolverCache> cache)
+      : cache_(std::move(cache)) {}
+
+  void Start(const rtc::SocketAddress& addr,
+             std::function<void()> callback) override {
+    Start(addr, AF_UNSPEC, std::move(callback));
+  }
+
+  void Start(const rtc::SocketAddress& addr,
+             int family,
+             std::function<void()> callback) override {
+    RTC_DCHECK(!callback_);
+    addr_ = addr;
+    callback_ = std::move(callback);
+    absl::optional<Addresses> addresses = cache_->Resolve(
+        addr, family,
+        [this, flag = safety_.flag()](const Addresses& addresses) {
+          if (flag->alive()) {
+            OnResolved(addresses);
+          }
+        });
+    if (addresses) {
+      // Callers don't expect the callback before Start() returns.
+      TaskQueueBase::Current()->PostTask(
+          SafeTask(safety_.flag(),
+                   [this, addresses = *addresses] { OnResolved(addresses); }));
+    }
+  }
+
+  const AsyncDnsResolverResult& result() const override { return *this; }
+
+  bool GetResolvedAddress(int family, rtc::SocketAddress* addr) const override {
+    const absl::optional<rtc::IPAddress>& ip =
+        family == AF_INET ? addresses_.ipv4 : addresses_.ipv6;
+    if (!ip || (family != AF_INET && family != AF_INET6)) {
+      return false;
+    }
+    *addr = addr_;
+    addr->SetResolvedIP(*ip);
+    return true;
+  }
+
+  int GetError() const override { return addresses_.error; }
+
+ private:
+  void OnResolved(const Addresses& addresses) {
+    addresses_ = addresses;
+    // May destroy `this`.
+    callback_();
+  }
+
+  const rtc::scoped_refptr<AsyncDnsResolverCache> cache_;
+  rtc::SocketAddress addr_;
+  std::function<void()> callback_;
+  Addresses addresses_;
+  ScopedTaskSafety safety_;
+};
+
+AsyncDnsResolverCache::AsyncDnsResolverCache(ResolverFactory factory,
+                                             TimeDelta ttl)
+    : factory_(std::move(factory)), ttl_(ttl) {
+  sequence_checker_.Detach();
+}
+
+AsyncDnsResolverCache::~AsyncDnsResolverCache() = default;
+
+std::unique_ptr<AsyncDnsResolverInterface>
+AsyncDnsResolverCache::CreateResolver() {
+  return std::make_unique<Resolver>(rtc::scoped_refptr<AsyncDnsResolverCache>(
+      this));
+}
+
+size_t AsyncDnsResolverCache::size_for_testing() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return entries_.size();
+}
+
+absl::optional<AsyncDnsResolverCache::Addresses> AsyncDnsResolverCache::Resolve(
+    const rtc::SocketAddress& addr,
+    int family,
+    std::function<void(const Addresses&)> waiter) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const int64_t now_ms = rtc::TimeMillis();
+  Key key(addr.hostname(), family);
+  auto entry = entries_.find(key);
+  if (entry != entries_.end()) {
+    if (now_ms < entry->second.expires_ms) {
+      return entry->second.addresses;
+    }
+    entries_.erase(entry);
+  }
+
+  Query& query = queries_[key];
+  query.waiters.push_back(std::move(waiter));
+  if (!query.resolver) {
+    query.resolver = factory_();
+    auto callback = [this, key] { OnQueryDone(key); };
+    if (family == AF_UNSPEC) {
+      query.resolver->Start(addr, std::move(callback));
+    } else {
+      query.resolver->Start(addr, family, std::move(callback));
+    }
+  }
+  return absl::nullopt;
+}
+
+void AsyncDnsResolverCache::OnQueryDone(const Key& key) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = queries_.find(key);
+  RTC_DCHECK(it != queries_.end());
+  Query query = std::move(it->second);
+  queries_.erase(it);
+
+  Addresses addresses;
+  const AsyncDnsResolverResult& result = query.resolver->result();
+  rtc::SocketAddress resolved;
+  if (result.GetResolvedAddress(AF_INET, &resolved)) {
+    addresses.ipv4 = resolved.ipaddr();
+  }
+  if (result.GetResolvedAddress(AF_INET6, &resolved)) {
+    addresses.ipv6 = resolved.ipaddr();
+  }
+  addresses.error = result.GetError();
+  if (addresses.error == 0 && (addresses.ipv4 || addresses.ipv6)) {
+    entries_[key] = {addresses, rtc::TimeMillis() + ttl_.ms()};
+  }
+
+  // Resolvers can't be destroyed from within their callback.
+  TaskQueueBase::Current()->PostTask(
+      [resolver = std::move(query.resolver)] {});
+  // The waiters may start new resolutions.
+  for (auto& waiter : query.waiters) {
+    waiter(addresses);
+  }
+}
+
+}  // namespace webrtc
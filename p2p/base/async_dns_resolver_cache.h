@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ASYNC_DNS_RESOLVER_CACHE_H_
+#define P2P_BASE_ASYNC_DNS_RESOLVER_CACHE_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/async_dns_resolver.h"
+#include "api/ref_counted_base.h"
+#include "api/sequence_checker.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares the results of hostname resolutions between the resolvers it
+// creates for a limited time. The STUN and TURN ports of every network and
+// every session resolve the same few server hostnames; with a cache shared by
+// all of them, only the first resolver of a hostname queries DNS, and the
+// ones started while that query is outstanding wait for its result.
+//
+// Failed resolutions are not cached. Must be used on a single sequence.
+class AsyncDnsResolverCache final
+    : public rtc::RefCountedNonVirtual<AsyncDnsResolverCache> {
+ public:
+  using ResolverFactory =
+      std::function<std::unique_ptr<AsyncDnsResolverInterface>()>;
+
+  // `factory` creates the resolvers that query DNS on a cache miss.
+  AsyncDnsResolverCache(ResolverFactory factory, TimeDelta ttl);
+  ~AsyncDnsResolverCache();
+
+  // Creates a resolver that is served from the cache.
+  std::unique_ptr<AsyncDnsResolverInterface> CreateResolver();
+
+  size_t size_for_testing() const;
+
+ private:
+  class Resolver;
+
+  // The top address of each family, like rtc::AsyncResolver reports them.
+  struct Addresses {
+    absl::optional<rtc::IPAddress> ipv4;
+    absl::optional<rtc::IPAddress> ipv6;
+    int error = 0;
+  };
+  // The hostname, and the family asked for, or AF_UNSPEC.
+  using Key = std::pair<std::string, int>;
+  struct Entry {
+    Addresses addresses;
+    int64_t expires_ms;
+  };
+  struct Query {
+    std::unique_ptr<AsyncDnsResolverInterface> resolver;
+    std::vector<std::function<void(const Addresses&)>> waiters;
+  };
+
+  // Returns the cached addresses for `addr`, or queues `waiter` to be called
+  // with them once they are resolved.
+  absl::optional<Addresses> Resolve(
+      const rtc::SocketAddress& addr,
+      int family,
+      std::function<void(const Addresses&)> waiter);
+  void OnQueryDone(const Key& key);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  const ResolverFactory factory_;
+  const TimeDelta ttl_;
+  std::map<Key, Entry> entries_ RTC_GUARDED_BY(sequence_checker_);
+  std::map<Key, Query> queries_ RTC_GUARDED_BY(sequence_checker_);
+};
+
+}  // namespace webrtc
+
+#endif  // P2P_BASE_ASYNC_DNS_RESOLVER_CACHE_H_
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/async_dns_resolver_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kTtl = TimeDelta::Seconds(60);
+
+// Completes when the test calls Resolve().
+class FakeResolver : public AsyncDnsResolverInterface,
+                     public AsyncDnsResolverResult {
+ public:
+  void Start(const rtc::SocketAddress& addr,
+             std::function<void()> callback) override {
+    Start(addr, AF_UNSPEC, std::move(callback));
+  }
+  void Start(const rtc::SocketAddress& addr,
+             int family,
+             std::function<void()> callback) override {
+    addr_ = addr;
+    family_ = family;
+    callback_ = std::move(callback);
+  }
+  const AsyncDnsResolverResult& result() const override { return *this; }
+  bool GetResolvedAddress(int family, rtc::SocketAddress* addr) const override {
+    if (error_ != 0 || ip_.family() != family) {
+      return false;
+    }
+    *addr = addr_;
+    addr->SetResolvedIP(ip_);
+    return true;
+  }
+  int GetError() const override { return error_; }
+
+  void Resolve(const rtc::IPAddress& ip, int error = 0) {
+    ip_ = ip;
+    error_ = error;
+    callback_();
+  }
+  int family() const { return family_; }
+
+ private:
+  rtc::SocketAddress addr_;
+  int family_ = AF_UNSPEC;
+  std::function<void()> callback_;
+  rtc::IPAddress ip_;
+  int error_ = 0;
+};
+
+class AsyncDnsResolverCacheTest : public ::testing::Test {
+ public:
+  AsyncDnsResolverCacheTest()
+      : cache_(rtc::make_ref_counted<AsyncDnsResolverCache>(
+            [this] {
+              auto resolver = std::make_unique<FakeResolver>();
+              queries_.push_back(resolver.get());
+              return resolver;
+            },
+            kTtl)) {}
+
+ protected:
+  rtc::ScopedFakeClock clock_;
+  rtc::AutoThread main_thread_;
+  std::vector<FakeResolver*> queries_;
+  rtc::scoped_refptr<AsyncDnsResolverCache> cache_;
+  const rtc::SocketAddress server_{"stun.example.org", 3478};
+  const rtc::IPAddress ip_{0x01020304};
+};
+
+TEST_F(AsyncDnsResolverCacheTest, SharesOutstandingQuery) {
+  auto resolver1 = cache_->CreateResolver();
+  auto resolver2 = cache_->CreateResolver();
+  int resolved = 0;
+  resolver1->Start(server_, [&] { ++resolved; });
+  resolver2->Start(rtc::SocketAddress("stun.example.org", 19302),
+                   [&] { ++resolved; });
+  ASSERT_EQ(queries_.size(), 1u);
+
+  queries_[0]->Resolve(ip_);
+  EXPECT_EQ(resolved, 2);
+  rtc::SocketAddress address;
+  ASSERT_TRUE(resolver1->result().GetResolvedAddress(AF_INET, &address));
+  EXPECT_EQ(address, rtc::SocketAddress(ip_, 3478));
+  EXPECT_EQ(address.hostname(), "stun.example.org");
+  // Each resolver keeps its own port.
+  ASSERT_TRUE(resolver2->result().GetResolvedAddress(AF_INET, &address));
+  EXPECT_EQ(address, rtc::SocketAddress(ip_, 19302));
+  EXPECT_FALSE(resolver1->result().GetResolvedAddress(AF_INET6, &address));
+  EXPECT_EQ(resolver1->result().GetError(), 0);
+}
+
+TEST_F(AsyncDnsResolverCacheTest, ServesFromCacheUntilExpired) {
+  auto resolver = cache_->CreateResolver();
+  resolver->Start(server_, [] {});
+  queries_[0]->Resolve(ip_);
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_EQ(cache_->size_for_testing(), 1u);
+
+  resolver = cache_->CreateResolver();
+  bool resolved = false;
+  resolver->Start(server_, [&] { resolved = true; });
+  EXPECT_FALSE(resolved);
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_TRUE(resolved);
+  EXPECT_EQ(queries_.size(), 1u);
+  rtc::SocketAddress address;
+  ASSERT_TRUE(resolver->result().GetResolvedAddress(AF_INET, &address));
+  EXPECT_EQ(address.ipaddr(), ip_);
+
+  clock_.AdvanceTime(kTtl);
+  resolver = cache_->CreateResolver();
+  resolver->Start(server_, [] {});
+  EXPECT_EQ(queries_.size(), 2u);
+}
+
+TEST_F(AsyncDnsResolverCacheTest, KeysOnFamily) {
+  auto resolver1 = cache_->CreateResolver();
+  auto resolver2 = cache_->CreateResolver();
+  resolver1->Start(server_, [] {});
+  resolver2->Start(server_, AF_INET6, [] {});
+  ASSERT_EQ(queries_.size(), 2u);
+  EXPECT_EQ(queries_[0]->family(), AF_UNSPEC);
+  EXPECT_EQ(queries_[1]->family(), AF_INET6);
+}
+
+TEST_F(AsyncDnsResolverCacheTest, DoesNotCacheFailures) {
+  auto resolver = cache_->CreateResolver();
+  bool resolved = false;
+  resolver->Start(server_, [&] { resolved = true; });
+  queries_[0]->Resolve(rtc::IPAddress(), /*error=*/-1);
+  EXPECT_TRUE(resolved);
+  EXPECT_EQ(resolver->result().GetError(), -1);
+  rtc::SocketAddress address;
+  EXPECT_FALSE(resolver->result().GetResolvedAddress(AF_INET, &address));
+  EXPECT_EQ(cache_->size_for_testing(), 0u);
+  rtc::Thread::Current()->ProcessMessages(0);
+
+  resolver = cache_->CreateResolver();
+  resolver->Start(server_, [] {});
+  EXPECT_EQ(queries_.size(), 2u);
+}
+
+TEST_F(AsyncDnsResolverCacheTest, DestroyedResolverIsNotCalledBack) {
+  auto resolver1 = cache_->CreateResolver();
+  auto resolver2 = cache_->CreateResolver();
+  bool resolved1 = false;
+  bool resolved2 = false;
+  resolver1->Start(server_, [&] { resolved1 = true; });
+  resolver2->Start(server_, [&] { resolved2 = true; });
+  resolver1.reset();
+  queries_[0]->Resolve(ip_);
+  EXPECT_FALSE(resolved1);
+  EXPECT_TRUE(resolved2);
+
+  // Nor when served from the cache.
+  resolver1 = cache_->CreateResolver();
+  resolver1->Start(server_, [&] { resolved1 = true; });
+  resolver1.reset();
+  rtc::Thread::Current()->ProcessMessages(0);
+  EXPECT_FALSE(resolved1);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -102,26 +102,33 @@ void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
   // |         Channel Number        |            Length             |
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
+  // Packets are signaled where they are in `data`, and the incomplete
+  // remainder is moved to the front once all complete packets are consumed.
+  size_t processed = 0;
   while (true) {
+    size_t bytes_left = *len - processed;
     // We need at least 4 bytes to read the STUN or ChannelData packet length.
-    if (*len < kPacketLenOffset + kPacketLenSize)
-      return;
+    if (bytes_left < kPacketLenOffset + kPacketLenSize)
+      break;
 
     int pad_bytes;
-    size_t expected_pkt_len = GetExpectedLength(data, *len, &pad_bytes);
+    size_t expected_pkt_len =
+        GetExpectedLength(data + processed, bytes_left, &pad_bytes);
     size_t actual_length = expected_pkt_len + pad_bytes;
 
-    if (*len < actual_length) {
-      return;
+    if (bytes_left < actual_length) {
+      break;
     }
 
-    SignalReadPacket(this, data, expected_pkt_len, remote_addr,
+    SignalReadPacket(this, data + processed, expected_pkt_len, remote_addr,
                      rtc::TimeMicros());
 
-    *len -= actual_length;
-    if (*len > 0) {
-      memmove(data, data + actual_length, *len);
-    }
+    processed += actual_length;
+  }
+
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "rtc_base/network/sent_packet.h"
@@ -101,6 +102,7 @@ class AsyncStunTCPSocketTest : public ::testing::Test,
                     const rtc::SocketAddress& remote_addr,
                     const int64_t& /* packet_time_us */) {
     recv_packets_.push_back(std::string(data, len));
+    recv_packet_data_.push_back(data);
   }
 
   void OnSentPacket(rtc::AsyncPacketSocket* socket,
@@ -139,6 +141,8 @@ class AsyncStunTCPSocketTest : public ::testing::Test,
   std::unique_ptr<rtc::AsyncListenSocket> listen_socket_;
   std::unique_ptr<rtc::AsyncPacketSocket> recv_socket_;
   std::list<std::string> recv_packets_;
+  // Where in the receive buffer each packet was signaled.
+  std::vector<const char*> recv_packet_data_;
   int sent_packets_ = 0;
 };
 
@@ -264,6 +268,71 @@ TEST_F(AsyncStunTCPSocketTest, TestWithSmallSendBuffer) {
                         sizeof(kTurnChannelDataMessageWithOddLength)));
 }
 
+// Test that a send blocked part way resumes where it stopped, and that the
+// next packet is sent from the start of the out buffer once it has drained.
+TEST_F(AsyncStunTCPSocketTest, PartialSendResumesFromWhereItStopped) {
+  vss_->set_send_buffer_capacity(7);
+  vss_->SetSendingBlocked(true);
+  rtc::PacketOptions options;
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessage)),
+            send_socket_->Send(kTurnChannelDataMessage,
+                               sizeof(kTurnChannelDataMessage), options));
+  // Packets sent while the previous one is still being written are dropped.
+  EXPECT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+            send_socket_->Send(kStunMessageWithZeroLength,
+                               sizeof(kStunMessageWithZeroLength), options));
+  vss_->SetSendingBlocked(false);
+  vss_->ProcessMessagesUntilIdle();
+  ASSERT_EQ(1u, recv_packets_.size());
+  EXPECT_TRUE(
+      CheckData(kTurnChannelDataMessage, sizeof(kTurnChannelDataMessage)));
+
+  EXPECT_TRUE(
+      Send(kStunMessageWithZeroLength, sizeof(kStunMessageWithZeroLength)));
+  ASSERT_EQ(1u, recv_packets_.size());
+  EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                        sizeof(kStunMessageWithZeroLength)));
+}
+
+// Test that packets received by a single read are signaled in order from where
+// they are in the receive buffer.
+TEST_F(AsyncStunTCPSocketTest, ParsesPacketsOfOneReadInPlace) {
+  // Hold the packets back in a send buffer that they fill exactly, so that
+  // they reach the receiver in one segment.
+  vss_->set_send_buffer_capacity(3 * sizeof(kTurnChannelDataMessage) + 12);
+  vss_->SetSendingBlocked(true);
+  rtc::PacketOptions options;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessage)),
+              send_socket_->Send(kTurnChannelDataMessage,
+                                 sizeof(kTurnChannelDataMessage), options));
+  }
+  // Also a packet that needs padding, and that is received last.
+  ASSERT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+            send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                               sizeof(kTurnChannelDataMessageWithOddLength),
+                               options));
+  // A packet that does not fit is dropped, and makes the socket wait for the
+  // network to drain the send buffer.
+  EXPECT_EQ(0, send_socket_->Send(kStunMessageWithZeroLength,
+                                  sizeof(kStunMessageWithZeroLength), options));
+  vss_->SetSendingBlocked(false);
+  vss_->ProcessMessagesUntilIdle();
+
+  ASSERT_EQ(4u, recv_packets_.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(
+        CheckData(kTurnChannelDataMessage, sizeof(kTurnChannelDataMessage)));
+  }
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+  ASSERT_EQ(4u, recv_packet_data_.size());
+  for (size_t i = 1; i < recv_packet_data_.size(); ++i) {
+    EXPECT_EQ(recv_packet_data_[i],
+              recv_packet_data_[i - 1] + sizeof(kTurnChannelDataMessage));
+  }
+}
+
 // Test that SignalSentPacket is fired when a packet is sent.
 TEST_F(AsyncStunTCPSocketTest, SignalSentPacketFiredWhenPacketSent) {
   ASSERT_TRUE(
@@ -13,9 +13,11 @@
 #include <stddef.h>
 
 #include <string>
+#include <utility>
 
 #include "absl/memory/memory.h"
 #include "api/async_dns_resolver.h"
+#include "api/make_ref_counted.h"
 #include "api/wrapping_async_dns_resolver.h"
 #include "p2p/base/async_stun_tcp_socket.h"
 #include "rtc_base/async_tcp_socket.h"
@@ -150,6 +152,8 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateClientTcpSocket(
     ssl_adapter->SetAlpnProtocols(tcp_options.tls_alpn_protocols);
     ssl_adapter->SetEllipticCurves(tcp_options.tls_elliptic_curves);
     ssl_adapter->SetCertVerifier(tcp_options.tls_cert_verifier);
+    ssl_adapter->SetKernelTlsOffload(
+        (tcp_options.opts & PacketSocketFactory::OPT_TLS_KERNEL_OFFLOAD) != 0);
 
     socket = ssl_adapter;
 
@@ -186,10 +190,28 @@ AsyncResolverInterface* BasicPacketSocketFactory::CreateAsyncResolver() {
 
 std::unique_ptr<webrtc::AsyncDnsResolverInterface>
 BasicPacketSocketFactory::CreateAsyncDnsResolver() {
+  if (dns_cache_) {
+    return dns_cache_->CreateResolver();
+  }
   return std::make_unique<webrtc::WrappingAsyncDnsResolver>(
       new AsyncResolver());
 }
 
+void BasicPacketSocketFactory::EnableDnsCache(webrtc::TimeDelta ttl) {
+  EnableDnsCache(ttl, [] {
+    return std::make_unique<webrtc::WrappingAsyncDnsResolver>(
+        new AsyncResolver());
+  });
+}
+
+void BasicPacketSocketFactory::EnableDnsCache(
+    webrtc::TimeDelta ttl,
+    webrtc::AsyncDnsResolverCache::ResolverFactory resolver_factory) {
+  RTC_DCHECK(!dns_cache_);
+  dns_cache_ = rtc::make_ref_counted<webrtc::AsyncDnsResolverCache>(
+      std::move(resolver_factory), ttl);
+}
+
 int BasicPacketSocketFactory::BindSocket(Socket* socket,
                                          const SocketAddress& local_address,
                                          uint16_t min_port,
@@ -18,6 +18,9 @@
 
 #include "api/async_dns_resolver.h"
 #include "api/packet_socket_factory.h"
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "p2p/base/async_dns_resolver_cache.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/proxy_info.h"
 #include "rtc_base/socket.h"
@@ -55,6 +58,17 @@ class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> CreateAsyncDnsResolver()
       override;
 
+  // Makes the resolvers created by this factory share their results for
+  // `ttl`, so that the STUN and TURN servers are resolved once for all the
+  // ports and sessions using this factory instead of once per port. Must be
+  // called before the first resolver is created.
+  void EnableDnsCache(webrtc::TimeDelta ttl);
+  // Same as above, with the cache misses resolved by resolvers from
+  // `resolver_factory` instead of AsyncResolver.
+  void EnableDnsCache(
+      webrtc::TimeDelta ttl,
+      webrtc::AsyncDnsResolverCache::ResolverFactory resolver_factory);
+
  private:
   int BindSocket(Socket* socket,
                  const SocketAddress& local_address,
@@ -62,6 +76,7 @@ class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
                  uint16_t max_port);
 
   SocketFactory* socket_factory_;
+  rtc::scoped_refptr<webrtc::AsyncDnsResolverCache> dns_cache_;
 };
 
 }  // namespace rtc
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
@@ -507,6 +508,8 @@ void DtlsTransport::ConnectToIceTransport() {
   ice_transport_->SignalWritableState.connect(this,
                                               &DtlsTransport::OnWritableState);
   ice_transport_->SignalReadPacket.connect(this, &DtlsTransport::OnReadPacket);
+  ice_transport_->SignalReadPackets.connect(this,
+                                            &DtlsTransport::OnReadPackets);
   ice_transport_->SignalSentPacket.connect(this, &DtlsTransport::OnSentPacket);
   ice_transport_->SignalReadyToSend.connect(this,
                                             &DtlsTransport::OnReadyToSend);
@@ -667,6 +670,41 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
   }
 }
 
+void DtlsTransport::OnReadPackets(
+    rtc::PacketTransportInternal* transport,
+    rtc::ArrayView<const rtc::ReceivedPacketView> packets) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(transport == ice_transport_);
+
+  if (!dtls_active_) {
+    // Not doing DTLS.
+    NotifyPacketsReceived(packets);
+    return;
+  }
+
+  // SRTP packets pass through untouched once DTLS is up, so consecutive runs of
+  // them are forwarded as one batch. Anything else takes the per-packet path,
+  // in order, since it may change the DTLS state.
+  std::vector<rtc::ReceivedPacketView> srtp_packets;
+  srtp_packets.reserve(packets.size());
+  for (const rtc::ReceivedPacketView& packet : packets) {
+    RTC_DCHECK(packet.flags == 0);
+    if (dtls_state() == webrtc::DtlsTransportState::kConnected &&
+        !IsDtlsPacket(packet.data, packet.size) &&
+        IsRtpPacket(packet.data, packet.size)) {
+      RTC_DCHECK(!srtp_ciphers_.empty());
+      srtp_packets.push_back({packet.data, packet.size, packet.packet_time_us,
+                              PF_SRTP_BYPASS});
+      continue;
+    }
+    NotifyPacketsReceived(srtp_packets);
+    srtp_packets.clear();
+    OnReadPacket(transport, packet.data, packet.size, packet.packet_time_us,
+                 packet.flags);
+  }
+  NotifyPacketsReceived(srtp_packets);
+}
+
 void DtlsTransport::OnSentPacket(rtc::PacketTransportInternal* transport,
                                  const rtc::SentPacket& sent_packet) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/crypto/crypto_options.h"
 #include "api/dtls_transport_interface.h"
 #include "api/sequence_checker.h"
@@ -214,6 +215,8 @@ class DtlsTransport : public DtlsTransportInternal {
                     size_t size,
                     const int64_t& packet_time_us,
                     int flags);
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacketView> packets);
   void OnSentPacket(rtc::PacketTransportInternal* transport,
                     const rtc::SentPacket& sent_packet);
   void OnReadyToSend(rtc::PacketTransportInternal* transport);
@@ -14,8 +14,10 @@
 #include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/dtls_transport_interface.h"
 #include "p2p/base/fake_ice_transport.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -27,6 +29,7 @@
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
+#include "test/gmock.h"
 
 #define MAYBE_SKIP_TEST(feature)                                  \
   if (!(rtc::SSLStreamAdapter::feature())) {                      \
@@ -36,6 +39,8 @@
 
 namespace cricket {
 
+using ::testing::ElementsAre;
+
 static const size_t kPacketNumOffset = 8;
 static const size_t kPacketHeaderLen = 12;
 static const int kFakePacketId = 0x1234;
@@ -492,6 +497,55 @@ TEST_F(DtlsTransportTest, TestTransferDtlsSrtpDemux) {
   TestTransfer(1000, 100, /*srtp=*/true);
 }
 
+// Records the packet numbers of the batches signalled by a transport.
+class ReadPacketsRecorder : public sigslot::has_slots<> {
+ public:
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacketView> packets) {
+    std::vector<uint32_t> batch;
+    for (const rtc::ReceivedPacketView& packet : packets) {
+      EXPECT_EQ(packet.flags, PF_SRTP_BYPASS);
+      batch.push_back(rtc::GetBE32(packet.data + kPacketNumOffset));
+    }
+    batches_.push_back(batch);
+  }
+
+  const std::vector<std::vector<uint32_t>>& batches() const {
+    return batches_;
+  }
+
+ private:
+  std::vector<std::vector<uint32_t>> batches_;
+};
+
+// Test that SRTP packets read from the ICE transport in one batch are passed
+// on in batches, split around packets that need handling of their own.
+TEST_F(DtlsTransportTest, TestTransferDtlsSrtpInBatches) {
+  PrepareDtls(rtc::KT_DEFAULT);
+  ASSERT_TRUE(Connect());
+  ReadPacketsRecorder recorder;
+  client2_.dtls_transport()->SignalReadPackets.connect(
+      &recorder, &ReadPacketsRecorder::OnReadPackets);
+
+  auto srtp_packet = [](uint32_t packet_num) {
+    rtc::CopyOnWriteBuffer packet(100);
+    memset(packet.MutableData(), packet_num & 0xff, packet.size());
+    packet.MutableData()[0] = 0x80;
+    rtc::SetBE32(packet.MutableData() + kPacketNumOffset, packet_num);
+    return packet;
+  };
+  // Neither DTLS nor SRTP; dropped on the per-packet path.
+  const uint8_t kUnexpected[] = {0x00, 0x01, 0x02, 0x03};
+  rtc::CopyOnWriteBuffer packets[] = {
+      srtp_packet(0), srtp_packet(1),
+      rtc::CopyOnWriteBuffer(kUnexpected, sizeof(kUnexpected)),
+      srtp_packet(2)};
+  client1_.fake_ice_transport()->SendPackets(packets);
+
+  EXPECT_THAT(recorder.batches(),
+              ElementsAre(ElementsAre(0u, 1u), ElementsAre(2u)));
+}
+
 // Test transferring when the "answerer" has the server role.
 TEST_F(DtlsTransportTest, TestTransferDtlsSrtpAnswererIsPassive) {
   PrepareDtls(rtc::KT_DEFAULT);
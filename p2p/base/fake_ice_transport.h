@@ -15,10 +15,12 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/ice_transport_interface.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/time_delta.h"
@@ -328,6 +330,22 @@ class FakeIceTransport : public IceTransportInternal {
     return static_cast<int>(len);
   }
 
+  // Delivers `packets` to the destination as a single batch, right away.
+  void SendPackets(rtc::ArrayView<const rtc::CopyOnWriteBuffer> packets) {
+    RTC_DCHECK_RUN_ON(network_thread_);
+    if (!dest_ || packets.empty()) {
+      return;
+    }
+    last_sent_packet_ = packets[packets.size() - 1];
+    const int64_t now_us = rtc::TimeMicros();
+    std::vector<rtc::ReceivedPacketView> views;
+    views.reserve(packets.size());
+    for (const rtc::CopyOnWriteBuffer& packet : packets) {
+      views.push_back({packet.data<char>(), packet.size(), now_us, 0});
+    }
+    dest_->NotifyPacketsReceived(views);
+  }
+
   int SetOption(rtc::Socket::Option opt, int value) override {
     RTC_DCHECK_RUN_ON(network_thread_);
     socket_options_[opt] = value;
@@ -13,7 +13,9 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
+#include "api/array_view.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -71,6 +73,21 @@ class FakePacketTransport : public PacketTransportInternal {
     return static_cast<int>(len);
   }
 
+  // Delivers `packets` to the destination as a single batch.
+  void SendPackets(rtc::ArrayView<const CopyOnWriteBuffer> packets) {
+    if (!dest_ || packets.empty()) {
+      return;
+    }
+    last_sent_packet_ = packets[packets.size() - 1];
+    const int64_t now_us = TimeMicros();
+    std::vector<ReceivedPacketView> views;
+    views.reserve(packets.size());
+    for (const CopyOnWriteBuffer& packet : packets) {
+      views.push_back({packet.data<char>(), packet.size(), now_us, 0});
+    }
+    dest_->NotifyPacketsReceived(views);
+  }
+
   int SetOption(Socket::Option opt, int value) override {
     options_[opt] = value;
     return 0;
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_check_pacer.h"
+
+#include <algorithm>
+#include <map>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+namespace {
+
+// The pacers of the threads that have one. A pacer is only used on its
+// thread, but threads register and unregister concurrently.
+webrtc::Mutex& RegistryMutex() {
+  static webrtc::Mutex* const mutex = new webrtc::Mutex();
+  return *mutex;
+}
+
+std::map<webrtc::TaskQueueBase*, IceCheckPacer*>& Registry() {
+  static auto* const registry =
+      new std::map<webrtc::TaskQueueBase*, IceCheckPacer*>();
+  return *registry;
+}
+
+}  // namespace
+
+rtc::scoped_refptr<IceCheckPacer> IceCheckPacer::GetForThread(
+    webrtc::TaskQueueBase* thread,
+    webrtc::TimeDelta min_interval,
+    webrtc::TimeDelta tick) {
+  RTC_DCHECK(thread);
+  webrtc::MutexLock lock(&RegistryMutex());
+  IceCheckPacer*& pacer = Registry()[thread];
+  if (pacer) {
+    return rtc::scoped_refptr<IceCheckPacer>(pacer);
+  }
+  auto new_pacer = rtc::make_ref_counted<IceCheckPacer>(min_interval, tick);
+  new_pacer->thread_ = thread;
+  pacer = new_pacer.get();
+  return new_pacer;
+}
+
+IceCheckPacer::IceCheckPacer(webrtc::TimeDelta min_interval,
+                             webrtc::TimeDelta tick)
+    : min_interval_(min_interval), tick_(tick) {
+  RTC_DCHECK_GE(min_interval_, webrtc::TimeDelta::Zero());
+  RTC_DCHECK_GT(tick_, webrtc::TimeDelta::Zero());
+}
+
+IceCheckPacer::~IceCheckPacer() {
+  if (thread_) {
+    webrtc::MutexLock lock(&RegistryMutex());
+    Registry().erase(thread_);
+  }
+}
+
+webrtc::TimeDelta IceCheckPacer::ReserveCheck(bool nominating) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const int64_t now_us = rtc::TimeMicros();
+  const int64_t slot_us = std::max(now_us, next_slot_us_);
+  next_slot_us_ = slot_us + min_interval_.us();
+  if (nominating) {
+    return webrtc::TimeDelta::Zero();
+  }
+  return webrtc::TimeDelta::Micros(slot_us - now_us);
+}
+
+webrtc::TimeDelta IceCheckPacer::AlignToTick(webrtc::TimeDelta delay) const {
+  if (delay < tick_) {
+    return delay;
+  }
+  const int64_t now_us = rtc::TimeMicros();
+  const int64_t tick_us = tick_.us();
+  const int64_t wakeup_us =
+      (now_us + delay.us() + tick_us - 1) / tick_us * tick_us;
+  return webrtc::TimeDelta::Micros(wakeup_us - now_us);
+}
+
+}  // namespace cricket
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ICE_CHECK_PACER_H_
+#define P2P_BASE_ICE_CHECK_PACER_H_
+
+#include <stdint.h>
+
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace cricket {
+
+// Paces the connectivity checks of all the P2PTransportChannels on a network
+// thread. Each channel otherwise schedules its checks on its own, so when
+// thousands of transports on one thread reconnect at once, they send bursts
+// of STUN requests and flood the thread with timers.
+//
+// The pacer hands out one check slot per `min_interval` (Ta in RFC 8445,
+// section 14) across all the channels on the thread; checks that nominate a
+// pair don't wait for a slot but push the other checks back. It also rounds
+// long waits, such as those between keepalives, up to ticks shared by all the
+// channels, so that the thread wakes up once for many of them.
+class IceCheckPacer final : public rtc::RefCountedNonVirtual<IceCheckPacer> {
+ public:
+  // Returns the pacer shared by the channels of `thread`, creating it with
+  // `min_interval` and `tick` if there is none yet.
+  static rtc::scoped_refptr<IceCheckPacer> GetForThread(
+      webrtc::TaskQueueBase* thread,
+      webrtc::TimeDelta min_interval,
+      webrtc::TimeDelta tick);
+
+  IceCheckPacer(webrtc::TimeDelta min_interval, webrtc::TimeDelta tick);
+  ~IceCheckPacer();
+
+  // Reserves the next slot for a check, and returns how long to wait before
+  // sending it.
+  webrtc::TimeDelta ReserveCheck(bool nominating);
+
+  // Rounds `delay` up to the next tick, unless it is shorter than a tick.
+  webrtc::TimeDelta AlignToTick(webrtc::TimeDelta delay) const;
+
+ private:
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
+  const webrtc::TimeDelta min_interval_;
+  const webrtc::TimeDelta tick_;
+  // The thread the pacer is registered for, if returned by GetForThread().
+  webrtc::TaskQueueBase* thread_ = nullptr;
+  int64_t next_slot_us_ RTC_GUARDED_BY(sequence_checker_) = 0;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_ICE_CHECK_PACER_H_
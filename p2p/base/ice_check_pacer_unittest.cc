@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_check_pacer.h"
+
+#include <memory>
+
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+using ::webrtc::TimeDelta;
+
+constexpr TimeDelta kInterval = TimeDelta::Millis(5);
+constexpr TimeDelta kTick = TimeDelta::Millis(50);
+
+TEST(IceCheckPacerTest, SpacesChecksByInterval) {
+  rtc::ScopedFakeClock clock;
+  IceCheckPacer pacer(kInterval, kTick);
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), TimeDelta::Zero());
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), kInterval);
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), 2 * kInterval);
+
+  clock.AdvanceTime(kInterval);
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), 2 * kInterval);
+
+  // Once idle, checks are sent right away again.
+  clock.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), TimeDelta::Zero());
+}
+
+TEST(IceCheckPacerTest, NominatingChecksAreNotDelayed) {
+  rtc::ScopedFakeClock clock;
+  IceCheckPacer pacer(kInterval, kTick);
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), TimeDelta::Zero());
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), kInterval);
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/true), TimeDelta::Zero());
+  // But they still take a slot.
+  EXPECT_EQ(pacer.ReserveCheck(/*nominating=*/false), 3 * kInterval);
+}
+
+TEST(IceCheckPacerTest, AlignsLongWaitsToTicks) {
+  rtc::ScopedFakeClock clock;
+  IceCheckPacer pacer(kInterval, kTick);
+  clock.AdvanceTime(TimeDelta::Millis(1020));
+  // Short waits are kept.
+  EXPECT_EQ(pacer.AlignToTick(TimeDelta::Millis(20)), TimeDelta::Millis(20));
+  // Wake up at 3550 ms.
+  EXPECT_EQ(pacer.AlignToTick(TimeDelta::Millis(2500)),
+            TimeDelta::Millis(2530));
+  EXPECT_EQ(pacer.AlignToTick(TimeDelta::Millis(2530)),
+            TimeDelta::Millis(2530));
+}
+
+TEST(IceCheckPacerTest, SharedPerThread) {
+  rtc::AutoThread thread;
+  auto pacer = IceCheckPacer::GetForThread(&thread, kInterval, kTick);
+  EXPECT_EQ(IceCheckPacer::GetForThread(&thread, kInterval, kTick), pacer);
+
+  std::unique_ptr<rtc::Thread> other_thread = rtc::Thread::Create();
+  EXPECT_NE(IceCheckPacer::GetForThread(other_thread.get(), kInterval, kTick),
+            pacer);
+}
+
+}  // namespace
+}  // namespace cricket
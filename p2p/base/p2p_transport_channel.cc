@@ -23,6 +23,7 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/async_dns_resolver.h"
 #include "api/candidate.h"
 #include "api/field_trials_view.h"
@@ -41,6 +42,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/net_helper.h"
 #include "rtc_base/network.h"
+#include "rtc_base/network/received_packet_batch.h"
 #include "rtc_base/network_constants.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -772,7 +774,10 @@ void P2PTransportChannel::ParseFieldTrials(
       &ice_field_trials_.dead_connection_timeout_ms,
       // Stop gathering on strongly connected.
       "stop_gather_on_strongly_connected",
-      &ice_field_trials_.stop_gather_on_strongly_connected)
+      &ice_field_trials_.stop_gather_on_strongly_connected,
+      // Pace checks across all the channels of the network thread.
+      "check_pacing_interval_us", &ice_field_trials_.check_pacing_interval_us,
+      "check_pacing_tick_ms", &ice_field_trials_.check_pacing_tick_ms)
       ->Parse(field_trials->Lookup("WebRTC-IceFieldTrials"));
 
   if (ice_field_trials_.dead_connection_timeout_ms < 30000) {
@@ -802,6 +807,18 @@ void P2PTransportChannel::ParseFieldTrials(
         << *ice_field_trials_.initial_select_dampening_ping_received;
   }
 
+  if (ice_field_trials_.check_pacing_interval_us.has_value() &&
+      *ice_field_trials_.check_pacing_interval_us >= 0 &&
+      ice_field_trials_.check_pacing_tick_ms > 0) {
+    RTC_LOG(LS_INFO) << "Set check_pacing_interval_us: "
+                     << *ice_field_trials_.check_pacing_interval_us;
+    // The first channel on the thread decides the pacing.
+    ice_check_pacer_ = IceCheckPacer::GetForThread(
+        network_thread_,
+        TimeDelta::Micros(*ice_field_trials_.check_pacing_interval_us),
+        TimeDelta::Millis(ice_field_trials_.check_pacing_tick_ms));
+  }
+
   // DSCP override, allow user to specify (any) int value
   // that will be used for tagging all packets.
   webrtc::StructParametersParser::Create("override_dscp",
@@ -2152,11 +2169,26 @@ void P2PTransportChannel::CheckAndPing() {
 
   auto result = ice_adapter_->LegacySelectConnectionToPing(last_ping_sent_ms_);
   TimeDelta delay = TimeDelta::Millis(result.recheck_delay_ms);
+  bool slot_reserved = std::exchange(ping_slot_reserved_, false);
 
   if (result.connection.value_or(nullptr)) {
+    if (ice_check_pacer_ && !slot_reserved) {
+      TimeDelta wait = ice_check_pacer_->ReserveCheck(
+          IsNominatingPing(FromIceController(*result.connection)));
+      if (wait > TimeDelta::Zero()) {
+        // Whichever connection is due then is pinged in the reserved slot.
+        ping_slot_reserved_ = true;
+        network_thread_->PostDelayedTask(
+            SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }), wait);
+        return;
+      }
+    }
     SendPingRequest(result.connection.value());
   }
 
+  if (ice_check_pacer_) {
+    delay = ice_check_pacer_->AlignToTick(delay);
+  }
   network_thread_->PostDelayedTask(
       SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }), delay);
 }
@@ -2204,10 +2236,7 @@ void P2PTransportChannel::PingConnection(Connection* conn) {
   bool use_candidate_attr = false;
   uint32_t nomination = 0;
   if (ice_role_ == ICEROLE_CONTROLLING) {
-    bool renomination_supported = ice_parameters_.renomination &&
-                                  !remote_ice_parameters_.empty() &&
-                                  remote_ice_parameters_.back().renomination;
-    if (renomination_supported) {
+    if (IsRenominationSupported()) {
       nomination = GetNominationAttr(conn);
     } else {
       use_candidate_attr = GetUseCandidateAttr(conn);
@@ -2231,6 +2260,26 @@ bool P2PTransportChannel::GetUseCandidateAttr(Connection* conn) const {
       conn, config_.default_nomination_mode, remote_ice_mode_);
 }
 
+bool P2PTransportChannel::IsRenominationSupported() const {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  return ice_parameters_.renomination && !remote_ice_parameters_.empty() &&
+         remote_ice_parameters_.back().renomination;
+}
+
+bool P2PTransportChannel::IsNominatingPing(Connection* conn) const {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  // Semi-aggressive nomination sets USE-CANDIDATE on most checks, so only
+  // count the checks that can still complete the nomination of the selected
+  // connection.
+  if (ice_role_ != ICEROLE_CONTROLLING || conn != selected_connection_) {
+    return false;
+  }
+  if (IsRenominationSupported()) {
+    return GetNominationAttr(conn) > conn->acked_nomination();
+  }
+  return !conn->writable() && GetUseCandidateAttr(conn);
+}
+
 // When a connection's state changes, we need to figure out who to use as
 // the selected connection again.  It could have become usable, or become
 // unusable.
@@ -2372,7 +2421,7 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
     RTC_DCHECK(connection->last_data_received() >= last_data_received_ms_);
     last_data_received_ms_ =
         std::max(last_data_received_ms_, connection->last_data_received());
-    SignalReadPacket(this, data, len, packet_time_us, 0);
+    DeliverReadPacket(data, len, packet_time_us);
     return;
   }
 
@@ -2388,7 +2437,7 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
       std::max(last_data_received_ms_, connection->last_data_received());
 
   // Let the client know of an incoming packet
-  SignalReadPacket(this, data, len, packet_time_us, 0);
+  DeliverReadPacket(data, len, packet_time_us);
 
   // May need to switch the sending connection based on the receiving media
   // path if this is the controlled side.
@@ -2398,6 +2447,43 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
   }
 }
 
+void P2PTransportChannel::DeliverReadPacket(const char* data,
+                                            size_t len,
+                                            int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (SignalReadPackets.is_empty()) {
+    SignalReadPacket(this, data, len, packet_time_us, 0);
+    return;
+  }
+
+  // Packets are only queued while the socket that read them has more to read.
+  // A packet read on its own is handed on right away, without copying it.
+  if (queued_packets_.empty() &&
+      !rtc::ScopedReceivedPacketBatch::OnBatchEnd(SafeTask(
+          task_safety_.flag(), [this] { DeliverQueuedPackets(); }))) {
+    const rtc::ReceivedPacketView packet = {data, len, packet_time_us, 0};
+    NotifyPacketsReceived(rtc::MakeArrayView(&packet, 1));
+    return;
+  }
+  queued_packets_.push_back({queued_packet_data_.size(), len, packet_time_us});
+  queued_packet_data_.AppendData(data, len);
+}
+
+void P2PTransportChannel::DeliverQueuedPackets() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  queued_packet_views_.clear();
+  for (const QueuedPacket& packet : queued_packets_) {
+    queued_packet_views_.push_back(
+        {queued_packet_data_.data<char>() + packet.offset, packet.size,
+         packet.packet_time_us, 0});
+  }
+  queued_packets_.clear();
+  NotifyPacketsReceived(queued_packet_views_);
+  // Packets are only read from socket events, never from within the signal.
+  RTC_DCHECK(queued_packets_.empty());
+  queued_packet_data_.Clear();
+}
+
 void P2PTransportChannel::OnSentPacket(const rtc::SentPacket& sent_packet) {
   RTC_DCHECK_RUN_ON(network_thread_);
 
@@ -51,6 +51,7 @@
 #include "p2p/base/candidate_pair_interface.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/ice_agent_interface.h"
+#include "p2p/base/ice_check_pacer.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
 #include "p2p/base/ice_switch_reason.h"
@@ -63,6 +64,7 @@
 #include "p2p/base/regathering_controller.h"
 #include "p2p/base/transport_description.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/dscp.h"
 #include "rtc_base/network/sent_packet.h"
@@ -349,6 +351,12 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
                     const char* data,
                     size_t len,
                     int64_t packet_time_us);
+  // Hands a packet read from `connection` to the listeners. While anyone
+  // listens to SignalReadPackets, the packets of one
+  // rtc::ScopedReceivedPacketBatch are queued and delivered together when the
+  // batch ends. Other packets are delivered right away.
+  void DeliverReadPacket(const char* data, size_t len, int64_t packet_time_us);
+  void DeliverQueuedPackets();
   void OnSentPacket(const rtc::SentPacket& sent_packet);
   void OnReadyToSend(Connection* connection);
   void OnConnectionDestroyed(Connection* connection);
@@ -363,6 +371,9 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
 
   uint32_t GetNominationAttr(Connection* conn) const;
   bool GetUseCandidateAttr(Connection* conn) const;
+  bool IsRenominationSupported() const;
+  // Whether a ping on `conn` now would complete its nomination.
+  bool IsNominatingPing(Connection* conn) const;
 
   // Returns true if the new_connection is selected for transmission.
   // TODO(bugs.webrtc.org/14367) remove once refactor lands.
@@ -476,6 +487,11 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
   std::unique_ptr<webrtc::BasicRegatheringController> regathering_controller_
       RTC_GUARDED_BY(network_thread_);
   int64_t last_ping_sent_ms_ RTC_GUARDED_BY(network_thread_) = 0;
+  // Shared by the channels on the network thread when checks are paced.
+  rtc::scoped_refptr<IceCheckPacer> ice_check_pacer_
+      RTC_GUARDED_BY(network_thread_);
+  // Set while waiting for a check slot reserved with `ice_check_pacer_`.
+  bool ping_slot_reserved_ RTC_GUARDED_BY(network_thread_) = false;
   int weak_ping_interval_ RTC_GUARDED_BY(network_thread_) = WEAK_PING_INTERVAL;
   // TODO(jonasolsson): Remove state_ and rename standardized_state_ once state_
   // is no longer used to compute the ICE connection state.
@@ -581,6 +597,18 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
   // from connection->last_data_received() that uses rtc::TimeMillis().
   int64_t last_data_received_ms_ = 0;
 
+  // Packets queued by DeliverReadPacket. The payloads are stored back to back
+  // in `queued_packet_data_`, which keeps its capacity between batches.
+  struct QueuedPacket {
+    size_t offset;
+    size_t size;
+    int64_t packet_time_us;
+  };
+  rtc::Buffer queued_packet_data_ RTC_GUARDED_BY(network_thread_);
+  std::vector<QueuedPacket> queued_packets_ RTC_GUARDED_BY(network_thread_);
+  std::vector<rtc::ReceivedPacketView> queued_packet_views_
+      RTC_GUARDED_BY(network_thread_);
+
   // Parsed field trials.
   IceFieldTrials ice_field_trials_;
 };
@@ -70,6 +70,14 @@ struct IceFieldTrials {
 
   bool piggyback_ice_check_acknowledgement = false;
   bool extra_ice_ping = false;
+
+  // Pace the checks of all the channels on the network thread to one per
+  // this many microseconds. Checks that nominate are not delayed.
+  absl::optional<int> check_pacing_interval_us;
+
+  // With paced checks, waits longer than this are aligned to shared ticks of
+  // this length.
+  int check_pacing_tick_ms = 50;
 };
 
 }  // namespace cricket
@@ -15,8 +15,10 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "api/test/mock_async_dns_resolver.h"
 #include "p2p/base/active_ice_controller_factory_interface.h"
@@ -45,6 +47,7 @@
 #include "rtc_base/mdns_responder_interface.h"
 #include "rtc_base/nat_server.h"
 #include "rtc_base/nat_socket_factory.h"
+#include "rtc_base/network/received_packet_batch.h"
 #include "rtc_base/proxy_server.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
@@ -62,6 +65,7 @@ using ::testing::Assign;
 using ::testing::Combine;
 using ::testing::Contains;
 using ::testing::DoAll;
+using ::testing::ElementsAre;
 using ::testing::InSequence;
 using ::testing::InvokeArgument;
 using ::testing::InvokeWithoutArgs;
@@ -3748,6 +3752,43 @@ TEST_P(P2PTransportChannelPingTest, TestAllConnectionsPingedSufficiently) {
       kDefaultTimeout);
 }
 
+// Test that the checks of all the channels on the network thread are paced
+// together when the field trial is set, and that each channel still gets its
+// share.
+TEST_P(P2PTransportChannelPingTest, ChecksArePacedAcrossChannels) {
+  if (absl::StrContains(GetParam(), "WebRTC-UseActiveIceController")) {
+    GTEST_SKIP() << "Pacing applies to the legacy ping loop.";
+  }
+  rtc::ScopedFakeClock clock;
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      field_trials_, "WebRTC-IceFieldTrials/check_pacing_interval_us:100000/");
+  FakePortAllocator pa(rtc::Thread::Current(), packet_socket_factory(),
+                       &field_trials);
+  P2PTransportChannel ch1("TestChannel1", 1, &pa, &field_trials);
+  P2PTransportChannel ch2("TestChannel2", 1, &pa, &field_trials);
+  PrepareChannel(&ch1);
+  PrepareChannel(&ch2);
+  // None of the checks of the controlled side nominate.
+  ch1.SetIceRole(ICEROLE_CONTROLLED);
+  ch2.SetIceRole(ICEROLE_CONTROLLED);
+  ch1.MaybeStartGathering();
+  ch2.MaybeStartGathering();
+  ch1.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 1));
+  ch2.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "2.2.2.2", 2, 1));
+  Connection* conn1 = WaitForConnectionTo(&ch1, "1.1.1.1", 1);
+  Connection* conn2 = WaitForConnectionTo(&ch2, "2.2.2.2", 2);
+  ASSERT_TRUE(conn1 != nullptr);
+  ASSERT_TRUE(conn2 != nullptr);
+
+  // Unpaced, each weak connection would be pinged every WEAK_PING_INTERVAL.
+  SIMULATED_WAIT(false, 2000, clock);
+  int pings1 = conn1->num_pings_sent();
+  int pings2 = conn2->num_pings_sent();
+  EXPECT_LE(pings1 + pings2, 2000 / 100 + 2);
+  EXPECT_GE(pings1, 2000 / 100 / 2 - 2);
+  EXPECT_GE(pings2, 2000 / 100 / 2 - 2);
+}
+
 // Verify that the connections are pinged at the right time.
 TEST_P(P2PTransportChannelPingTest, TestStunPingIntervals) {
   rtc::ScopedFakeClock clock;
@@ -4082,6 +4123,70 @@ TEST_P(P2PTransportChannelPingTest, TestReceivingStateChange) {
   EXPECT_TRUE_SIMULATED_WAIT(!ch.receiving(), kShortTimeout, clock);
 }
 
+// Records what a channel signals through SignalReadPacket and
+// SignalReadPackets.
+class ReadPacketsRecorder : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t len,
+                    const int64_t& packet_time_us,
+                    int flags) {
+    ++single_packets_;
+  }
+
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacketView> packets) {
+    std::vector<std::string> batch;
+    for (const rtc::ReceivedPacketView& packet : packets) {
+      batch.emplace_back(packet.data, packet.size);
+    }
+    batches_.push_back(batch);
+  }
+
+  int single_packets() const { return single_packets_; }
+  const std::vector<std::vector<std::string>>& batches() const {
+    return batches_;
+  }
+
+ private:
+  int single_packets_ = 0;
+  std::vector<std::vector<std::string>> batches_;
+};
+
+// When anyone listens to SignalReadPackets, the packets of one received packet
+// batch are signalled together once it ends, and other packets right away.
+TEST_P(P2PTransportChannelPingTest, SignalPacketsOfReceivedBatchTogether) {
+  rtc::ScopedFakeClock clock;
+  FakePortAllocator pa(rtc::Thread::Current(), packet_socket_factory(),
+                       &field_trials_);
+  P2PTransportChannel ch("batched reads", 1, &pa, &field_trials_);
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 1));
+  Connection* conn1 = WaitForConnectionTo(&ch, "1.1.1.1", 1, &clock);
+  ASSERT_TRUE(conn1 != nullptr);
+
+  ReadPacketsRecorder recorder;
+  ch.SignalReadPacket.connect(&recorder, &ReadPacketsRecorder::OnReadPacket);
+  ch.SignalReadPackets.connect(&recorder,
+                               &ReadPacketsRecorder::OnReadPackets);
+  conn1->ReceivedPing();
+  conn1->OnReadPacket("A", 1, rtc::TimeMicros());
+  ASSERT_EQ(recorder.batches().size(), 1u);
+  EXPECT_THAT(recorder.batches()[0], ElementsAre("A"));
+
+  {
+    rtc::ScopedReceivedPacketBatch batch;
+    conn1->OnReadPacket("BC", 2, rtc::TimeMicros());
+    conn1->OnReadPacket("DEF", 3, rtc::TimeMicros());
+    EXPECT_EQ(recorder.batches().size(), 1u);
+  }
+  ASSERT_EQ(recorder.batches().size(), 2u);
+  EXPECT_THAT(recorder.batches()[1], ElementsAre("BC", "DEF"));
+  EXPECT_EQ(recorder.single_packets(), 0);
+}
+
 // The controlled side will select a connection as the "selected connection"
 // based on priority until the controlling side nominates a connection, at which
 // point the controlled side will select that connection as the
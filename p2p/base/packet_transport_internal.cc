@@ -24,4 +24,19 @@ absl::optional<NetworkRoute> PacketTransportInternal::network_route() const {
   return absl::optional<NetworkRoute>();
 }
 
+void PacketTransportInternal::NotifyPacketsReceived(
+    rtc::ArrayView<const ReceivedPacketView> packets) {
+  if (packets.empty()) {
+    return;
+  }
+  if (!SignalReadPackets.is_empty()) {
+    SignalReadPackets(this, packets);
+    return;
+  }
+  for (const ReceivedPacketView& packet : packets) {
+    SignalReadPacket(this, packet.data, packet.size, packet.packet_time_us,
+                     packet.flags);
+  }
+}
+
 }  // namespace rtc
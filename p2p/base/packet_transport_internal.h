@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "p2p/base/port.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/network_route.h"
@@ -26,6 +27,15 @@ namespace rtc {
 struct PacketOptions;
 struct SentPacket;
 
+// A packet handed up through PacketTransportInternal::SignalReadPackets.
+// `data` is only valid for the duration of the signal.
+struct ReceivedPacketView {
+  const char* data;
+  size_t size;
+  int64_t packet_time_us;
+  int flags;
+};
+
 class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
  public:
   virtual const std::string& transport_name() const = 0;
@@ -88,6 +98,16 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
                    int>
       SignalReadPacket;
 
+  // Signalled with a batch of packets received on this channel, in arrival
+  // order. Transports only batch packets that need no further protocol
+  // handling of their own (e.g. SRTP packets passing through DTLS), and only
+  // when a listener is connected; otherwise the packets are signalled one by
+  // one through SignalReadPacket. A listener that connects to this signal
+  // must therefore also handle SignalReadPacket.
+  sigslot::signal2<PacketTransportInternal*,
+                   rtc::ArrayView<const ReceivedPacketView>>
+      SignalReadPackets;
+
   // Signalled each time a packet is sent on this channel.
   sigslot::signal2<PacketTransportInternal*, const rtc::SentPacket&>
       SignalSentPacket;
@@ -101,6 +121,10 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
  protected:
   PacketTransportInternal();
   ~PacketTransportInternal() override;
+
+  // Signals `packets` through SignalReadPackets if anyone listens to it, and
+  // through SignalReadPacket otherwise.
+  void NotifyPacketsReceived(rtc::ArrayView<const ReceivedPacketView> packets);
 };
 
 }  // namespace rtc
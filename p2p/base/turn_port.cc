@@ -430,6 +430,9 @@ bool TurnPort::CreateTurnClientSocket() {
       } else {
         opts |= rtc::PacketSocketFactory::OPT_TLS;
       }
+      if (field_trials().IsEnabled("WebRTC-Turn-KernelTlsOffload")) {
+        opts |= rtc::PacketSocketFactory::OPT_TLS_KERNEL_OFFLOAD;
+      }
     }
 
     rtc::PacketSocketTcpOptions tcp_options;
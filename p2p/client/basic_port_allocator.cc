@@ -887,7 +887,9 @@ std::vector<const rtc::Network*> BasicPortAllocatorSession::SelectIPv6Networks(
 
 // For each network, see if we have a sequence that covers it already.  If not,
 // create a new sequence to create the appropriate ports.
-void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
+void BasicPortAllocatorSession::DoAllocate(
+    bool disable_equivalent,
+    const std::vector<const rtc::Network*>* changed_networks) {
   RTC_DCHECK_RUN_ON(network_thread_);
   bool done_signal_needed = false;
   std::vector<const rtc::Network*> networks = GetNetworks();
@@ -896,6 +898,14 @@ void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
         << "Machine has no networks; no ports will be allocated";
     done_signal_needed = true;
   } else {
+    if (changed_networks) {
+      networks.erase(std::remove_if(networks.begin(), networks.end(),
+                                    [changed_networks](const rtc::Network* n) {
+                                      return !absl::c_linear_search(
+                                          *changed_networks, n);
+                                    }),
+                     networks.end());
+    }
     RTC_LOG(LS_INFO) << "Allocate ports on " << NetworksToString(networks);
     PortConfiguration* config =
         configs_.empty() ? nullptr : configs_.back().get();
@@ -976,13 +986,22 @@ void BasicPortAllocatorSession::OnNetworksChanged() {
     PrunePortsAndRemoveCandidates(ports_to_prune);
   }
 
-  if (allocation_started_ && !IsStopped()) {
+  // Once the session has seen the networks, only those that were added or
+  // modified can need new ports.
+  absl::optional<std::vector<const rtc::Network*>> changed_networks;
+  if (network_manager_started_) {
+    changed_networks = allocator_->network_manager()->GetChangedNetworks();
+  }
+  bool nothing_changed = changed_networks && changed_networks->empty() &&
+                         failed_networks.empty();
+  if (allocation_started_ && !IsStopped() && !nothing_changed) {
     if (network_manager_started_) {
       // If the network manager has started, it must be regathering.
       SignalIceRegathering(this, IceRegatheringReason::NETWORK_CHANGE);
     }
     bool disable_equivalent_phases = true;
-    DoAllocate(disable_equivalent_phases);
+    DoAllocate(disable_equivalent_phases,
+               changed_networks ? &*changed_networks : nullptr);
   }
 
   if (!network_manager_started_) {
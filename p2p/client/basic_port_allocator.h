@@ -243,7 +243,10 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession {
   void OnConfigStop();
   void AllocatePorts();
   void OnAllocate(int allocation_epoch);
-  void DoAllocate(bool disable_equivalent_phases);
+  // Allocates ports on all networks, or only on `changed_networks` if given.
+  void DoAllocate(
+      bool disable_equivalent_phases,
+      const std::vector<const rtc::Network*>* changed_networks = nullptr);
   void OnNetworksChanged();
   void OnAllocationSequenceObjectsCreated();
   void DisableEquivalentPhases(const rtc::Network* network,
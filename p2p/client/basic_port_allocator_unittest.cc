@@ -10,11 +10,16 @@
 
 #include "p2p/client/basic_port_allocator.h"
 
+#include <functional>
 #include <memory>
 #include <ostream>  // no-presubmit-check TODO(webrtc:8982)
+#include <utility>
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/string_view.h"
+#include "api/async_dns_resolver.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "p2p/base/p2p_constants.h"
 #include "p2p/base/stun_port.h"
@@ -130,6 +135,39 @@ void CheckStunKeepaliveIntervalOfAllReadyPorts(
   }
 }
 
+// Resolves every hostname to the IPv4 address of the test STUN server.
+class StunServerResolver : public webrtc::AsyncDnsResolverInterface,
+                           public webrtc::AsyncDnsResolverResult {
+ public:
+  void Start(const rtc::SocketAddress& addr,
+             std::function<void()> callback) override {
+    Start(addr, AF_UNSPEC, std::move(callback));
+  }
+  void Start(const rtc::SocketAddress& addr,
+             int family,
+             std::function<void()> callback) override {
+    addr_ = addr;
+    rtc::Thread::Current()->PostTask(
+        webrtc::SafeTask(safety_.flag(), std::move(callback)));
+  }
+  const webrtc::AsyncDnsResolverResult& result() const override {
+    return *this;
+  }
+  bool GetResolvedAddress(int family, rtc::SocketAddress* addr) const override {
+    if (family != AF_INET) {
+      return false;
+    }
+    *addr = addr_;
+    addr->SetResolvedIP(kStunAddr.ipaddr());
+    return true;
+  }
+  int GetError() const override { return 0; }
+
+ private:
+  rtc::SocketAddress addr_;
+  webrtc::ScopedTaskSafety safety_;
+};
+
 }  // namespace
 
 namespace cricket {
@@ -1063,6 +1101,43 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithMinimumStepDelay) {
   EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
 }
 
+// Tests that sessions whose socket factory caches DNS results resolve a STUN
+// server given by hostname once between them.
+TEST_F(BasicPortAllocatorTest, SessionsShareCachedStunServerResolution) {
+  AddInterface(kClientAddr);
+  int resolvers_created = 0;
+  auto socket_factory =
+      std::make_unique<rtc::BasicPacketSocketFactory>(fss_.get());
+  socket_factory->EnableDnsCache(webrtc::TimeDelta::Minutes(1), [&] {
+    ++resolvers_created;
+    return std::make_unique<StunServerResolver>();
+  });
+  ServerAddresses stun_servers;
+  stun_servers.insert(SocketAddress("stun.example.org", kStunAddr.port()));
+  allocator_ = std::make_unique<BasicPortAllocator>(
+      &network_manager_, std::move(socket_factory), stun_servers,
+      &field_trials_);
+  allocator_->Initialize();
+  allocator_->set_step_delay(kMinimumStepDelay);
+  allocator_->SetIceTiebreaker(kTiebreakerDefault);
+
+  std::unique_ptr<PortAllocatorSession> session1 =
+      CreateSession("session1", ICE_CANDIDATE_COMPONENT_RTP);
+  std::unique_ptr<PortAllocatorSession> session2 =
+      CreateSession("session2", ICE_CANDIDATE_COMPONENT_RTP);
+  session1->StartGettingPorts();
+  session2->StartGettingPorts();
+  auto stun_candidates = [this] {
+    return absl::c_count_if(candidates_, [](const Candidate& candidate) {
+      return candidate.type() == STUN_PORT_TYPE;
+    });
+  };
+  EXPECT_EQ_SIMULATED_WAIT(2, stun_candidates(), kDefaultAllocationTimeout,
+                           fake_clock);
+  EXPECT_EQ(1, resolvers_created);
+  EXPECT_TRUE(HasCandidate(candidates_, "stun", "udp", kClientAddr));
+}
+
 // Test that when the same network interface is brought down and up, the
 // port allocator session will restart a new allocation sequence if
 // it is not stopped.
@@ -2415,6 +2490,28 @@ TEST_F(BasicPortAllocatorTest, IceRegatheringMetricsLoggedWhenNetworkChanges) {
                        static_cast<int>(IceRegatheringReason::NETWORK_CHANGE)));
 }
 
+// Test that a session doesn't regather when the network manager signals again
+// without any network having changed, e.g. because another session started.
+TEST_F(BasicPortAllocatorTest, NoRegatheringWhenNoNetworkChanged) {
+  ResetWithNoServersOrNat();
+  AddInterface(kClientAddr, "test_net0");
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  EXPECT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultAllocationTimeout, fake_clock);
+  size_t num_ports = ports_.size();
+
+  auto session2 = CreateSession("session2", ICE_CANDIDATE_COMPONENT_RTP);
+  session2->StartGettingPorts();
+  SIMULATED_WAIT(false, 1000, fake_clock);
+  EXPECT_METRIC_EQ(0,
+                   webrtc::metrics::NumEvents(
+                       "WebRTC.PeerConnection.IceRegatheringReason",
+                       static_cast<int>(IceRegatheringReason::NETWORK_CHANGE)));
+  // Only the second session's ports were added.
+  EXPECT_EQ(2 * num_ports, ports_.size());
+}
+
 // Test that when an mDNS responder is present, the local address of a host
 // candidate is concealed by an mDNS hostname and the related address of a srflx
 // candidate is set to 0.0.0.0 or ::0.
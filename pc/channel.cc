@@ -200,10 +200,10 @@ bool BaseChannel::SetRtpTransport(webrtc::RtpTransportInternal* rtp_transport) {
   if (rtp_transport_) {
     DisconnectFromRtpTransport_n();
     // Clear the cached header extensions on the worker.
-    worker_thread_->PostTask(SafeTask(alive_, [this] {
+    RunOnWorkerThread([this] {
       RTC_DCHECK_RUN_ON(worker_thread());
       rtp_header_extensions_.clear();
-    }));
+    });
   }
 
   rtp_transport_ = rtp_transport;
@@ -554,15 +554,24 @@ void BaseChannel::ChannelWritable_n() {
   // We only have to do this PostTask once, when first transitioning to
   // writable.
   if (!was_ever_writable_n_) {
-    worker_thread_->PostTask(SafeTask(alive_, [this] {
+    RunOnWorkerThread([this] {
       RTC_DCHECK_RUN_ON(worker_thread());
       was_ever_writable_ = true;
       UpdateMediaSendRecvState_w();
-    }));
+    });
   }
   was_ever_writable_n_ = true;
 }
 
+void BaseChannel::RunOnWorkerThread(absl::AnyInvocable<void() &&> task) {
+  RTC_DCHECK_RUN_ON(network_thread());
+  if (worker_thread_ == network_thread_) {
+    std::move(task)();
+  } else {
+    worker_thread_->PostTask(SafeTask(alive_, std::move(task)));
+  }
+}
+
 void BaseChannel::ChannelNotWritable_n() {
   TRACE_EVENT0("webrtc", "BaseChannel::ChannelNotWritable_n");
   if (!writable_) {
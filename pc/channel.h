@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/crypto/crypto_options.h"
@@ -243,6 +244,10 @@ class BaseChannel : public ChannelInterface,
   void UpdateWritableState_n() RTC_RUN_ON(network_thread());
   void ChannelWritable_n() RTC_RUN_ON(network_thread());
   void ChannelNotWritable_n() RTC_RUN_ON(network_thread());
+  // Runs `task` on the worker thread. The task is run synchronously when the
+  // worker and network threads are the same, otherwise it is posted.
+  void RunOnWorkerThread(absl::AnyInvocable<void() &&> task)
+      RTC_RUN_ON(network_thread());
 
   bool SetPayloadTypeDemuxingEnabled_w(bool enabled)
       RTC_RUN_ON(worker_thread());
@@ -152,8 +152,12 @@ ConnectionContext::ConnectionContext(
         network_monitor_factory_.get(), socket_factory, &field_trials());
   }
   if (!default_socket_factory_) {
-    default_socket_factory_ =
+    auto basic_socket_factory =
         std::make_unique<rtc::BasicPacketSocketFactory>(socket_factory);
+    if (dependencies->dns_cache_ttl) {
+      basic_socket_factory->EnableDnsCache(*dependencies->dns_cache_ttl);
+    }
+    default_socket_factory_ = std::move(basic_socket_factory);
   }
   // Set warning levels on the threads, to give warnings when response
   // may be slower than is expected of the thread.
@@ -3012,6 +3012,11 @@ PeerConnection::InitializeRtcpCallback() {
   RTC_DCHECK_RUN_ON(network_thread());
   return [this](const rtc::CopyOnWriteBuffer& packet,
                 int64_t /*packet_time_us*/) {
+    if (worker_thread() == network_thread()) {
+      // Single-thread configuration; deliver directly.
+      call_ptr_->Receiver()->DeliverRtcpPacket(packet);
+      return;
+    }
     worker_thread()->PostTask(SafeTask(worker_thread_safety_, [this, packet]() {
       call_ptr_->Receiver()->DeliverRtcpPacket(packet);
     }));
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -27,6 +28,36 @@
 
 namespace webrtc {
 
+namespace {
+
+Timestamp ToArrivalTime(int64_t packet_time_us) {
+  return packet_time_us == -1 ? Timestamp::MinusInfinity()
+                              : Timestamp::Micros(packet_time_us);
+}
+
+// Returns the type of the packet, or kUnknown if it is neither RTP nor RTCP
+// or has an invalid size.
+cricket::RtpPacketType ValidatedPacketType(rtc::ArrayView<const char> packet) {
+  // When using RTCP multiplexing we might get RTCP packets on the RTP
+  // transport. We check the RTP payload type to determine if it is RTCP.
+  cricket::RtpPacketType packet_type = cricket::InferRtpPacketType(packet);
+  // Filter out the packet that is neither RTP nor RTCP.
+  if (packet_type == cricket::RtpPacketType::kUnknown) {
+    return packet_type;
+  }
+
+  // Protect ourselves against crazy data.
+  if (!cricket::IsValidRtpPacketSize(packet_type, packet.size())) {
+    RTC_LOG(LS_ERROR) << "Dropping incoming "
+                      << cricket::RtpPacketTypeToString(packet_type)
+                      << " packet: wrong size=" << packet.size();
+    return cricket::RtpPacketType::kUnknown;
+  }
+  return packet_type;
+}
+
+}  // namespace
+
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
   MaybeSignalReadyToSend();
@@ -55,6 +86,7 @@ void RtpTransport::SetRtpPacketTransport(
   if (rtp_packet_transport_) {
     rtp_packet_transport_->SignalReadyToSend.disconnect(this);
     rtp_packet_transport_->SignalReadPacket.disconnect(this);
+    rtp_packet_transport_->SignalReadPackets.disconnect(this);
     rtp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtp_packet_transport_->SignalWritableState.disconnect(this);
     rtp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -66,6 +98,8 @@ void RtpTransport::SetRtpPacketTransport(
         this, &RtpTransport::OnReadyToSend);
     new_packet_transport->SignalReadPacket.connect(this,
                                                    &RtpTransport::OnReadPacket);
+    new_packet_transport->SignalReadPackets.connect(
+        this, &RtpTransport::OnReadPackets);
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
     new_packet_transport->SignalWritableState.connect(
@@ -91,6 +125,7 @@ void RtpTransport::SetRtcpPacketTransport(
   if (rtcp_packet_transport_) {
     rtcp_packet_transport_->SignalReadyToSend.disconnect(this);
     rtcp_packet_transport_->SignalReadPacket.disconnect(this);
+    rtcp_packet_transport_->SignalReadPackets.disconnect(this);
     rtcp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtcp_packet_transport_->SignalWritableState.disconnect(this);
     rtcp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -102,6 +137,8 @@ void RtpTransport::SetRtcpPacketTransport(
         this, &RtpTransport::OnReadyToSend);
     new_packet_transport->SignalReadPacket.connect(this,
                                                    &RtpTransport::OnReadPacket);
+    new_packet_transport->SignalReadPackets.connect(
+        this, &RtpTransport::OnReadPackets);
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
     new_packet_transport->SignalWritableState.connect(
@@ -182,10 +219,8 @@ bool RtpTransport::UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) {
 
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) {
-  webrtc::RtpPacketReceived parsed_packet(
-      &header_extension_map_, packet_time_us == -1
-                                  ? Timestamp::MinusInfinity()
-                                  : Timestamp::Micros(packet_time_us));
+  webrtc::RtpPacketReceived parsed_packet(&header_extension_map_,
+                                          ToArrivalTime(packet_time_us));
   if (!parsed_packet.Parse(std::move(packet))) {
     RTC_LOG(LS_ERROR)
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
@@ -198,6 +233,27 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
   }
 }
 
+void RtpTransport::DemuxPackets(std::vector<ReceivedRtpBuffer> packets) {
+  std::vector<webrtc::RtpPacketReceived> parsed_packets;
+  parsed_packets.reserve(packets.size());
+  for (ReceivedRtpBuffer& received : packets) {
+    parsed_packets.emplace_back(&header_extension_map_,
+                                ToArrivalTime(received.packet_time_us));
+    if (!parsed_packets.back().Parse(std::move(received.packet))) {
+      RTC_LOG(LS_ERROR) << "Failed to parse the incoming RTP packet before "
+                           "demuxing. Drop it.";
+      parsed_packets.pop_back();
+    }
+  }
+
+  size_t forwarded = rtp_demuxer_.OnRtpPackets(parsed_packets);
+  if (forwarded != parsed_packets.size()) {
+    RTC_LOG(LS_WARNING) << "Failed to demux "
+                        << parsed_packets.size() - forwarded << " of "
+                        << parsed_packets.size() << " RTP packets in batch.";
+  }
+}
+
 bool RtpTransport::IsTransportWritable() {
   auto rtcp_packet_transport =
       rtcp_mux_enabled_ ? nullptr : rtcp_packet_transport_;
@@ -233,6 +289,11 @@ void RtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
   DemuxPacket(packet, packet_time_us);
 }
 
+void RtpTransport::OnRtpPacketsReceived(
+    std::vector<ReceivedRtpBuffer> packets) {
+  DemuxPackets(std::move(packets));
+}
+
 void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                         int64_t packet_time_us) {
   SignalRtcpPacketReceived(&packet, packet_time_us);
@@ -245,23 +306,12 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
                                 int flags) {
   TRACE_EVENT0("webrtc", "RtpTransport::OnReadPacket");
 
-  // When using RTCP multiplexing we might get RTCP packets on the RTP
-  // transport. We check the RTP payload type to determine if it is RTCP.
-  auto array_view = rtc::MakeArrayView(data, len);
-  cricket::RtpPacketType packet_type = cricket::InferRtpPacketType(array_view);
-  // Filter out the packet that is neither RTP nor RTCP.
+  cricket::RtpPacketType packet_type =
+      ValidatedPacketType(rtc::MakeArrayView(data, len));
   if (packet_type == cricket::RtpPacketType::kUnknown) {
     return;
   }
 
-  // Protect ourselves against crazy data.
-  if (!cricket::IsValidRtpPacketSize(packet_type, len)) {
-    RTC_LOG(LS_ERROR) << "Dropping incoming "
-                      << cricket::RtpPacketTypeToString(packet_type)
-                      << " packet: wrong size=" << len;
-    return;
-  }
-
   rtc::CopyOnWriteBuffer packet(data, len);
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
@@ -270,6 +320,37 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
   }
 }
 
+void RtpTransport::OnReadPackets(
+    rtc::PacketTransportInternal* transport,
+    rtc::ArrayView<const rtc::ReceivedPacketView> packets) {
+  TRACE_EVENT0("webrtc", "RtpTransport::OnReadPackets");
+
+  std::vector<ReceivedRtpBuffer> rtp_packets;
+  rtp_packets.reserve(packets.size());
+  for (const rtc::ReceivedPacketView& received : packets) {
+    cricket::RtpPacketType packet_type =
+        ValidatedPacketType(rtc::MakeArrayView(received.data, received.size));
+    if (packet_type == cricket::RtpPacketType::kUnknown) {
+      continue;
+    }
+    rtc::CopyOnWriteBuffer packet(received.data, received.size);
+    if (packet_type == cricket::RtpPacketType::kRtcp) {
+      // Hand on the RTP packets that arrived before this one first, so that
+      // packets are delivered in arrival order.
+      if (!rtp_packets.empty()) {
+        OnRtpPacketsReceived(std::move(rtp_packets));
+        rtp_packets.clear();
+      }
+      OnRtcpPacketReceived(std::move(packet), received.packet_time_us);
+    } else {
+      rtp_packets.push_back({std::move(packet), received.packet_time_us});
+    }
+  }
+  if (!rtp_packets.empty()) {
+    OnRtpPacketsReceived(std::move(rtp_packets));
+  }
+}
+
 void RtpTransport::SetReadyToSend(bool rtcp, bool ready) {
   if (rtcp) {
     rtcp_ready_to_send_ = ready;
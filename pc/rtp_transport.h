@@ -15,8 +15,10 @@
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "call/rtp_demuxer.h"
 #include "call/video_receive_stream.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -88,8 +90,16 @@ class RtpTransport : public RtpTransportInternal {
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
  protected:
+  // An RTP packet as read from the packet transport, before parsing.
+  struct ReceivedRtpBuffer {
+    rtc::CopyOnWriteBuffer packet;
+    int64_t packet_time_us;
+  };
+
   // These methods will be used in the subclasses.
   void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
+  // Parses and demuxes `packets` in one pass over the demuxer.
+  void DemuxPackets(std::vector<ReceivedRtpBuffer> packets);
 
   bool SendPacket(bool rtcp,
                   rtc::CopyOnWriteBuffer* packet,
@@ -101,6 +111,8 @@ class RtpTransport : public RtpTransportInternal {
       absl::optional<rtc::NetworkRoute> network_route);
   virtual void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                    int64_t packet_time_us);
+  // Receives the RTP packets of a batch read through SignalReadPackets.
+  virtual void OnRtpPacketsReceived(std::vector<ReceivedRtpBuffer> packets);
   virtual void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                     int64_t packet_time_us);
   // Overridden by SrtpTransport and DtlsSrtpTransport.
@@ -115,6 +127,8 @@ class RtpTransport : public RtpTransportInternal {
                     size_t len,
                     const int64_t& packet_time_us,
                     int flags);
+  void OnReadPackets(rtc::PacketTransportInternal* transport,
+                     rtc::ArrayView<const rtc::ReceivedPacketView> packets);
 
   // Updates "ready to send" for an individual channel and fires
   // SignalReadyToSend.
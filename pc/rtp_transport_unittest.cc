@@ -10,6 +10,8 @@
 
 #include "pc/rtp_transport.h"
 
+#include <string>
+
 #include "p2p/base/fake_packet_transport.h"
 #include "pc/test/rtp_transport_test_util.h"
 #include "rtc_base/buffer.h"
@@ -316,4 +318,75 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// Test that a batch read through SignalReadPackets demuxes the RTP packets
+// and signals the RTCP packets in it.
+TEST(RtpTransportTest, SignalPacketsReceivedInBatch) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  // Add a handled payload type.
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const unsigned char rtcp_data[] = {0x80, 73, 0, 0};
+  const unsigned char garbage_data[] = {0x00, 0x00};
+  rtc::CopyOnWriteBuffer packets[] = {
+      rtc::CopyOnWriteBuffer(kRtpData, kRtpLen),
+      rtc::CopyOnWriteBuffer(rtcp_data, sizeof(rtcp_data)),
+      rtc::CopyOnWriteBuffer(garbage_data, sizeof(garbage_data)),
+      rtc::CopyOnWriteBuffer(kRtpData, kRtpLen)};
+  fake_rtp.SendPackets(packets);
+  EXPECT_EQ(2, observer.rtp_count());
+  EXPECT_EQ(1, observer.rtcp_count());
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
+// Records the order in which RTP and RTCP packets are delivered.
+class PacketOrderObserver : public RtpPacketSinkInterface,
+                            public sigslot::has_slots<> {
+ public:
+  explicit PacketOrderObserver(RtpTransportInternal* rtp_transport) {
+    rtp_transport->SignalRtcpPacketReceived.connect(
+        this, &PacketOrderObserver::OnRtcpPacketReceived);
+  }
+
+  void OnRtpPacket(const RtpPacketReceived& packet) override { order_ += "p"; }
+
+  void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer* packet,
+                            int64_t packet_time_us) {
+    order_ += "c";
+  }
+
+  const std::string& order() const { return order_; }
+
+ private:
+  std::string order_;
+};
+
+// Test that RTCP packets in a batch are not delivered ahead of the RTP packets
+// that arrived before them.
+TEST(RtpTransportTest, SignalPacketsInBatchInArrivalOrder) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  PacketOrderObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const unsigned char rtcp_data[] = {0x80, 73, 0, 0};
+  const rtc::CopyOnWriteBuffer rtp(kRtpData, kRtpLen);
+  const rtc::CopyOnWriteBuffer rtcp(rtcp_data, sizeof(rtcp_data));
+  rtc::CopyOnWriteBuffer packets[] = {rtp, rtcp, rtp, rtp, rtcp};
+  fake_rtp.SendPackets(packets);
+  EXPECT_EQ(observer.order(), "pcppc");
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 }  // namespace webrtc
@@ -206,6 +206,36 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
         << "Inactive SRTP transport received an RTP packet. Drop it.";
     return;
   }
+  if (!UnprotectRtpBuffer(packet)) {
+    return;
+  }
+  DemuxPacket(std::move(packet), packet_time_us);
+}
+
+void SrtpTransport::OnRtpPacketsReceived(
+    std::vector<ReceivedRtpBuffer> packets) {
+  TRACE_EVENT0("webrtc", "SrtpTransport::OnRtpPacketsReceived");
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_WARNING) << "Inactive SRTP transport received "
+                        << packets.size() << " RTP packets. Drop them.";
+    return;
+  }
+  // Unprotect in place, compacting the accepted packets to the front.
+  size_t accepted = 0;
+  for (ReceivedRtpBuffer& received : packets) {
+    if (!UnprotectRtpBuffer(received.packet)) {
+      continue;
+    }
+    if (&packets[accepted] != &received) {
+      packets[accepted] = std::move(received);
+    }
+    ++accepted;
+  }
+  packets.resize(accepted);
+  DemuxPackets(std::move(packets));
+}
+
+bool SrtpTransport::UnprotectRtpBuffer(rtc::CopyOnWriteBuffer& packet) {
   char* data = packet.MutableData<char>();
   int len = rtc::checked_cast<int>(packet.size());
   if (!UnprotectRtp(data, len, &len)) {
@@ -220,10 +250,10 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                         << decryption_failure_count_;
     }
     ++decryption_failure_count_;
-    return;
+    return false;
   }
   packet.SetSize(len);
-  DemuxPacket(std::move(packet), packet_time_us);
+  return true;
 }
 
 void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -119,6 +119,7 @@ class SrtpTransport : public RtpTransport {
 
   void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                            int64_t packet_time_us) override;
+  void OnRtpPacketsReceived(std::vector<ReceivedRtpBuffer> packets) override;
   void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                             int64_t packet_time_us) override;
   void OnNetworkRouteChanged(
@@ -137,6 +138,10 @@ class SrtpTransport : public RtpTransport {
                   int64_t* index);
   bool ProtectRtcp(void* data, int in_len, int max_len, int* out_len);
 
+  // Unprotects `packet` in place and shrinks it to the plain RTP size.
+  // Returns false, logging at a throttled rate, if the packet is rejected.
+  bool UnprotectRtpBuffer(rtc::CopyOnWriteBuffer& packet);
+
   // Decrypts/verifies an invidiual RTP/RTCP packet.
   // If an HMAC is used, this will decrease the packet size.
   bool UnprotectRtp(void* data, int in_len, int* out_len);
@@ -1465,7 +1465,10 @@ class PeerConnectionIntegrationBaseTest : public ::testing::Test {
         new PeerConnectionIntegrationWrapper(debug_name));
 
     if (!client->Init(options, &modified_config, std::move(dependencies),
-                      fss_.get(), network_thread_.get(), worker_thread_.get(),
+                      fss_.get(), network_thread_.get(),
+                      use_network_thread_as_worker_thread_
+                          ? network_thread_.get()
+                          : worker_thread_.get(),
                       std::move(event_log_factory), reset_encoder_factory,
                       reset_decoder_factory, create_media_engine)) {
       return nullptr;
@@ -1698,6 +1701,12 @@ class PeerConnectionIntegrationBaseTest : public ::testing::Test {
 
   rtc::Thread* network_thread() { return network_thread_.get(); }
 
+  // Makes PeerConnections created after this call run their worker duties on
+  // the network thread.
+  void UseNetworkThreadAsWorkerThread() {
+    use_network_thread_as_worker_thread_ = true;
+  }
+
   rtc::VirtualSocketServer* virtual_socket_server() { return ss_.get(); }
 
   PeerConnectionIntegrationWrapper* caller() { return caller_.get(); }
@@ -1914,6 +1923,7 @@ class PeerConnectionIntegrationBaseTest : public ::testing::Test {
   // later.
   std::unique_ptr<rtc::Thread> network_thread_;
   std::unique_ptr<rtc::Thread> worker_thread_;
+  bool use_network_thread_as_worker_thread_ = false;
   // The turn servers and turn customizers should be accessed & deleted on the
   // network thread to avoid a race with the socket read/write that occurs
   // on the network thread.
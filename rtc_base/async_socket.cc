@@ -94,6 +94,11 @@ int AsyncSocketAdapter::SetOption(Option opt, int value) {
   return socket_->SetOption(opt, value);
 }
 
+int AsyncSocketAdapter::EnableKernelTlsTx(const void* crypto_info,
+                                          size_t size) {
+  return socket_->EnableKernelTlsTx(crypto_info, size);
+}
+
 void AsyncSocketAdapter::OnConnectEvent(Socket* socket) {
   SignalConnectEvent(this);
 }
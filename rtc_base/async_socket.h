@@ -47,6 +47,7 @@ class AsyncSocketAdapter : public Socket, public sigslot::has_slots<> {
   ConnState GetState() const override;
   int GetOption(Option opt, int* value) override;
   int SetOption(Option opt, int value) override;
+  int EnableKernelTlsTx(const void* crypto_info, size_t size) override;
 
  protected:
   virtual void OnConnectEvent(Socket* socket);
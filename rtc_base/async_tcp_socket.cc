@@ -133,8 +133,10 @@ int AsyncTCPSocketBase::SendTo(const void* pv,
 }
 
 int AsyncTCPSocketBase::FlushOutBuffer() {
-  RTC_DCHECK_GT(outbuf_.size(), 0);
-  rtc::ArrayView<uint8_t> view = outbuf_;
+  RTC_DCHECK_GT(outbuf_.size(), outpos_);
+  rtc::ArrayView<uint8_t> view =
+      rtc::ArrayView<uint8_t>(outbuf_).subview(outpos_);
+  const size_t pending_size = view.size();
   int res;
   while (view.size() > 0) {
     res = socket_->Send(view.data(), view.size());
@@ -152,25 +154,23 @@ int AsyncTCPSocketBase::FlushOutBuffer() {
     // The output buffer may have been written out over multiple partial Send(),
     // so reconstruct the total written length.
     RTC_DCHECK_EQ(view.size(), 0);
-    res = outbuf_.size();
-    outbuf_.Clear();
+    res = pending_size;
+    ClearOutBuffer();
   } else {
     // There was an error when calling Send(), so there will still be data left
     // to send at a later point.
     RTC_DCHECK_GT(view.size(), 0);
     // In the special case of EWOULDBLOCK, signal that we had a partial write.
     if (socket_->GetError() == EWOULDBLOCK) {
-      res = outbuf_.size() - view.size();
-    }
-    if (view.size() < outbuf_.size()) {
-      memmove(outbuf_.data(), view.data(), view.size());
-      outbuf_.SetSize(view.size());
+      res = pending_size - view.size();
     }
+    outpos_ = outbuf_.size() - view.size();
   }
   return res;
 }
 
 void AsyncTCPSocketBase::AppendToOutBuffer(const void* pv, size_t cb) {
+  RTC_DCHECK_EQ(outpos_, 0);
   RTC_DCHECK(outbuf_.size() + cb <= max_outsize_);
   outbuf_.AppendData(static_cast<const uint8_t*>(pv), cb);
 }
@@ -288,21 +288,27 @@ int AsyncTCPSocket::Send(const void* pv,
 void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
+  // Packets are signaled where they are in `data`, and the incomplete
+  // remainder is moved to the front once all complete packets are consumed.
+  size_t processed = 0;
   while (true) {
-    if (*len < kPacketLenSize)
-      return;
+    size_t bytes_left = *len - processed;
+    if (bytes_left < kPacketLenSize)
+      break;
 
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
+    PacketLength pkt_len = rtc::GetBE16(data + processed);
+    if (bytes_left < kPacketLenSize + pkt_len)
+      break;
 
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     TimeMicros());
+    SignalReadPacket(this, data + processed + kPacketLenSize, pkt_len,
+                     remote_addr, TimeMicros());
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+    processed += kPacketLenSize + pkt_len;
+  }
+
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -64,9 +64,12 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   // Add data to `outbuf_`.
   void AppendToOutBuffer(const void* pv, size_t cb);
 
-  // Helper methods for `outpos_`.
+  // Helper methods for `outbuf_` and `outpos_`.
   bool IsOutBufferEmpty() const { return outbuf_.size() == 0; }
-  void ClearOutBuffer() { outbuf_.Clear(); }
+  void ClearOutBuffer() {
+    outbuf_.Clear();
+    outpos_ = 0;
+  }
 
  private:
   // Called by the underlying socket
@@ -78,6 +81,9 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   std::unique_ptr<Socket> socket_;
   Buffer inbuf_;
   Buffer outbuf_;
+  // Number of bytes at the front of `outbuf_` that have already been sent.
+  // Kept instead of moving the unsent data to the front after partial sends.
+  size_t outpos_ = 0;
   size_t max_insize_;
   size_t max_outsize_;
 };
@@ -14,8 +14,11 @@
 
 #include <string>
 
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/network/received_packet_batch.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/time_utils.h"
@@ -113,11 +116,45 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  // Datagrams that are already queued on the socket are read in one loop and
+  // signaled as one ScopedReceivedPacketBatch. Each datagram is signaled once
+  // the next read has shown whether another one follows, so that a datagram
+  // that arrives on its own is signaled outside of a batch.
+  Datagram datagram;
+  if (!ReadDatagram(buf_[0], datagram)) {
+    return;
+  }
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> alive = safety_.flag();
+  absl::optional<ScopedReceivedPacketBatch> batch;
+  for (int i = 1;; ++i) {
+    Datagram next;
+    const bool has_next = i < kMaxDatagramsPerRead &&
+                          ReadDatagram(buf_[i % 2], next);
+    if (has_next && !batch) {
+      batch.emplace();
+    }
+    // TODO: Make sure that we got all of the packet.
+    // If we did not, then we should resize our buffer to be large enough.
+    SignalReadPacket(this, datagram.data, datagram.size, datagram.remote_addr,
+                     datagram.timestamp);
+    // The socket may have been destroyed by a receiver.
+    if (!has_next || !alive->alive()) {
+      return;
+    }
+    datagram = next;
+  }
+}
+
+bool AsyncUDPSocket::ReadDatagram(char* buffer, Datagram& datagram) {
   SocketAddress remote_addr;
   int64_t timestamp = -1;
-  int len = socket_->RecvFrom(buf_, BUF_SIZE, &remote_addr, &timestamp);
+  int len = socket_->RecvFrom(buffer, BUF_SIZE, &remote_addr, &timestamp);
 
   if (len < 0) {
+    if (socket_->IsBlocking()) {
+      // Nothing more to read.
+      return false;
+    }
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
     // When doing ICE, this kind of thing will often happen.
@@ -125,7 +162,7 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     SocketAddress local_addr = socket_->GetLocalAddress();
     RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
                      << "] receive failed with error " << socket_->GetError();
-    return;
+    return false;
   }
   if (timestamp == -1) {
     // Timestamp from socket is not available.
@@ -138,10 +175,11 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     timestamp += *socket_time_offset_;
   }
 
-  // TODO: Make sure that we got all of the packet.
-  // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(this, buf_, static_cast<size_t>(len), remote_addr,
-                   timestamp);
+  datagram.data = buffer;
+  datagram.size = static_cast<size_t>(len);
+  datagram.remote_addr = remote_addr;
+  datagram.timestamp = timestamp;
+  return true;
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -18,6 +18,7 @@
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
@@ -27,7 +28,9 @@
 namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
-// buffered since it is acceptable to drop packets under high load.
+// buffered since it is acceptable to drop packets under high load. Datagrams
+// that are queued on the socket when it becomes readable are signaled as one
+// rtc::ScopedReceivedPacketBatch.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
@@ -60,16 +63,32 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void SetError(int error) override;
 
  private:
+  struct Datagram {
+    char* data = nullptr;
+    size_t size = 0;
+    SocketAddress remote_addr;
+    int64_t timestamp = -1;
+  };
+
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
+  // Reads the next datagram queued on the socket into `buffer`. Returns false
+  // if there is none, or if the read failed.
+  bool ReadDatagram(char* buffer, Datagram& datagram);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
   static constexpr int BUF_SIZE = 64 * 1024;
-  char buf_[BUF_SIZE] RTC_GUARDED_BY(sequence_checker_);
+  // Upper bound on the datagrams read per read event, so that a busy socket
+  // doesn't starve the others.
+  static constexpr int kMaxDatagramsPerRead = 32;
+  // A datagram is read into one buffer while the previous one, in the other
+  // buffer, waits to be signaled.
+  char buf_[2][BUF_SIZE] RTC_GUARDED_BY(sequence_checker_);
   absl::optional<int64_t> socket_time_offset_ RTC_GUARDED_BY(sequence_checker_);
+  webrtc::ScopedTaskSafetyDetached safety_;
 };
 
 }  // namespace rtc
@@ -12,19 +12,21 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
-#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/network/received_packet_batch.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
+#include "test/gmock.h"
 
 namespace rtc {
 
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -33,12 +35,46 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
 
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets_.emplace_back(data, size);
+    batched_.push_back(ScopedReceivedPacketBatch::OnBatchEnd(
+        [this] { batch_ends_.push_back(packets_.size()); }));
+  }
+
+  void ListenForPackets(AsyncUDPSocket& udp_socket) {
+    udp_socket.SignalReadPacket.connect(this,
+                                        &AsyncUdpSocketTest::OnReadPacket);
+  }
+
+  // Returns a socket with `packets` queued on it, before anyone handles its
+  // read events.
+  Socket* CreateSocketWithQueuedPackets(
+      const std::vector<std::string>& packets) {
+    Socket* socket = vss_->CreateSocket(AF_INET, SOCK_DGRAM);
+    EXPECT_EQ(socket->Bind(SocketAddress("127.0.0.1", 0)), 0);
+    std::unique_ptr<Socket> sender(vss_->CreateSocket(AF_INET, SOCK_DGRAM));
+    EXPECT_EQ(sender->Bind(SocketAddress("127.0.0.1", 0)), 0);
+    for (const std::string& packet : packets) {
+      sender->SendTo(packet.data(), packet.size(), socket->GetLocalAddress());
+    }
+    vss_->ProcessMessagesUntilIdle();
+    return socket;
+  }
+
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
   bool ready_to_send_;
+  std::vector<std::string> packets_;
+  // Whether each packet was read as part of a batch.
+  std::vector<bool> batched_;
+  // The number of packets read when each batch end callback ran.
+  std::vector<size_t> batch_ends_;
 };
 
 TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
@@ -47,4 +83,28 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST_F(AsyncUdpSocketTest, SignalsQueuedDatagramsAsOneBatch) {
+  AutoSocketServerThread thread(vss_.get());
+  Socket* socket = CreateSocketWithQueuedPackets({"a", "bc", "def"});
+  AsyncUDPSocket udp_socket(socket);
+  ListenForPackets(udp_socket);
+
+  socket->SignalReadEvent(socket);
+  EXPECT_THAT(packets_, ::testing::ElementsAre("a", "bc", "def"));
+  EXPECT_THAT(batched_, ::testing::ElementsAre(true, true, true));
+  EXPECT_THAT(batch_ends_, ::testing::ElementsAre(3u, 3u, 3u));
+}
+
+TEST_F(AsyncUdpSocketTest, SignalsSingleDatagramOutsideOfBatch) {
+  AutoSocketServerThread thread(vss_.get());
+  Socket* socket = CreateSocketWithQueuedPackets({"a"});
+  AsyncUDPSocket udp_socket(socket);
+  ListenForPackets(udp_socket);
+
+  socket->SignalReadEvent(socket);
+  EXPECT_THAT(packets_, ::testing::ElementsAre("a"));
+  EXPECT_THAT(batched_, ::testing::ElementsAre(false));
+  EXPECT_TRUE(batch_ends_.empty());
+}
+
 }  // namespace rtc
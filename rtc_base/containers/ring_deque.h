@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_CONTAINERS_RING_DEQUE_H_
+#define RTC_BASE_CONTAINERS_RING_DEQUE_H_
+
+#include <stddef.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// A double ended queue stored in a single ring buffer.
+//
+// std::deque allocates and frees blocks as elements are pushed at one end and
+// popped at the other, which makes sliding windows of samples allocate all the
+// time. RingDeque only allocates when it grows past the largest size it has
+// had, so a window of bounded size stops allocating once it has filled up.
+//
+// Elements are kept constructed in the unused part of the buffer, so T must be
+// default constructible and move assignable. Popped elements are reset to T(),
+// unless T is trivially destructible. The capacity is a power of two.
+template <typename T>
+class RingDeque {
+ public:
+  RingDeque() = default;
+  RingDeque(const RingDeque&) = default;
+  RingDeque& operator=(const RingDeque&) = default;
+
+  // The moved-from deque is left empty.
+  RingDeque(RingDeque&& other)
+      : storage_(std::move(other.storage_)),
+        begin_(std::exchange(other.begin_, 0)),
+        size_(std::exchange(other.size_, 0)) {}
+  RingDeque& operator=(RingDeque&& other) {
+    if (this != &other) {
+      storage_ = std::move(other.storage_);
+      other.storage_.clear();
+      begin_ = std::exchange(other.begin_, 0);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return storage_.size(); }
+
+  T& operator[](size_t index) {
+    RTC_DCHECK_LT(index, size_);
+    return storage_[Wrap(begin_ + index)];
+  }
+  const T& operator[](size_t index) const {
+    RTC_DCHECK_LT(index, size_);
+    return storage_[Wrap(begin_ + index)];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[size_ - 1]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  void push_back(T value) {
+    if (size_ == capacity()) {
+      Grow();
+    }
+    storage_[Wrap(begin_ + size_)] = std::move(value);
+    ++size_;
+  }
+
+  void push_front(T value) {
+    if (size_ == capacity()) {
+      Grow();
+    }
+    begin_ = (begin_ == 0 ? capacity() : begin_) - 1;
+    storage_[begin_] = std::move(value);
+    ++size_;
+  }
+
+  void pop_front() {
+    RTC_DCHECK(!empty());
+    Release(storage_[begin_]);
+    begin_ = Wrap(begin_ + 1);
+    --size_;
+  }
+
+  void pop_back() {
+    RTC_DCHECK(!empty());
+    --size_;
+    Release(storage_[Wrap(begin_ + size_)]);
+  }
+
+  // Removes all elements, keeping the capacity.
+  void clear() {
+    while (!empty()) {
+      pop_back();
+    }
+    begin_ = 0;
+  }
+
+  void reserve(size_t capacity) {
+    size_t new_capacity = kMinCapacity;
+    while (new_capacity < capacity) {
+      new_capacity *= 2;
+    }
+    if (new_capacity > this->capacity()) {
+      Reallocate(new_capacity);
+    }
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 4;
+
+  size_t Wrap(size_t index) const { return index & (storage_.size() - 1); }
+
+  static void Release(T& element) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      element = T();
+    }
+  }
+
+  void Grow() { Reallocate(empty() ? kMinCapacity : 2 * capacity()); }
+
+  void Reallocate(size_t capacity) {
+    std::vector<T> storage(capacity);
+    for (size_t i = 0; i < size_; ++i) {
+      storage[i] = std::move((*this)[i]);
+    }
+    storage_.swap(storage);
+    begin_ = 0;
+  }
+
+  std::vector<T> storage_;
+  // Index in storage_ of the first element.
+  size_t begin_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_CONTAINERS_RING_DEQUE_H_
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/containers/ring_deque.h"
+
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(RingDequeTest, PushAndPopAtBothEnds) {
+  RingDeque<int> deque;
+  EXPECT_TRUE(deque.empty());
+  deque.push_back(2);
+  deque.push_back(3);
+  deque.push_front(1);
+  ASSERT_EQ(deque.size(), 3u);
+  EXPECT_EQ(deque.front(), 1);
+  EXPECT_EQ(deque[1], 2);
+  EXPECT_EQ(deque.back(), 3);
+
+  deque.pop_front();
+  EXPECT_EQ(deque.front(), 2);
+  deque.pop_back();
+  EXPECT_EQ(deque.back(), 2);
+  deque.pop_back();
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(RingDequeTest, MatchesStdDequeWhenWrappingAndGrowing) {
+  RingDeque<int> deque;
+  std::deque<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    // Grow by one element every third step, so that the ring both wraps
+    // around and reallocates while wrapped.
+    if (i % 3 == 0) {
+      deque.push_front(-i);
+      expected.push_front(-i);
+    } else {
+      deque.push_back(i);
+      expected.push_back(i);
+    }
+    if (i % 3 == 1) {
+      deque.pop_front();
+      expected.pop_front();
+    }
+    ASSERT_EQ(deque.size(), expected.size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      ASSERT_EQ(deque[j], expected[j]) << "step " << i << ", index " << j;
+    }
+  }
+}
+
+TEST(RingDequeTest, DoesNotGrowWhenSizeIsBounded) {
+  constexpr size_t kWindowSize = 10;
+  RingDeque<int> deque;
+  for (size_t i = 0; i < kWindowSize; ++i) {
+    deque.push_back(i);
+  }
+  const size_t capacity = deque.capacity();
+  for (int i = 0; i < 1000; ++i) {
+    deque.pop_front();
+    deque.push_back(i);
+  }
+  EXPECT_EQ(deque.capacity(), capacity);
+  EXPECT_EQ(deque.front(), 1000 - static_cast<int>(kWindowSize));
+  EXPECT_EQ(deque.back(), 999);
+}
+
+TEST(RingDequeTest, ClearKeepsCapacity) {
+  RingDeque<int> deque;
+  deque.reserve(16);
+  deque.push_back(1);
+  deque.push_back(2);
+  deque.clear();
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.capacity(), 16u);
+  deque.push_back(3);
+  EXPECT_EQ(deque.front(), 3);
+}
+
+TEST(RingDequeTest, PopReleasesElements) {
+  auto value = std::make_shared<int>(1);
+  RingDeque<std::shared_ptr<int>> deque;
+  deque.push_back(value);
+  deque.push_back(value);
+  EXPECT_EQ(value.use_count(), 3);
+  deque.pop_front();
+  EXPECT_EQ(value.use_count(), 2);
+  deque.pop_back();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(RingDequeTest, MovedFromDequeIsEmpty) {
+  RingDeque<int> deque;
+  deque.push_back(1);
+  deque.push_front(0);
+  RingDeque<int> moved(std::move(deque));
+  EXPECT_TRUE(deque.empty());  // NOLINT(bugprone-use-after-move)
+  ASSERT_EQ(moved.size(), 2u);
+  EXPECT_EQ(moved.front(), 0);
+  EXPECT_EQ(moved.back(), 1);
+
+  // The moved-from deque can be used again.
+  deque.push_back(2);
+  EXPECT_EQ(deque.front(), 2);
+
+  RingDeque<int> assigned;
+  assigned.push_back(3);
+  assigned = std::move(moved);
+  EXPECT_TRUE(moved.empty());  // NOLINT(bugprone-use-after-move)
+  ASSERT_EQ(assigned.size(), 2u);
+  EXPECT_EQ(assigned.front(), 0);
+  EXPECT_EQ(assigned.back(), 1);
+  moved.push_front(4);
+  EXPECT_EQ(moved.back(), 4);
+}
+
+}  // namespace
+}  // namespace webrtc
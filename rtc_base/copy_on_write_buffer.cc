@@ -12,10 +12,40 @@
 
 #include <stddef.h>
 
+#include <new>
+
 #include "absl/strings/string_view.h"
 
 namespace rtc {
 
+// static
+scoped_refptr<CopyOnWriteBuffer::Storage> CopyOnWriteBuffer::Storage::Create(
+    size_t capacity) {
+  void* memory = ::operator new(sizeof(Storage) + capacity);
+  return scoped_refptr<Storage>(new (memory) Storage(capacity));
+}
+
+// static
+scoped_refptr<CopyOnWriteBuffer::Storage> CopyOnWriteBuffer::Storage::Create(
+    const void* data,
+    size_t size,
+    size_t capacity) {
+  scoped_refptr<Storage> storage = Create(std::max(size, capacity));
+  if (size > 0) {
+    std::memcpy(storage->data(), data, size);
+  }
+  return storage;
+}
+
+RefCountReleaseStatus CopyOnWriteBuffer::Storage::Release() const {
+  const RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    this->~Storage();
+    ::operator delete(const_cast<Storage*>(this));
+  }
+  return status;
+}
+
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
 }
@@ -34,15 +64,16 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(absl::string_view s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedBuffer(size) : nullptr),
+    : buffer_(size > 0 ? Storage::Create(size) : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
-    : buffer_(size > 0 || capacity > 0 ? new RefCountedBuffer(size, capacity)
-                                       : nullptr),
+    : buffer_(size > 0 || capacity > 0
+                  ? Storage::Create(std::max(size, capacity))
+                  : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
@@ -62,7 +93,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (size > 0) {
-      buffer_ = new RefCountedBuffer(size);
+      buffer_ = Storage::Create(size);
       offset_ = 0;
       size_ = size;
     }
@@ -76,7 +107,6 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   }
 
   UnshareAndEnsureCapacity(std::max(capacity(), size));
-  buffer_->SetSize(size + offset_);
   size_ = size;
   RTC_DCHECK(IsConsistent());
 }
@@ -85,7 +115,7 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (new_capacity > 0) {
-      buffer_ = new RefCountedBuffer(0, new_capacity);
+      buffer_ = Storage::Create(new_capacity);
       offset_ = 0;
       size_ = 0;
     }
@@ -103,10 +133,8 @@ void CopyOnWriteBuffer::Clear() {
   if (!buffer_)
     return;
 
-  if (buffer_->HasOneRef()) {
-    buffer_->Clear();
-  } else {
-    buffer_ = new RefCountedBuffer(0, capacity());
+  if (!buffer_->HasOneRef()) {
+    buffer_ = Storage::Create(capacity());
   }
   offset_ = 0;
   size_ = 0;
@@ -118,8 +146,7 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
-  buffer_ =
-      new RefCountedBuffer(buffer_->data() + offset_, size_, new_capacity);
+  buffer_ = Storage::Create(buffer_->data() + offset_, size_, new_capacity);
   offset_ = 0;
   RTC_DCHECK(IsConsistent());
 }
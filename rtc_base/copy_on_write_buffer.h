@@ -23,7 +23,8 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
-#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counter.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/type_traits.h"
 
@@ -172,11 +173,11 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void SetData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = size > 0 ? new RefCountedBuffer(data, size) : nullptr;
-    } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedBuffer(data, size, capacity());
-    } else {
-      buffer_->SetData(data, size);
+      buffer_ = size > 0 ? Storage::Create(data, size, size) : nullptr;
+    } else if (!buffer_->HasOneRef() || size > buffer_->capacity()) {
+      buffer_ = Storage::Create(data, size, std::max(size, capacity()));
+    } else if (size > 0) {
+      std::memcpy(buffer_->data(), data, size);
     }
     offset_ = 0;
     size_ = size;
@@ -208,8 +209,11 @@ class RTC_EXPORT CopyOnWriteBuffer {
                 internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
   void AppendData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
+    if (size == 0) {
+      return;
+    }
     if (!buffer_) {
-      buffer_ = new RefCountedBuffer(data, size);
+      buffer_ = Storage::Create(data, size, size);
       offset_ = 0;
       size_ = size;
       RTC_DCHECK(IsConsistent());
@@ -218,9 +222,8 @@ class RTC_EXPORT CopyOnWriteBuffer {
 
     UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
 
-    buffer_->SetSize(offset_ +
-                     size_);  // Remove data to the right of the slice.
-    buffer_->AppendData(data, size);
+    // Overwrites any data to the right of the slice.
+    std::memcpy(buffer_->data() + offset_ + size_, data, size);
     size_ += size;
 
     RTC_DCHECK(IsConsistent());
@@ -276,7 +279,42 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  // Reference counted bytes of a fixed capacity. The bytes follow the header in
+  // the same allocation, so that a buffer costs one heap allocation rather
+  // than two. This matters for the many small packets of audio streams.
+  class RTC_EXPORT Storage {
+   public:
+    static scoped_refptr<Storage> Create(size_t capacity);
+    // Copies `size` bytes of `data` into storage of at least `size` bytes.
+    static scoped_refptr<Storage> Create(const void* data,
+                                         size_t size,
+                                         size_t capacity);
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+    template <typename T = uint8_t>
+    T* data() {
+      return reinterpret_cast<T*>(this + 1);
+    }
+    template <typename T = uint8_t>
+    const T* data() const {
+      return reinterpret_cast<const T*>(this + 1);
+    }
+    size_t capacity() const { return capacity_; }
+
+   private:
+    explicit Storage(size_t capacity) : capacity_(capacity) {}
+    ~Storage() = default;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    const size_t capacity_;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -284,15 +322,15 @@ class RTC_EXPORT CopyOnWriteBuffer {
   // Pre- and postcondition of all methods.
   bool IsConsistent() const {
     if (buffer_) {
-      return buffer_->capacity() > 0 && offset_ <= buffer_->size() &&
-             offset_ + size_ <= buffer_->size();
+      return buffer_->capacity() > 0 && offset_ <= buffer_->capacity() &&
+             offset_ + size_ <= buffer_->capacity();
     } else {
       return size_ == 0 && offset_ == 0;
     }
   }
 
-  // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
-  scoped_refptr<RefCountedBuffer> buffer_;
+  // buffer_ is either null, or points to storage with capacity > 0.
+  scoped_refptr<Storage> buffer_;
   // This buffer may represent a slice of a original data.
   size_t offset_;  // Offset of a current slice in the original data in buffer_.
                    // Should be 0 if the buffer_ is empty.
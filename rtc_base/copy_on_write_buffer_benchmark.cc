@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/unused.h"
+
+namespace rtc {
+namespace {
+
+// Header and payload sizes of a typical Opus packet.
+constexpr size_t kRtpHeaderSize = 12;
+constexpr size_t kOpusPayloadSize = 160;
+constexpr size_t kMaxPacketSize = 1500;
+
+const uint8_t kPayload[kOpusPayloadSize] = {};
+// Source of the received packets, large enough for any of them.
+const uint8_t kDatagram[kMaxPacketSize] = {};
+
+}  // namespace
+
+// A received packet: the bytes read from the socket are copied into a buffer.
+void BM_CopyIntoSmallBuffer(benchmark::State& state) {
+  const size_t size = state.range(0);
+  RTC_DCHECK_LE(size, kMaxPacketSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    CopyOnWriteBuffer buffer(kDatagram, size);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+// A sent packet: the header is written, then the payload appended.
+void BM_BuildPacket(benchmark::State& state) {
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    CopyOnWriteBuffer buffer(kRtpHeaderSize, kMaxPacketSize);
+    buffer.MutableData()[0] = 0x80;
+    buffer.AppendData(kPayload);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+
+// A packet handed to several consumers, the last of which modifies it.
+void BM_ShareAndUnshare(benchmark::State& state) {
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    CopyOnWriteBuffer buffer(kPayload);
+    CopyOnWriteBuffer shared = buffer;
+    CopyOnWriteBuffer payload = shared.Slice(kRtpHeaderSize,
+                                             kOpusPayloadSize - kRtpHeaderSize);
+    payload.MutableData()[0] = 1;
+    benchmark::DoNotOptimize(payload.data());
+  }
+}
+
+BENCHMARK(BM_CopyIntoSmallBuffer)->Arg(20)->Arg(kOpusPayloadSize)->Arg(1200);
+BENCHMARK(BM_BuildPacket);
+BENCHMARK(BM_ShareAndUnshare);
+
+}  // namespace rtc
+
+/*
+
+Results (Linux, glibc malloc, median CPU time of 5 runs), before and after
+storing the bytes of a buffer in the same allocation as its reference count:
+
+Benchmark                          Before        After
+------------------------------------------------------
+BM_CopyIntoSmallBuffer/20         43.3 ns      36.4 ns
+BM_CopyIntoSmallBuffer/160        46.9 ns      43.3 ns
+BM_CopyIntoSmallBuffer/1200       87.1 ns      84.2 ns
+BM_BuildPacket                     101 ns      80.5 ns
+BM_ShareAndUnshare                 172 ns       140 ns
+
+*/
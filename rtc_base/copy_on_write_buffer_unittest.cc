@@ -119,6 +119,26 @@ TEST(CopyOnWriteBufferTest, TestAppendData) {
   EXPECT_EQ(buf2, CopyOnWriteBuffer(exp));
 }
 
+TEST(CopyOnWriteBufferTest, AppendDataToUnsharedSliceKeepsStorage) {
+  CopyOnWriteBuffer buf(kTestData, 10, 10);
+  const uint8_t* data = buf.cdata();
+  buf = buf.Slice(2, 3);
+
+  // The bytes after the slice are overwritten in place.
+  buf.AppendData("ab", 2);
+  EXPECT_EQ(buf.cdata(), data + 2);
+  const int8_t exp[] = {0x2, 0x3, 0x4, 'a', 'b'};
+  EXPECT_EQ(buf, CopyOnWriteBuffer(exp));
+}
+
+TEST(CopyOnWriteBufferTest, AppendEmptyDataToEmptyBuffer) {
+  CopyOnWriteBuffer buf;
+  buf.AppendData(kTestData, 0);
+  EXPECT_EQ(buf.size(), 0u);
+  EXPECT_EQ(buf.capacity(), 0u);
+  EXPECT_EQ(buf.cdata(), nullptr);
+}
+
 TEST(CopyOnWriteBufferTest, SetEmptyData) {
   CopyOnWriteBuffer buf(10);
 
@@ -76,7 +76,8 @@ class FakeNetworkManager : public NetworkManagerBase {
       sent_first_update_ = false;
       Thread::Current()->PostTask([this] { DoUpdateNetworks(); });
     } else if (sent_first_update_) {
-      Thread::Current()->PostTask([this] { SignalNetworksChanged(); });
+      Thread::Current()->PostTask(
+          [this] { SignalNetworksChangedIncrementally({}); });
     }
   }
 
@@ -120,9 +121,11 @@ class FakeNetworkManager : public NetworkManagerBase {
     }
     bool changed;
     MergeNetworkList(std::move(networks), &changed);
-    if (changed || !sent_first_update_) {
+    if (!sent_first_update_) {
       SignalNetworksChanged();
       sent_first_update_ = true;
+    } else if (changed) {
+      SignalNetworksChangedIncrementally(merged_changed_networks());
     }
   }
 
@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/netlink_network_monitor.h"
+
+#include <errno.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/network.h"
+
+namespace rtc {
+
+namespace {
+
+using ::webrtc::SafeTask;
+
+// Large enough for the messages of a few interfaces at a time; the kernel
+// splits bigger bursts over several reads.
+constexpr size_t kReceiveBufferSize = 16 * 1024;
+
+// Gives bursts of messages, e.g. all the addresses of a new interface, time to
+// arrive before the networks are enumerated.
+constexpr webrtc::TimeDelta kUpdateDelay = webrtc::TimeDelta::Millis(100);
+
+// The interface flags that decide whether BasicNetworkManager uses an
+// interface.
+constexpr unsigned int kRelevantLinkFlags = IFF_UP | IFF_RUNNING;
+
+}  // namespace
+
+NetlinkNetworkMonitor::NetlinkNetworkMonitor() = default;
+
+NetlinkNetworkMonitor::~NetlinkNetworkMonitor() {
+  Stop();
+}
+
+void NetlinkNetworkMonitor::Start() {
+  if (netlink_fd_ >= 0) {
+    return;
+  }
+  thread_ = Thread::Current();
+
+  int netlink_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (netlink_fd < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to create netlink socket";
+    return;
+  }
+  struct sockaddr_nl address;
+  memset(&address, 0, sizeof(address));
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+  if (bind(netlink_fd, reinterpret_cast<struct sockaddr*>(&address),
+           sizeof(address)) < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to bind netlink socket";
+    close(netlink_fd);
+    return;
+  }
+  int wakeup_fd = eventfd(0, EFD_CLOEXEC);
+  if (wakeup_fd < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to create eventfd";
+    close(netlink_fd);
+    return;
+  }
+
+  netlink_fd_ = netlink_fd;
+  wakeup_fd_ = wakeup_fd;
+  link_flags_.clear();
+  safety_flag_ = webrtc::PendingTaskSafetyFlag::Create();
+  reader_thread_ = PlatformThread::SpawnJoinable(
+      [this, netlink_fd, wakeup_fd] { ReadMessages(netlink_fd, wakeup_fd); },
+      "NetlinkMonitor");
+}
+
+void NetlinkNetworkMonitor::Stop() {
+  if (netlink_fd_ < 0) {
+    return;
+  }
+  safety_flag_->SetNotAlive();
+  uint64_t value = 1;
+  if (write(wakeup_fd_, &value, sizeof(value)) < 0) {
+    RTC_LOG_ERR(LS_ERROR) << "Failed to wake up the netlink reader";
+  }
+  reader_thread_.Finalize();
+  close(netlink_fd_);
+  close(wakeup_fd_);
+  netlink_fd_ = -1;
+  wakeup_fd_ = -1;
+  update_pending_ = false;
+}
+
+NetworkMonitorInterface::InterfaceInfo NetlinkNetworkMonitor::GetInterfaceInfo(
+    absl::string_view interface_name) {
+  // Netlink doesn't say more about an interface than its name does.
+  return {.adapter_type = GetAdapterTypeFromName(interface_name),
+          .underlying_type_for_vpn = ADAPTER_TYPE_UNKNOWN,
+          .network_preference = NetworkPreference::NEUTRAL,
+          .available = true};
+}
+
+bool NetlinkNetworkMonitor::SupportsAddressChangeNotifications() const {
+  return netlink_fd_ >= 0;
+}
+
+bool NetlinkNetworkMonitor::HandleMessages(
+    rtc::ArrayView<const uint8_t> buffer) {
+  bool networks_changed = false;
+  size_t offset = 0;
+  while (buffer.size() - offset >= sizeof(struct nlmsghdr)) {
+    struct nlmsghdr header;
+    memcpy(&header, buffer.data() + offset, sizeof(header));
+    if (header.nlmsg_len < sizeof(header) ||
+        header.nlmsg_len > buffer.size() - offset) {
+      RTC_LOG(LS_WARNING) << "Malformed netlink message";
+      break;
+    }
+    switch (header.nlmsg_type) {
+      case RTM_NEWADDR:
+      case RTM_DELADDR:
+      case NLMSG_OVERRUN:
+        networks_changed = true;
+        break;
+      case RTM_NEWLINK:
+      case RTM_DELLINK: {
+        if (header.nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg))) {
+          break;
+        }
+        struct ifinfomsg info;
+        memcpy(&info, buffer.data() + offset + NLMSG_HDRLEN, sizeof(info));
+        // Links are also updated for reasons that don't matter here, such as
+        // MTU changes, so only look at whether they are up and running.
+        if (header.nlmsg_type == RTM_DELLINK) {
+          networks_changed |= link_flags_.erase(info.ifi_index) > 0;
+          break;
+        }
+        unsigned int flags = info.ifi_flags & kRelevantLinkFlags;
+        auto it = link_flags_.find(info.ifi_index);
+        if (it == link_flags_.end() || it->second != flags) {
+          link_flags_[info.ifi_index] = flags;
+          networks_changed = true;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    offset += NLMSG_ALIGN(header.nlmsg_len);
+    if (offset > buffer.size()) {
+      break;
+    }
+  }
+  return networks_changed;
+}
+
+void NetlinkNetworkMonitor::ReadMessages(int netlink_fd, int wakeup_fd) {
+  std::vector<uint8_t> buffer(kReceiveBufferSize);
+  struct pollfd fds[2] = {{netlink_fd, POLLIN, 0}, {wakeup_fd, POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RTC_LOG_ERR(LS_ERROR) << "Polling the netlink socket failed";
+      return;
+    }
+    if (fds[1].revents) {
+      return;
+    }
+    if (!(fds[0].revents & (POLLIN | POLLERR))) {
+      continue;
+    }
+    ssize_t length = recv(netlink_fd, buffer.data(), buffer.size(), 0);
+    if (length < 0) {
+      if (errno == ENOBUFS) {
+        // The kernel dropped messages, so anything may have changed.
+        link_flags_.clear();
+        ScheduleUpdate();
+      } else if (errno != EINTR && errno != EAGAIN) {
+        RTC_LOG_ERR(LS_ERROR) << "Reading the netlink socket failed";
+        return;
+      }
+      continue;
+    }
+    if (HandleMessages(rtc::ArrayView<const uint8_t>(buffer.data(), length))) {
+      ScheduleUpdate();
+    }
+  }
+}
+
+void NetlinkNetworkMonitor::ScheduleUpdate() {
+  if (update_pending_.exchange(true)) {
+    return;
+  }
+  thread_->PostDelayedTask(SafeTask(safety_flag_,
+                                    [this] {
+                                      update_pending_ = false;
+                                      InvokeNetworksChangedCallback();
+                                    }),
+                           kUpdateDelay);
+}
+
+NetworkMonitorInterface* NetlinkNetworkMonitorFactory::CreateNetworkMonitor(
+    const webrtc::FieldTrialsView& field_trials) {
+  return new NetlinkNetworkMonitor();
+}
+
+}  // namespace rtc
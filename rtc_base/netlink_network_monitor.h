@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETLINK_NETWORK_MONITOR_H_
+#define RTC_BASE_NETLINK_NETWORK_MONITOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+#include "api/field_trials_view.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "rtc_base/network_monitor.h"
+#include "rtc_base/network_monitor_factory.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+// Listens on the Linux routing netlink socket for interfaces going up or down
+// and for addresses being added or removed. A BasicNetworkManager using this
+// monitor re-enumerates the networks only when one of these happen, instead of
+// polling for changes, and then only signals the networks that changed.
+//
+// Start() and Stop() must be called on the same thread, which is also where
+// the networks changed callback is invoked. The socket is read on a separate
+// thread.
+class RTC_EXPORT NetlinkNetworkMonitor : public NetworkMonitorInterface {
+ public:
+  NetlinkNetworkMonitor();
+  ~NetlinkNetworkMonitor() override;
+
+  void Start() override;
+  void Stop() override;
+
+  InterfaceInfo GetInterfaceInfo(absl::string_view interface_name) override;
+
+  // True once started, if the netlink socket could be opened.
+  bool SupportsAddressChangeNotifications() const override;
+
+  // Returns true if the routing messages in `buffer` may have changed the
+  // networks. Called on the thread reading the socket; public for testing.
+  bool HandleMessages(rtc::ArrayView<const uint8_t> buffer);
+
+ private:
+  void ReadMessages(int netlink_fd, int wakeup_fd);
+  void ScheduleUpdate();
+
+  Thread* thread_ = nullptr;
+  int netlink_fd_ = -1;
+  int wakeup_fd_ = -1;
+  PlatformThread reader_thread_;
+  // The IFF_UP and IFF_RUNNING flags last seen for each interface index. Only
+  // accessed by the thread reading the socket.
+  std::map<int, unsigned int> link_flags_;
+  // Set while an update is posted, so that bursts of messages, such as from
+  // containers coming and going, result in a single update.
+  std::atomic<bool> update_pending_{false};
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag_;
+};
+
+class RTC_EXPORT NetlinkNetworkMonitorFactory : public NetworkMonitorFactory {
+ public:
+  NetworkMonitorInterface* CreateNetworkMonitor(
+      const webrtc::FieldTrialsView& field_trials) override;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETLINK_NETWORK_MONITOR_H_
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/netlink_network_monitor.h"
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <string.h>
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// Appends a routing message for interface `index` to `buffer`.
+void AppendMessage(std::vector<uint8_t>& buffer,
+                   uint16_t type,
+                   int index,
+                   unsigned int flags = 0) {
+  struct nlmsghdr header;
+  memset(&header, 0, sizeof(header));
+  header.nlmsg_type = type;
+  header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+  struct ifinfomsg info;
+  memset(&info, 0, sizeof(info));
+  info.ifi_index = index;
+  info.ifi_flags = flags;
+
+  size_t offset = buffer.size();
+  buffer.resize(offset + NLMSG_SPACE(sizeof(info)));
+  memcpy(buffer.data() + offset, &header, sizeof(header));
+  memcpy(buffer.data() + offset + NLMSG_HDRLEN, &info, sizeof(info));
+}
+
+TEST(NetlinkNetworkMonitorTest, AddressChangesChangeNetworks) {
+  NetlinkNetworkMonitor monitor;
+  std::vector<uint8_t> buffer;
+  AppendMessage(buffer, RTM_NEWADDR, 2);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+
+  buffer.clear();
+  AppendMessage(buffer, RTM_DELADDR, 2);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+}
+
+TEST(NetlinkNetworkMonitorTest, OnlyUpAndRunningLinkChangesChangeNetworks) {
+  NetlinkNetworkMonitor monitor;
+  std::vector<uint8_t> buffer;
+  AppendMessage(buffer, RTM_NEWLINK, 2, IFF_UP | IFF_RUNNING);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+
+  // E.g. an MTU change.
+  buffer.clear();
+  AppendMessage(buffer, RTM_NEWLINK, 2, IFF_UP | IFF_RUNNING | IFF_PROMISC);
+  EXPECT_FALSE(monitor.HandleMessages(buffer));
+
+  buffer.clear();
+  AppendMessage(buffer, RTM_NEWLINK, 2, IFF_UP);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+
+  buffer.clear();
+  AppendMessage(buffer, RTM_DELLINK, 2);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+  // The interface is already gone.
+  EXPECT_FALSE(monitor.HandleMessages(buffer));
+}
+
+TEST(NetlinkNetworkMonitorTest, HandlesSeveralMessagesInOneRead) {
+  NetlinkNetworkMonitor monitor;
+  std::vector<uint8_t> buffer;
+  AppendMessage(buffer, RTM_NEWLINK, 2, IFF_UP);
+  AppendMessage(buffer, RTM_NEWLINK, 3, IFF_UP);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+
+  buffer.clear();
+  AppendMessage(buffer, RTM_NEWLINK, 2, IFF_UP);
+  AppendMessage(buffer, RTM_NEWADDR, 3);
+  EXPECT_TRUE(monitor.HandleMessages(buffer));
+}
+
+TEST(NetlinkNetworkMonitorTest, IgnoresMalformedMessages) {
+  NetlinkNetworkMonitor monitor;
+  std::vector<uint8_t> buffer;
+  AppendMessage(buffer, RTM_NEWADDR, 2);
+  // Truncated message.
+  EXPECT_FALSE(monitor.HandleMessages(
+      rtc::ArrayView<const uint8_t>(buffer.data(), buffer.size() - 1)));
+  // Header without the interface info.
+  struct nlmsghdr header;
+  memcpy(&header, buffer.data(), sizeof(header));
+  header.nlmsg_type = RTM_NEWLINK;
+  header.nlmsg_len = NLMSG_HDRLEN;
+  memcpy(buffer.data(), &header, sizeof(header));
+  EXPECT_FALSE(monitor.HandleMessages(buffer));
+  EXPECT_FALSE(monitor.HandleMessages({}));
+}
+
+}  // namespace
+}  // namespace rtc
@@ -296,6 +296,11 @@ NetworkManager::EnumerationPermission NetworkManager::enumeration_permission()
   return ENUMERATION_ALLOWED;
 }
 
+absl::optional<std::vector<const Network*>>
+NetworkManager::GetChangedNetworks() const {
+  return absl::nullopt;
+}
+
 bool NetworkManager::GetDefaultLocalAddress(int family, IPAddress* addr) const {
   return false;
 }
@@ -358,6 +363,18 @@ std::vector<const Network*> NetworkManagerBase::GetNetworks() const {
   return result;
 }
 
+absl::optional<std::vector<const Network*>>
+NetworkManagerBase::GetChangedNetworks() const {
+  return changed_networks_;
+}
+
+void NetworkManagerBase::SignalNetworksChangedIncrementally(
+    std::vector<const Network*> changed_networks) {
+  changed_networks_ = std::move(changed_networks);
+  SignalNetworksChanged();
+  changed_networks_.reset();
+}
+
 void NetworkManagerBase::MergeNetworkList(
     std::vector<std::unique_ptr<Network>> new_networks,
     bool* changed) {
@@ -370,6 +387,7 @@ void NetworkManagerBase::MergeNetworkList(
     bool* changed,
     NetworkManager::Stats* stats) {
   *changed = false;
+  merged_changed_networks_.clear();
   // AddressList in this map will track IP addresses for all Networks
   // with the same key.
   std::map<std::string, AddressList> consolidated_address_list;
@@ -416,31 +434,36 @@ void NetworkManagerBase::MergeNetworkList(
       net->SetIPs(kv.second.ips, true);
       // Place it in the network map.
       merged_list.push_back(net.get());
+      merged_changed_networks_.push_back(net.get());
       networks_map_[key] = std::move(net);
       *changed = true;
     } else {
       // This network exists in the map already. Reset its IP addresses.
       Network* existing_net = existing->second.get();
-      *changed = existing_net->SetIPs(kv.second.ips, *changed);
+      bool network_changed = existing_net->SetIPs(kv.second.ips, false);
       merged_list.push_back(existing_net);
       if (net->type() != ADAPTER_TYPE_UNKNOWN &&
           net->type() != existing_net->type()) {
         if (ShouldAdapterChangeTriggerNetworkChange(existing_net->type(),
                                                     net->type())) {
-          *changed = true;
+          network_changed = true;
         }
         existing_net->set_type(net->type());
       }
       // If the existing network was not active, networks have changed.
       if (!existing_net->active()) {
-        *changed = true;
+        network_changed = true;
       }
       if (net->network_preference() != existing_net->network_preference()) {
         existing_net->set_network_preference(net->network_preference());
         if (signal_network_preference_change_) {
-          *changed = true;
+          network_changed = true;
         }
       }
+      if (network_changed) {
+        merged_changed_networks_.push_back(existing_net);
+        *changed = true;
+      }
       RTC_DCHECK(net->active());
     }
     networks_map_[key]->set_mdns_responder_provider(this);
@@ -941,10 +964,12 @@ void BasicNetworkManager::StartUpdating() {
     // If network interfaces are already discovered and signal is sent,
     // we should trigger network signal immediately for the new clients
     // to start allocating ports.
+    // Nothing has changed for the clients that have already seen the
+    // networks.
     if (sent_first_update_)
       thread_->PostTask(SafeTask(task_safety_flag_, [this] {
         RTC_DCHECK_RUN_ON(thread_);
-        SignalNetworksChanged();
+        SignalNetworksChangedIncrementally({});
       }));
   } else {
     RTC_DCHECK(task_safety_flag_ == nullptr);
@@ -1048,15 +1073,22 @@ void BasicNetworkManager::UpdateNetworksOnce() {
     MergeNetworkList(std::move(list), &changed, &stats);
     set_default_local_addresses(QueryDefaultLocalAddress(AF_INET),
                                 QueryDefaultLocalAddress(AF_INET6));
-    if (changed || !sent_first_update_) {
+    if (!sent_first_update_) {
       SignalNetworksChanged();
       sent_first_update_ = true;
+    } else if (changed) {
+      SignalNetworksChangedIncrementally(merged_changed_networks());
     }
   }
 }
 
 void BasicNetworkManager::UpdateNetworksContinually() {
   UpdateNetworksOnce();
+  if (network_monitor_ &&
+      network_monitor_->SupportsAddressChangeNotifications()) {
+    // The monitor triggers an update whenever something changes.
+    return;
+  }
   thread_->PostDelayedTask(SafeTask(task_safety_flag_,
                                     [this] {
                                       RTC_DCHECK_RUN_ON(thread_);
@@ -21,6 +21,7 @@
 
 #include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/sequence_checker.h"
@@ -157,6 +158,14 @@ class RTC_EXPORT NetworkManager : public DefaultLocalAddressProvider,
   // alive.
   virtual std::vector<const Network*> GetNetworks() const = 0;
 
+  // While SignalNetworksChanged is being emitted, returns the networks that
+  // the update added or modified. A listener that has already seen the
+  // previous list of networks only has to look at these; networks that went
+  // away are no longer returned by GetNetworks(). Returns nullopt if the
+  // changes aren't known, in which case any of the networks may have changed.
+  virtual absl::optional<std::vector<const Network*>> GetChangedNetworks()
+      const;
+
   // Returns the current permission state of GetNetworks().
   virtual EnumerationPermission enumeration_permission() const;
 
@@ -194,6 +203,8 @@ class RTC_EXPORT NetworkManagerBase : public NetworkManager {
   NetworkManagerBase(const webrtc::FieldTrialsView* field_trials = nullptr);
 
   std::vector<const Network*> GetNetworks() const override;
+  absl::optional<std::vector<const Network*>> GetChangedNetworks()
+      const override;
   std::vector<const Network*> GetAnyAddressNetworks() override;
 
   EnumerationPermission enumeration_permission() const override;
@@ -218,6 +229,16 @@ class RTC_EXPORT NetworkManagerBase : public NetworkManager {
                         bool* changed,
                         NetworkManager::Stats* stats);
 
+  // The networks that the last MergeNetworkList() call added or modified.
+  const std::vector<const Network*>& merged_changed_networks() const {
+    return merged_changed_networks_;
+  }
+
+  // Emits SignalNetworksChanged, with GetChangedNetworks() returning
+  // `changed_networks` until it returns.
+  void SignalNetworksChangedIncrementally(
+      std::vector<const Network*> changed_networks);
+
   void set_enumeration_permission(EnumerationPermission state) {
     enumeration_permission_ = state;
   }
@@ -252,6 +273,10 @@ class RTC_EXPORT NetworkManagerBase : public NetworkManager {
 
   std::map<std::string, std::unique_ptr<Network>> networks_map_;
 
+  std::vector<const Network*> merged_changed_networks_;
+  // Only set while SignalNetworksChangedIncrementally() is emitting.
+  absl::optional<std::vector<const Network*>> changed_networks_;
+
   std::unique_ptr<rtc::Network> ipv4_any_address_network_;
   std::unique_ptr<rtc::Network> ipv6_any_address_network_;
 
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/network/received_packet_batch.h"
+
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/checks.h"
+#if !defined(ABSL_HAVE_THREAD_LOCAL) && defined(WEBRTC_POSIX)
+#include <pthread.h>
+#endif
+
+namespace rtc {
+namespace {
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+ABSL_CONST_INIT thread_local ScopedReceivedPacketBatch* current_batch = nullptr;
+
+ScopedReceivedPacketBatch* GetCurrentBatch() {
+  return current_batch;
+}
+
+void SetCurrentBatch(ScopedReceivedPacketBatch* batch) {
+  current_batch = batch;
+}
+
+#elif defined(WEBRTC_POSIX)
+
+// Emscripten does not support the C++11 thread_local keyword but does support
+// the pthread thread-local storage API.
+// https://github.com/emscripten-core/emscripten/issues/3502
+
+ABSL_CONST_INIT pthread_key_t g_current_batch_tls = 0;
+
+void InitializeTls() {
+  RTC_CHECK_EQ(pthread_key_create(&g_current_batch_tls, nullptr), 0);
+}
+
+pthread_key_t GetCurrentBatchTls() {
+  static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+  RTC_CHECK_EQ(pthread_once(&init_once, &InitializeTls), 0);
+  return g_current_batch_tls;
+}
+
+ScopedReceivedPacketBatch* GetCurrentBatch() {
+  return static_cast<ScopedReceivedPacketBatch*>(
+      pthread_getspecific(GetCurrentBatchTls()));
+}
+
+void SetCurrentBatch(ScopedReceivedPacketBatch* batch) {
+  pthread_setspecific(GetCurrentBatchTls(), batch);
+}
+
+#else
+#error Unsupported platform
+#endif
+
+}  // namespace
+
+ScopedReceivedPacketBatch::ScopedReceivedPacketBatch()
+    : previous_(GetCurrentBatch()) {
+  SetCurrentBatch(this);
+}
+
+ScopedReceivedPacketBatch::~ScopedReceivedPacketBatch() {
+  RTC_DCHECK_EQ(GetCurrentBatch(), this);
+  SetCurrentBatch(previous_);
+  // Callbacks may receive packets of their own, which then belong to the
+  // enclosing batch, if any.
+  for (absl::AnyInvocable<void() &&>& callback : callbacks_) {
+    std::move(callback)();
+  }
+}
+
+bool ScopedReceivedPacketBatch::OnBatchEnd(
+    absl::AnyInvocable<void() &&> callback) {
+  ScopedReceivedPacketBatch* batch = GetCurrentBatch();
+  if (batch == nullptr) {
+    return false;
+  }
+  batch->callbacks_.push_back(std::move(callback));
+  return true;
+}
+
+}  // namespace rtc
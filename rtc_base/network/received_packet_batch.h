@@ -0,0 +1,46 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_RECEIVED_PACKET_BATCH_H_
+#define RTC_BASE_NETWORK_RECEIVED_PACKET_BATCH_H_
+
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+
+namespace rtc {
+
+// Marks the packets that a socket reads in one loop, e.g. the datagrams that
+// were already queued on it when it became readable, as one batch on the
+// current thread. While a batch is open, receivers may defer handling the
+// packets they are given until it ends, and then handle them together.
+// Packets received outside of a batch should be handled right away.
+class ScopedReceivedPacketBatch final {
+ public:
+  ScopedReceivedPacketBatch();
+  ScopedReceivedPacketBatch(const ScopedReceivedPacketBatch&) = delete;
+  ScopedReceivedPacketBatch& operator=(const ScopedReceivedPacketBatch&) =
+      delete;
+  // Runs the callbacks added with OnBatchEnd(), in the order they were added.
+  ~ScopedReceivedPacketBatch();
+
+  // Runs `callback` when the innermost batch open on the current thread ends,
+  // and returns true. Returns false, without running `callback`, if no batch
+  // is open.
+  static bool OnBatchEnd(absl::AnyInvocable<void() &&> callback);
+
+ private:
+  ScopedReceivedPacketBatch* const previous_;
+  std::vector<absl::AnyInvocable<void() &&>> callbacks_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_RECEIVED_PACKET_BATCH_H_
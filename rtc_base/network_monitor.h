@@ -106,6 +106,11 @@ class NetworkMonitorInterface {
   // `adapter_type` to ADAPTER_TYPE_UNKNOWN and `available` to false.
   virtual InterfaceInfo GetInterfaceInfo(absl::string_view interface_name) = 0;
 
+  // Returns true if the monitor fires the networks changed callback whenever
+  // an interface or address is added or removed, so that the networks don't
+  // need to be polled for changes.
+  virtual bool SupportsAddressChangeNotifications() const { return false; }
+
   // Does `this` NetworkMonitorInterface implement BindSocketToNetwork?
   // Only Android returns true.
   virtual bool SupportsBindSocketToNetwork() const { return false; }
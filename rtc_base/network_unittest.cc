@@ -39,6 +39,8 @@
 #include "test/scoped_key_value_config.h"
 
 using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
 using ::testing::Not;
 using ::testing::UnorderedElementsAre;
 using ::testing::UnorderedElementsAreArray;
@@ -158,6 +160,11 @@ class NetworkTest : public ::testing::Test, public sigslot::has_slots<> {
     return stats;
   }
 
+  std::vector<const Network*> MergedChangedNetworks(
+      BasicNetworkManager& network_manager) {
+    return network_manager.merged_changed_networks();
+  }
+
   bool IsIgnoredNetwork(BasicNetworkManager& network_manager,
                         const Network& network) {
     RTC_DCHECK_RUN_ON(network_manager.thread_);
@@ -522,6 +529,57 @@ TEST_F(NetworkTest, TestBasicMergeNetworkList) {
               (net_id1 == current[1]->id() && net_id2 == current[0]->id()));
 }
 
+// Test that merging reports which of the networks are new or changed.
+TEST_F(NetworkTest, TestMergeNetworkListReportsChangedNetworks) {
+  Network ipv4_network1("test_eth0", "Test Network Adapter 1",
+                        IPAddress(0x12345600U), 24);
+  Network ipv4_network2("test_eth1", "Test Network Adapter 2",
+                        IPAddress(0x00010000U), 16);
+  ipv4_network1.AddIP(IPAddress(0x12345678));
+  ipv4_network2.AddIP(IPAddress(0x00010004));
+  PhysicalSocketServer socket_server;
+  BasicNetworkManager manager(&socket_server);
+
+  std::vector<std::unique_ptr<Network>> list;
+  list.push_back(std::make_unique<Network>(ipv4_network1));
+  bool changed;
+  MergeNetworkList(manager, std::move(list), &changed);
+  EXPECT_TRUE(changed);
+  std::vector<const Network*> current = manager.GetNetworks();
+  ASSERT_EQ(1U, current.size());
+  const Network* net1 = current[0];
+  EXPECT_THAT(MergedChangedNetworks(manager), ElementsAre(net1));
+
+  // Adding a network only reports the new one.
+  list.clear();
+  list.push_back(std::make_unique<Network>(ipv4_network1));
+  list.push_back(std::make_unique<Network>(ipv4_network2));
+  MergeNetworkList(manager, std::move(list), &changed);
+  EXPECT_TRUE(changed);
+  current = manager.GetNetworks();
+  ASSERT_EQ(2U, current.size());
+  const Network* net2 = current[0] == net1 ? current[1] : current[0];
+  EXPECT_THAT(MergedChangedNetworks(manager), ElementsAre(net2));
+
+  // A new address on an existing network reports that network.
+  list.clear();
+  list.push_back(std::make_unique<Network>(ipv4_network1));
+  list.push_back(std::make_unique<Network>(ipv4_network2));
+  list[1]->AddIP(IPAddress(0x00010005));
+  MergeNetworkList(manager, std::move(list), &changed);
+  EXPECT_TRUE(changed);
+  EXPECT_THAT(MergedChangedNetworks(manager), ElementsAre(net2));
+
+  // Nothing changed.
+  list.clear();
+  list.push_back(std::make_unique<Network>(ipv4_network1));
+  list.push_back(std::make_unique<Network>(ipv4_network2));
+  list[1]->AddIP(IPAddress(0x00010005));
+  MergeNetworkList(manager, std::move(list), &changed);
+  EXPECT_FALSE(changed);
+  EXPECT_THAT(MergedChangedNetworks(manager), IsEmpty());
+}
+
 // Sets up some test IPv6 networks and appends them to list.
 // Four networks are added - public and link local, for two interfaces.
 void SetupNetworks(std::vector<std::unique_ptr<Network>>* list) {
@@ -13,12 +13,12 @@
 
 #include <stdint.h>
 
-#include <deque>
 #include <limits>
 #include <utility>
 
 #include "absl/types/optional.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/ring_deque.h"
 
 namespace rtc {
 
@@ -56,7 +56,7 @@ class MovingMaxCounter {
   // and if an older pair has a sample that's smaller than that of a younger
   // pair, the older pair is discarded. As a result, the sequence of timestamps
   // is strictly increasing, and the sequence of samples is strictly decreasing.
-  std::deque<std::pair<int64_t, T>> samples_;
+  webrtc::RingDeque<std::pair<int64_t, T>> samples_;
 #if RTC_DCHECK_IS_ON
   int64_t last_call_time_ms_ = std::numeric_limits<int64_t>::min();
 #endif
@@ -80,7 +80,7 @@ void MovingMaxCounter<T>::Add(const T& sample, int64_t current_time_ms) {
   // Due to checks above, the already existing element will be larger, so the
   // new sample will never be the maximum in any window.
   if (samples_.empty() || samples_.back().first < current_time_ms) {
-    samples_.emplace_back(std::make_pair(current_time_ms, sample));
+    samples_.push_back(std::make_pair(current_time_ms, sample));
   }
 }
 
@@ -106,11 +106,9 @@ void MovingMaxCounter<T>::RollWindow(int64_t new_time_ms) {
   last_call_time_ms_ = new_time_ms;
 #endif
   const int64_t window_begin_ms = new_time_ms - window_length_ms_;
-  auto it = samples_.begin();
-  while (it != samples_.end() && it->first < window_begin_ms) {
-    ++it;
+  while (!samples_.empty() && samples_.front().first < window_begin_ms) {
+    samples_.pop_front();
   }
-  samples_.erase(samples_.begin(), it);
 }
 
 }  // namespace rtc
@@ -14,9 +14,9 @@
 #include <stddef.h>
 
 #include <cstddef>
-#include <list>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/ring_deque.h"
 #include "rtc_base/numerics/percentile_filter.h"
 
 namespace webrtc {
@@ -48,7 +48,7 @@ class MovingPercentileFilter {
 
  private:
   PercentileFilter<T> percentile_filter_;
-  std::list<T> samples_;
+  RingDeque<T> samples_;
   size_t samples_stored_;
   const size_t window_size_;
 };
@@ -73,7 +73,7 @@ MovingPercentileFilter<T>::MovingPercentileFilter(float percentile,
 template <typename T>
 void MovingPercentileFilter<T>::Insert(const T& value) {
   percentile_filter_.Insert(value);
-  samples_.emplace_back(value);
+  samples_.push_back(value);
   ++samples_stored_;
   if (samples_stored_ > window_size_) {
     percentile_filter_.Erase(samples_.front());
@@ -13,8 +13,8 @@
 
 #include <stdint.h>
 
-#include <iterator>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "rtc_base/checks.h"
 
@@ -23,19 +23,26 @@ namespace webrtc {
 // Class to efficiently get the percentile value from a group of observations.
 // The percentile is the value below which a given percentage of the
 // observations fall.
+//
+// The observations are kept in a sorted vector. For the window sizes used in
+// practice, up to about a thousand observations, moving the elements on insert
+// and erase is cheaper than the node allocations and pointer chasing of a
+// tree, and the filter stops allocating once the vector has grown to fit the
+// window.
 template <typename T>
 class PercentileFilter {
  public:
   // Construct filter. `percentile` should be between 0 and 1.
   explicit PercentileFilter(float percentile);
 
-  // Insert one observation. The complexity of this operation is logarithmic in
-  // the size of the container.
+  // Insert one observation. The complexity of this operation is linear in the
+  // size of the container, but it doesn't allocate once the container has
+  // reached its largest size.
   void Insert(const T& value);
 
   // Remove one observation or return false if `value` doesn't exist in the
-  // container. The complexity of this operation is logarithmic in the size of
-  // the container.
+  // container. The complexity of this operation is linear in the size of the
+  // container.
   bool Erase(const T& value);
 
   // Get the percentile value. The complexity of this operation is constant.
@@ -45,79 +52,44 @@ class PercentileFilter {
   void Reset();
 
  private:
-  // Update iterator and index to point at target percentile value.
-  void UpdatePercentileIterator();
-
   const float percentile_;
-  std::multiset<T> set_;
-  // Maintain iterator and index of current target percentile value.
-  typename std::multiset<T>::iterator percentile_it_;
-  int64_t percentile_index_;
+  // All observations, in increasing order.
+  std::vector<T> values_;
 };
 
 template <typename T>
 PercentileFilter<T>::PercentileFilter(float percentile)
-    : percentile_(percentile),
-      percentile_it_(set_.begin()),
-      percentile_index_(0) {
+    : percentile_(percentile) {
   RTC_CHECK_GE(percentile, 0.0f);
   RTC_CHECK_LE(percentile, 1.0f);
 }
 
 template <typename T>
 void PercentileFilter<T>::Insert(const T& value) {
-  // Insert element at the upper bound.
-  set_.insert(value);
-  if (set_.size() == 1u) {
-    // First element inserted - initialize percentile iterator and index.
-    percentile_it_ = set_.begin();
-    percentile_index_ = 0;
-  } else if (value < *percentile_it_) {
-    // If new element is before us, increment `percentile_index_`.
-    ++percentile_index_;
-  }
-  UpdatePercentileIterator();
+  values_.insert(std::upper_bound(values_.begin(), values_.end(), value),
+                 value);
 }
 
 template <typename T>
 bool PercentileFilter<T>::Erase(const T& value) {
-  typename std::multiset<T>::const_iterator it = set_.lower_bound(value);
-  // Ignore erase operation if the element is not present in the current set.
-  if (it == set_.end() || *it != value)
+  auto it = std::lower_bound(values_.begin(), values_.end(), value);
+  if (it == values_.end() || *it != value)
     return false;
-  if (it == percentile_it_) {
-    // If same iterator, update to the following element. Index is not
-    // affected.
-    percentile_it_ = set_.erase(it);
-  } else {
-    set_.erase(it);
-    // If erased element was before us, decrement `percentile_index_`.
-    if (value <= *percentile_it_)
-      --percentile_index_;
-  }
-  UpdatePercentileIterator();
+  values_.erase(it);
   return true;
 }
 
-template <typename T>
-void PercentileFilter<T>::UpdatePercentileIterator() {
-  if (set_.empty())
-    return;
-  const int64_t index = static_cast<int64_t>(percentile_ * (set_.size() - 1));
-  std::advance(percentile_it_, index - percentile_index_);
-  percentile_index_ = index;
-}
-
 template <typename T>
 T PercentileFilter<T>::GetPercentileValue() const {
-  return set_.empty() ? 0 : *percentile_it_;
+  if (values_.empty())
+    return 0;
+  const size_t index = static_cast<size_t>(percentile_ * (values_.size() - 1));
+  return values_[index];
 }
 
 template <typename T>
 void PercentileFilter<T>::Reset() {
-  set_.clear();
-  percentile_it_ = set_.begin();
-  percentile_index_ = 0;
+  values_.clear();
 }
 }  // namespace webrtc
 
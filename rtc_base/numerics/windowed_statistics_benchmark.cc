@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/numerics/moving_max_counter.h"
+#include "rtc_base/numerics/moving_percentile_filter.h"
+#include "rtc_base/rate_statistics.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// An audio stream sends a packet every 20 ms, a video stream every few ms.
+constexpr int64_t kPacketIntervalMs = 3;
+constexpr int64_t kPacketSizeBytes = 1200;
+
+}  // namespace
+
+// The per packet upkeep of a bitrate estimate over a one second window.
+void BM_RateStatisticsUpdate(benchmark::State& state) {
+  RateStatistics rate(/*max_window_size_ms=*/1000, RateStatistics::kBpsScale);
+  int64_t now_ms = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    now_ms += kPacketIntervalMs;
+    rate.Update(kPacketSizeBytes, now_ms);
+    benchmark::DoNotOptimize(rate.Rate(now_ms));
+  }
+}
+
+// Like the frame size filters of the jitter estimator.
+void BM_MovingMedianFilterInsert(benchmark::State& state) {
+  MovingMedianFilter<int64_t> filter(state.range(0));
+  int64_t value = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    // A pseudo random walk, so that values land all over the window.
+    value = (value * 1103515245 + 12345) % 100000;
+    filter.Insert(value);
+    benchmark::DoNotOptimize(filter.GetFilteredValue());
+  }
+}
+
+// Like the inter frame delay maximum of the receive statistics.
+void BM_MovingMaxCounterAdd(benchmark::State& state) {
+  rtc::MovingMaxCounter<int> counter(/*window_length_ms=*/10000);
+  int64_t now_ms = 0;
+  uint32_t value = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    now_ms += kPacketIntervalMs;
+    value = (value * 1103515245 + 12345) & 0xffff;
+    counter.Add(static_cast<int>(value), now_ms);
+    benchmark::DoNotOptimize(counter.Max(now_ms));
+  }
+}
+
+BENCHMARK(BM_RateStatisticsUpdate);
+BENCHMARK(BM_MovingMedianFilterInsert)->Arg(30)->Arg(300)->Arg(1000)->Arg(3000);
+BENCHMARK(BM_MovingMaxCounterAdd);
+
+}  // namespace webrtc
+
+/*
+
+Results (Linux, glibc malloc), before and after replacing std::deque,
+std::list and std::multiset with RingDeque and a sorted vector:
+
+Benchmark                              Before        After
+----------------------------------------------------------
+BM_RateStatisticsUpdate               20.0 ns      19.0 ns
+BM_MovingMedianFilterInsert/30        98.0 ns      27.2 ns
+BM_MovingMedianFilterInsert/300        120 ns      52.5 ns
+BM_MovingMedianFilterInsert/1000       160 ns       129 ns
+BM_MovingMedianFilterInsert/3000       239 ns       266 ns
+BM_MovingMaxCounterAdd                34.0 ns      25.4 ns
+
+In steady state, none of them allocates anymore, where they used to allocate
+about twice per update between them.
+
+*/
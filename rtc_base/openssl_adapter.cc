@@ -46,6 +46,15 @@
 #include "rtc_base/openssl_utility.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/zero_memory.h"
+
+#if defined(OPENSSL_IS_BORINGSSL) && defined(WEBRTC_LINUX) && \
+    !defined(WEBRTC_ANDROID)
+#include <linux/tls.h>
+
+#include "rtc_base/byte_order.h"
+#define WEBRTC_USE_KERNEL_TLS
+#endif
 
 //////////////////////////////////////////////////////////////////////
 // SocketBIO
@@ -271,6 +280,11 @@ void OpenSSLAdapter::SetRole(SSLRole role) {
   role_ = role;
 }
 
+void OpenSSLAdapter::SetKernelTlsOffload(bool enable) {
+  RTC_DCHECK(state_ == SSL_NONE);
+  kernel_tls_offload_ = enable;
+}
+
 int OpenSSLAdapter::StartSSL(absl::string_view hostname) {
   if (state_ != SSL_NONE)
     return -1;
@@ -408,6 +422,7 @@ int OpenSSLAdapter::ContinueSSL() {
       }
 
       state_ = SSL_CONNECTED;
+      MaybeEnableKernelTlsTx();
       AsyncSocketAdapter::OnConnectEvent(this);
       // TODO(benwright): Refactor this code path.
       // Don't let ourselves go away during the callbacks
@@ -458,6 +473,7 @@ void OpenSSLAdapter::Cleanup() {
   ssl_read_needs_write_ = false;
   ssl_write_needs_read_ = false;
   custom_cert_verifier_status_ = false;
+  kernel_tls_tx_ = false;
   pending_data_.Clear();
 
   if (ssl_) {
@@ -532,6 +548,11 @@ int OpenSSLAdapter::Send(const void* pv, size_t cb) {
       return SOCKET_ERROR;
   }
 
+  if (kernel_tls_tx_) {
+    // The kernel frames and encrypts the data.
+    return AsyncSocketAdapter::Send(pv, cb);
+  }
+
   int ret;
   int error;
 
@@ -639,6 +660,12 @@ int OpenSSLAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
       Error("SSL_read", (code ? code : -1), false);
       break;
   }
+  if (kernel_tls_tx_ && state_ == SSL_ERROR) {
+    // The alert for the error could not be sent, see MaybeEnableKernelTlsTx().
+    // Close the connection instead, so that the peer does not wait for it.
+    RTC_LOG(LS_WARNING) << "Closing kernel TLS connection after read error.";
+    AsyncSocketAdapter::Close();
+  }
   return SOCKET_ERROR;
 }
 
@@ -671,10 +698,117 @@ Socket::ConnState OpenSSLAdapter::GetState() const {
   return state;
 }
 
+int OpenSSLAdapter::EnableKernelTlsTx(const void* crypto_info, size_t size) {
+  return -1;
+}
+
 bool OpenSSLAdapter::IsResumedSession() {
   return (ssl_ && SSL_session_reused(ssl_) == 1);
 }
 
+#if defined(WEBRTC_USE_KERNEL_TLS)
+namespace {
+
+template <typename CryptoInfo>
+bool EnableKernelTlsTxWithKey(Socket* socket,
+                              uint16_t cipher_type,
+                              const uint8_t* key,
+                              const uint8_t* salt,
+                              uint64_t sequence_number) {
+  CryptoInfo crypto_info = {};
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  memcpy(crypto_info.key, key, sizeof(crypto_info.key));
+  memcpy(crypto_info.salt, salt, sizeof(crypto_info.salt));
+  // The explicit part of the nonce is the record sequence number.
+  SetBE64(crypto_info.rec_seq, sequence_number);
+  SetBE64(crypto_info.iv, sequence_number);
+  bool enabled =
+      socket->EnableKernelTlsTx(&crypto_info, sizeof(crypto_info)) == 0;
+  ExplicitZeroMemory(&crypto_info, sizeof(crypto_info));
+  return enabled;
+}
+
+// Writes fail without asking to be retried. Once the kernel encrypts the
+// outgoing records, the SSL object keeps write keys and a sequence number that
+// the kernel has already used, so any record it wrote would reuse a nonce.
+int refuse_write(BIO* b, const char* in, int inl) {
+  BIO_clear_retry_flags(b);
+  return -1;
+}
+
+BIO* BIO_new_refusing_write() {
+  static BIO_METHOD* methods = [] {
+    BIO_METHOD* methods = BIO_meth_new(BIO_TYPE_BIO, "refusing write");
+    BIO_meth_set_write(methods, refuse_write);
+    BIO_meth_set_ctrl(methods, socket_ctrl);
+    BIO_meth_set_create(methods, socket_new);
+    BIO_meth_set_destroy(methods, socket_free);
+    return methods;
+  }();
+  return BIO_new(methods);
+}
+
+}  // namespace
+#endif  // WEBRTC_USE_KERNEL_TLS
+
+void OpenSSLAdapter::MaybeEnableKernelTlsTx() {
+#if defined(WEBRTC_USE_KERNEL_TLS)
+  if (!kernel_tls_offload_ || ssl_mode_ != SSL_MODE_TLS) {
+    return;
+  }
+  // Only the TLS 1.2 record keys can be exported, and the kernel supports
+  // AES-GCM for them.
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+  if (SSL_version(ssl_) != TLS1_2_VERSION || cipher == nullptr) {
+    return;
+  }
+  size_t key_size;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      break;
+    case NID_aes_256_gcm:
+      key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      break;
+    default:
+      return;
+  }
+
+  // With AEAD ciphers the key block holds no MAC keys, only the client and
+  // server write keys followed by the client and server implicit nonces.
+  constexpr size_t kSaltSize = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+  uint8_t key_block[2 * (TLS_CIPHER_AES_GCM_256_KEY_SIZE + kSaltSize)];
+  const size_t key_block_size = 2 * (key_size + kSaltSize);
+  if (SSL_get_key_block_len(ssl_) != key_block_size ||
+      !SSL_generate_key_block(ssl_, key_block, key_block_size)) {
+    return;
+  }
+  const bool is_client = role_ == SSL_CLIENT;
+  const uint8_t* key = key_block + (is_client ? 0 : key_size);
+  const uint8_t* salt = key_block + 2 * key_size + (is_client ? 0 : kSaltSize);
+  const uint64_t sequence_number = SSL_get_write_sequence(ssl_);
+  if (key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+    kernel_tls_tx_ = EnableKernelTlsTxWithKey<tls12_crypto_info_aes_gcm_128>(
+        GetSocket(), TLS_CIPHER_AES_GCM_128, key, salt, sequence_number);
+  } else {
+    kernel_tls_tx_ = EnableKernelTlsTxWithKey<tls12_crypto_info_aes_gcm_256>(
+        GetSocket(), TLS_CIPHER_AES_GCM_256, key, salt, sequence_number);
+  }
+  ExplicitZeroMemory(key_block, sizeof(key_block));
+  if (kernel_tls_tx_) {
+    // BoringSSL must not write anything from now on, see refuse_write(). It
+    // still writes alerts when reading fails, and those fail instead, after
+    // which Recv() closes the socket. No close_notify is sent on shutdown.
+    SSL_set_quiet_shutdown(ssl_, 1);
+    SSL_set0_wbio(ssl_, BIO_new_refusing_write());
+  }
+  RTC_LOG(LS_INFO) << "Kernel TLS "
+                   << (kernel_tls_tx_ ? "enabled" : "not available")
+                   << " for outgoing records.";
+#endif  // WEBRTC_USE_KERNEL_TLS
+}
+
 void OpenSSLAdapter::OnTimeout() {
   RTC_LOG(LS_INFO) << "DTLS timeout expired";
   DTLSv1_handle_timeout(ssl_);
@@ -68,6 +68,7 @@ class OpenSSLAdapter final : public SSLAdapter {
   void SetCertVerifier(SSLCertificateVerifier* ssl_cert_verifier) override;
   void SetIdentity(std::unique_ptr<SSLIdentity> identity) override;
   void SetRole(SSLRole role) override;
+  void SetKernelTlsOffload(bool enable) override;
   int StartSSL(absl::string_view hostname) override;
   int Send(const void* pv, size_t cb) override;
   int SendTo(const void* pv, size_t cb, const SocketAddress& addr) override;
@@ -77,6 +78,9 @@ class OpenSSLAdapter final : public SSLAdapter {
                SocketAddress* paddr,
                int64_t* timestamp) override;
   int Close() override;
+  // Data sent through this adapter is encrypted by it, so its own records
+  // cannot be offloaded to the kernel by a layer above.
+  int EnableKernelTlsTx(const void* crypto_info, size_t size) override;
   // Note that the socket returns ST_CONNECTING while SSL is being negotiated.
   ConnState GetState() const override;
   bool IsResumedSession() override;
@@ -118,6 +122,9 @@ class OpenSSLAdapter final : public SSLAdapter {
   void Error(absl::string_view context, int err, bool signal = true);
   void Cleanup();
   void OnTimeout();
+  // Called once the handshake is done. Tries to move the encryption of
+  // outgoing records to the kernel, if `kernel_tls_offload_` is set.
+  void MaybeEnableKernelTlsTx();
 
   // Return value and arguments have the same meanings as for Send; `error` is
   // an output parameter filled with the result of SSL_get_error.
@@ -182,6 +189,11 @@ class OpenSSLAdapter final : public SSLAdapter {
   std::vector<std::string> elliptic_curves_;
   // Holds the result of the call to run of the ssl_cert_verify_->Verify()
   bool custom_cert_verifier_status_;
+  // Whether to try to offload record encryption to the kernel.
+  bool kernel_tls_offload_ = false;
+  // Whether the kernel encrypts outgoing records, in which case data is sent
+  // as is and SSL_write must no longer be used.
+  bool kernel_tls_tx_ = false;
   // Flag to cancel pending timeout task.
   webrtc::ScopedTaskSafety timer_;
 };
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/openssl_aes_gcm.h"
+
+#include <openssl/evp.h>
+
+#include <memory>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/openssl.h"
+
+namespace rtc {
+
+std::unique_ptr<OpenSSLAesGcm> OpenSSLAesGcm::Create(
+    ArrayView<const uint8_t> key) {
+  const EVP_CIPHER* cipher;
+  switch (key.size()) {
+    case 16:
+      cipher = EVP_aes_128_gcm();
+      break;
+    case 32:
+      cipher = EVP_aes_256_gcm();
+      break;
+    default:
+      return nullptr;
+  }
+  return std::unique_ptr<OpenSSLAesGcm>(new OpenSSLAesGcm(cipher, key));
+}
+
+OpenSSLAesGcm::OpenSSLAesGcm(const EVP_CIPHER* cipher,
+                             ArrayView<const uint8_t> key)
+    : cipher_(cipher), key_(key.data(), key.size()) {}
+
+OpenSSLAesGcm::~OpenSSLAesGcm() = default;
+
+void OpenSSLAesGcm::CipherCtxDeleter::operator()(EVP_CIPHER_CTX* ctx) const {
+  EVP_CIPHER_CTX_free(ctx);
+}
+
+OpenSSLAesGcm::ScopedCipherCtx OpenSSLAesGcm::AcquireContext(
+    bool encrypt,
+    ArrayView<const uint8_t> nonce) const {
+  ScopedCipherCtx ctx;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    std::vector<ScopedCipherCtx>& contexts =
+        encrypt ? seal_contexts_ : open_contexts_;
+    if (!contexts.empty()) {
+      ctx = std::move(contexts.back());
+      contexts.pop_back();
+    }
+  }
+  if (!ctx) {
+    ctx.reset(EVP_CIPHER_CTX_new());
+    if (!ctx || !EVP_CipherInit_ex(ctx.get(), cipher_, nullptr, key_.data(),
+                                   nullptr, encrypt ? 1 : 0)) {
+      return nullptr;
+    }
+  }
+  // Passing only the nonce keeps the key schedule and resets the GCM state.
+  if (!EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, nullptr, nonce.data(),
+                         encrypt ? 1 : 0)) {
+    return nullptr;
+  }
+  return ctx;
+}
+
+void OpenSSLAesGcm::ReleaseContext(bool encrypt, ScopedCipherCtx ctx) const {
+  webrtc::MutexLock lock(&mutex_);
+  (encrypt ? seal_contexts_ : open_contexts_).push_back(std::move(ctx));
+}
+
+bool OpenSSLAesGcm::Seal(
+    ArrayView<const uint8_t> nonce,
+    ArrayView<const ArrayView<const uint8_t>> additional_data,
+    ArrayView<const uint8_t> plaintext,
+    ArrayView<uint8_t> ciphertext,
+    ArrayView<uint8_t> tag) const {
+  RTC_DCHECK_EQ(nonce.size(), kNonceSize);
+  RTC_DCHECK_GE(ciphertext.size(), plaintext.size());
+  RTC_DCHECK_EQ(tag.size(), kTagSize);
+
+  ScopedCipherCtx ctx = AcquireContext(/*encrypt=*/true, nonce);
+  if (!ctx) {
+    return false;
+  }
+  int len = 0;
+  for (ArrayView<const uint8_t> data : additional_data) {
+    if (!data.empty() &&
+        !EVP_EncryptUpdate(ctx.get(), nullptr, &len, data.data(),
+                           checked_cast<int>(data.size()))) {
+      return false;
+    }
+  }
+  if (!EVP_EncryptUpdate(ctx.get(), ciphertext.data(), &len, plaintext.data(),
+                         checked_cast<int>(plaintext.size()))) {
+    return false;
+  }
+  // GCM is a stream mode, so everything has been written by Update.
+  int final_len = 0;
+  if (!EVP_EncryptFinal_ex(ctx.get(), ciphertext.data() + len, &final_len) ||
+      !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, kTagSize,
+                           tag.data())) {
+    return false;
+  }
+  RTC_DCHECK_EQ(len + final_len, plaintext.size());
+  ReleaseContext(/*encrypt=*/true, std::move(ctx));
+  return true;
+}
+
+bool OpenSSLAesGcm::Open(
+    ArrayView<const uint8_t> nonce,
+    ArrayView<const ArrayView<const uint8_t>> additional_data,
+    ArrayView<const uint8_t> ciphertext,
+    ArrayView<const uint8_t> tag,
+    ArrayView<uint8_t> plaintext) const {
+  RTC_DCHECK_EQ(nonce.size(), kNonceSize);
+  RTC_DCHECK_GE(plaintext.size(), ciphertext.size());
+  if (tag.size() != kTagSize) {
+    return false;
+  }
+
+  ScopedCipherCtx ctx = AcquireContext(/*encrypt=*/false, nonce);
+  if (!ctx) {
+    return false;
+  }
+  int len = 0;
+  for (ArrayView<const uint8_t> data : additional_data) {
+    if (!data.empty() &&
+        !EVP_DecryptUpdate(ctx.get(), nullptr, &len, data.data(),
+                           checked_cast<int>(data.size()))) {
+      return false;
+    }
+  }
+  // The tag is only read, but the control interface is not const-correct.
+  if (!EVP_DecryptUpdate(ctx.get(), plaintext.data(), &len, ciphertext.data(),
+                         checked_cast<int>(ciphertext.size())) ||
+      !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, kTagSize,
+                           const_cast<uint8_t*>(tag.data()))) {
+    return false;
+  }
+  int final_len = 0;
+  bool authenticated =
+      EVP_DecryptFinal_ex(ctx.get(), plaintext.data() + len, &final_len) > 0;
+  // A failed authentication leaves the context usable once the next nonce is
+  // set, so it goes back to the pool either way.
+  ReleaseContext(/*encrypt=*/false, std::move(ctx));
+  return authenticated;
+}
+
+}  // namespace rtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2023 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_OPENSSL_AES_GCM_H_
+#define RTC_BASE_OPENSSL_AES_GCM_H_
+
+#include <openssl/ossl_typ.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// AES-GCM authenticated encryption with a fixed key, using the EVP interface of
+// OpenSSL/BoringSSL. The library picks its hardware accelerated implementation
+// (AES-NI and VAES on x86, the crypto extensions on ARMv8) when available.
+// The key schedule is computed once per cipher context, and contexts are
+// reused across calls, so that a call only sets up the nonce. Seal() and Open()
+// may be called concurrently; each concurrent caller gets its own context.
+class RTC_EXPORT OpenSSLAesGcm final {
+ public:
+  static constexpr size_t kNonceSize = 12;
+  static constexpr size_t kTagSize = 16;
+
+  // Returns null unless `key` is 16 (AES-128-GCM) or 32 (AES-256-GCM) bytes.
+  static std::unique_ptr<OpenSSLAesGcm> Create(ArrayView<const uint8_t> key);
+
+  ~OpenSSLAesGcm();
+
+  OpenSSLAesGcm(const OpenSSLAesGcm&) = delete;
+  OpenSSLAesGcm& operator=(const OpenSSLAesGcm&) = delete;
+
+  // Encrypts `plaintext` into `ciphertext`, which must be at least as large,
+  // and writes the authentication tag to `tag`. `ciphertext` may start at the
+  // same address as `plaintext` but must not otherwise overlap it. The
+  // authenticated data is the concatenation of `additional_data`.
+  bool Seal(ArrayView<const uint8_t> nonce,
+            ArrayView<const ArrayView<const uint8_t>> additional_data,
+            ArrayView<const uint8_t> plaintext,
+            ArrayView<uint8_t> ciphertext,
+            ArrayView<uint8_t> tag) const;
+
+  // Decrypts `ciphertext` into `plaintext`, with the same aliasing rules as
+  // Seal(). Returns false if `tag` does not authenticate the input, in which
+  // case the contents of `plaintext` are unspecified.
+  bool Open(ArrayView<const uint8_t> nonce,
+            ArrayView<const ArrayView<const uint8_t>> additional_data,
+            ArrayView<const uint8_t> ciphertext,
+            ArrayView<const uint8_t> tag,
+            ArrayView<uint8_t> plaintext) const;
+
+ private:
+  struct CipherCtxDeleter {
+    void operator()(EVP_CIPHER_CTX* ctx) const;
+  };
+  using ScopedCipherCtx = std::unique_ptr<EVP_CIPHER_CTX, CipherCtxDeleter>;
+
+  OpenSSLAesGcm(const EVP_CIPHER* cipher, ArrayView<const uint8_t> key);
+
+  // Returns a context keyed for encryption or decryption, taken from the pool
+  // or created if the pool is empty, with `nonce` set. Returns null on error.
+  ScopedCipherCtx AcquireContext(bool encrypt,
+                                 ArrayView<const uint8_t> nonce) const;
+  // Puts `ctx` back into the pool it was taken from.
+  void ReleaseContext(bool encrypt, ScopedCipherCtx ctx) const;
+
+  const EVP_CIPHER* const cipher_;
+  const ZeroOnFreeBuffer<uint8_t> key_;
+
+  mutable webrtc::Mutex mutex_;
+  // Keyed contexts that are not in use, grown to the largest number of
+  // concurrent calls seen.
+  mutable std::vector<ScopedCipherCtx> seal_contexts_ RTC_GUARDED_BY(mutex_);
+  mutable std::vector<ScopedCipherCtx> open_contexts_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_OPENSSL_AES_GCM_H_
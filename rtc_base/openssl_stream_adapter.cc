@@ -23,7 +23,10 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -31,6 +34,7 @@
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
@@ -44,6 +48,7 @@
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
@@ -156,6 +161,110 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+// Bounds on the process-wide session resumption state below. The oldest
+// entries are evicted first.
+constexpr size_t kMaxCachedDtlsSessions = 64;
+constexpr size_t kMaxSessionTicketKeys = 16;
+#ifdef OPENSSL_IS_BORINGSSL
+constexpr size_t kSessionTicketKeysLength = 48;
+#else
+constexpr size_t kSessionTicketKeysLength = 80;
+#endif
+// Both ends must use the same context for a session to be resumed.
+constexpr char kDtlsSessionIdContext[] = "WebRTC-DTLS";
+
+using SessionTicketKeys = std::array<uint8_t, kSessionTicketKeysLength>;
+
+template <typename Map>
+typename Map::iterator FindOldestEntry(Map& map) {
+  return std::min_element(map.begin(), map.end(),
+                          [](const auto& a, const auto& b) {
+                            return a.second.generation < b.second.generation;
+                          });
+}
+
+// Holds the client DTLS sessions, keyed by the local and peer certificate
+// fingerprints, and the session ticket keys of each local certificate. Every
+// OpenSSLStreamAdapter has its own SSL_CTX, so this state has to outlive them
+// for a later connection between the same endpoints to be resumed.
+class DtlsSessionCache {
+ public:
+  static DtlsSessionCache& Get() {
+    static DtlsSessionCache* const cache = new DtlsSessionCache();
+    return *cache;
+  }
+
+  // Returns the session cached for `key` with a new reference, or null.
+  SSL_SESSION* Lookup(const std::string& key) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = sessions_.find(key);
+    if (it == sessions_.end()) {
+      return nullptr;
+    }
+    SSL_SESSION_up_ref(it->second.session);
+    return it->second.session;
+  }
+
+  // Takes ownership of `session`, replacing any session cached for `key`.
+  void Add(const std::string& key, SSL_SESSION* session) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second.session);
+      sessions_.erase(it);
+    } else if (sessions_.size() >= kMaxCachedDtlsSessions) {
+      auto oldest = FindOldestEntry(sessions_);
+      SSL_SESSION_free(oldest->second.session);
+      sessions_.erase(oldest);
+    }
+    sessions_.emplace(key, CachedSession{session, next_generation_++});
+  }
+
+  void Remove(const std::string& key) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second.session);
+      sessions_.erase(it);
+    }
+  }
+
+  // Returns the session ticket keys used by servers with the certificate
+  // `fingerprint`, generating them on first use.
+  bool GetTicketKeys(const std::string& fingerprint, SessionTicketKeys* keys) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = ticket_keys_.find(fingerprint);
+    if (it == ticket_keys_.end()) {
+      TicketKeys entry;
+      if (!RAND_bytes(entry.keys.data(), entry.keys.size())) {
+        return false;
+      }
+      if (ticket_keys_.size() >= kMaxSessionTicketKeys) {
+        ticket_keys_.erase(FindOldestEntry(ticket_keys_));
+      }
+      entry.generation = next_generation_++;
+      it = ticket_keys_.emplace(fingerprint, entry).first;
+    }
+    *keys = it->second.keys;
+    return true;
+  }
+
+ private:
+  struct CachedSession {
+    SSL_SESSION* session;
+    uint64_t generation;
+  };
+  struct TicketKeys {
+    SessionTicketKeys keys;
+    uint64_t generation = 0;
+  };
+
+  webrtc::Mutex mutex_;
+  std::map<std::string, CachedSession> sessions_ RTC_GUARDED_BY(mutex_);
+  std::map<std::string, TicketKeys> ticket_keys_ RTC_GUARDED_BY(mutex_);
+  uint64_t next_generation_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -307,7 +416,9 @@ OpenSSLStreamAdapter::OpenSSLStreamAdapter(
       ssl_max_version_(SSL_PROTOCOL_TLS_12),
       // Default is to support legacy TLS protocols.
       // This will be changed to default non-support in M82 or M83.
-      support_legacy_tls_protocols_flag_(ShouldAllowLegacyTLSProtocols()) {
+      support_legacy_tls_protocols_flag_(ShouldAllowLegacyTLSProtocols()),
+      session_resumption_enabled_(
+          webrtc::field_trial::IsEnabled("WebRTC-DtlsSessionResumption")) {
   stream_->SignalEvent.connect(this, &OpenSSLStreamAdapter::OnEvent);
 }
 
@@ -377,6 +488,7 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
   }
 
   if (state_ == SSL_CONNECTED) {
+    MaybeCacheSession();
     // Post the event asynchronously to unwind the stack. The caller
     // of ContinueSSL may be the same object listening for these
     // events and may not be prepared for reentrancy.
@@ -523,6 +635,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+bool OpenSSLStreamAdapter::IsResumedSession() const {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   // Don't allow StartSSL to be called twice.
   if (state_ != SSL_NONE) {
@@ -558,6 +674,11 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetSessionResumptionEnabled(bool enabled) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  session_resumption_enabled_ = enabled;
+}
+
 //
 // StreamInterface Implementation
 //
@@ -867,6 +988,18 @@ int OpenSSLStreamAdapter::BeginSSL() {
 
   SSL_set_app_data(ssl_, this);
 
+  if (role_ == SSL_CLIENT) {
+    // Offer the session from an earlier connection to the same peer, if any.
+    std::string session_key = SessionCacheKey();
+    if (!session_key.empty()) {
+      SSL_SESSION* session = DtlsSessionCache::Get().Lookup(session_key);
+      if (session) {
+        SSL_set_session(ssl_, session);
+        SSL_SESSION_free(session);
+      }
+    }
+  }
+
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
   if (ssl_mode_ == SSL_MODE_DTLS) {
 #ifdef OPENSSL_IS_BORINGSSL
@@ -898,11 +1031,24 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_DLOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_)) {
+        RTC_DLOG(LS_INFO) << " -- resumed session";
+        // The verify callback isn't invoked when resuming, so the certificate
+        // digest has to be checked here.
+        SetPeerCertChainFromSession();
+        if (HasPeerCertificateDigest() && !VerifyPeerCertificate()) {
+          if (role_ == SSL_CLIENT) {
+            DtlsSessionCache::Get().Remove(SessionCacheKey());
+          }
+          return -1;
+        }
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
 
       state_ = SSL_CONNECTED;
+      MaybeCacheSession();
       if (!WaitingToVerifyPeerCertificate()) {
         // We have everything we need to start the connection, so signal
         // SE_OPEN. If we need a client certificate fingerprint and don't have
@@ -1057,6 +1203,31 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     return nullptr;
   }
 
+  if (ShouldResumeSessions()) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    size_t digest_length;
+    std::string fingerprint;
+    if (identity_->certificate().ComputeDigest(
+            DIGEST_SHA_256, digest, sizeof(digest), &digest_length)) {
+      fingerprint = hex_encode(
+          absl::string_view(reinterpret_cast<char*>(digest), digest_length));
+    }
+    // Servers with the same certificate share ticket keys, so that tickets
+    // issued on an earlier connection can be decrypted.
+    SessionTicketKeys ticket_keys;
+    if (!fingerprint.empty() &&
+        DtlsSessionCache::Get().GetTicketKeys(fingerprint, &ticket_keys) &&
+        SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_keys.data(),
+                                       ticket_keys.size()) &&
+        SSL_CTX_set_session_id_context(
+            ctx, reinterpret_cast<const unsigned char*>(kDtlsSessionIdContext),
+            sizeof(kDtlsSessionIdContext) - 1)) {
+      local_fingerprint_ = std::move(fingerprint);
+    } else {
+      RTC_LOG(LS_WARNING) << "Failed to set up DTLS session resumption.";
+    }
+  }
+
 #if !defined(NDEBUG)
   SSL_CTX_set_info_callback(ctx, OpenSSLAdapter::SSLInfoCallback);
 #endif
@@ -1132,6 +1303,58 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   return true;
 }
 
+bool OpenSSLStreamAdapter::ShouldResumeSessions() const {
+  return session_resumption_enabled_ && ssl_mode_ == SSL_MODE_DTLS &&
+         identity_ != nullptr;
+}
+
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (local_fingerprint_.empty() || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  absl::string_view peer_digest(
+      reinterpret_cast<const char*>(peer_certificate_digest_value_.data()),
+      peer_certificate_digest_value_.size());
+  return local_fingerprint_ + "|" + peer_certificate_digest_algorithm_ + "|" +
+         hex_encode(peer_digest);
+}
+
+void OpenSSLStreamAdapter::SetPeerCertChainFromSession() {
+#ifdef OPENSSL_IS_BORINGSSL
+  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl_);
+  if (!chain) {
+    return;
+  }
+  std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
+  for (CRYPTO_BUFFER* cert : chain) {
+    cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
+  }
+  peer_cert_chain_.reset(new SSLCertChain(std::move(cert_chain)));
+#else
+  X509* cert = SSL_SESSION_get0_peer(SSL_get_session(ssl_));
+  if (!cert) {
+    return;
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+#endif
+}
+
+void OpenSSLStreamAdapter::MaybeCacheSession() {
+  // Only clients offer sessions; servers resume from session tickets.
+  if (role_ != SSL_CLIENT || !peer_certificate_verified_) {
+    return;
+  }
+  std::string session_key = SessionCacheKey();
+  if (session_key.empty()) {
+    return;
+  }
+  SSL_SESSION* session = SSL_get1_session(ssl_);
+  if (session) {
+    DtlsSessionCache::Get().Add(session_key, session);
+  }
+}
+
 std::unique_ptr<SSLCertChain> OpenSSLStreamAdapter::GetPeerSSLCertChain()
     const {
   return peer_cert_chain_ ? peer_cert_chain_->Clone() : nullptr;
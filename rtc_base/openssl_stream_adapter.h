@@ -94,6 +94,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetSessionResumptionEnabled(bool enabled) override;
 
   StreamResult Read(rtc::ArrayView<uint8_t> data,
                     size_t& read,
@@ -124,6 +125,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   bool GetDtlsSrtpCryptoSuite(int* crypto_suite) override;
 
   bool IsTlsConnected() override;
+  bool IsResumedSession() const override;
 
   // Capabilities interfaces.
   static bool IsBoringSsl();
@@ -182,6 +184,19 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // Verify the peer certificate matches the signaled digest.
   bool VerifyPeerCertificate();
 
+  // Session resumption helpers. Resumption is only attempted for DTLS with a
+  // local identity, since sessions are keyed by both certificates.
+  bool ShouldResumeSessions() const;
+  // Builds a cache key from the local certificate fingerprint and the peer
+  // certificate digest. Empty if the peer digest isn't known yet.
+  std::string SessionCacheKey() const;
+  // The verify callback isn't run for resumed sessions, so the peer
+  // certificate chain is instead taken from the session.
+  void SetPeerCertChainFromSession();
+  // Remembers the established session, if we are the client and the peer
+  // certificate has been verified.
+  void MaybeCacheSession();
+
 #ifdef OPENSSL_IS_BORINGSSL
   // SSL certificate verification callback. See SSL_CTX_set_custom_verify.
   static enum ssl_verify_result_t SSLVerifyCallback(SSL* ssl,
@@ -247,6 +262,11 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   // TODO(https://bugs.webrtc.org/10261): Completely remove this option in M84.
   const bool support_legacy_tls_protocols_flag_;
+
+  bool session_resumption_enabled_;
+  // Hex encoded SHA-256 fingerprint of our certificate, set when resumption is
+  // in use. Kept separately since `identity_` is released in Cleanup().
+  std::string local_fingerprint_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -58,6 +58,10 @@
 #include <linux/sockios.h>
 #endif
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include <linux/tls.h>
+#endif
+
 #if defined(WEBRTC_WIN)
 #define LAST_SYSTEM_ERROR (::GetLastError())
 #elif defined(__native_client__) && __native_client__
@@ -351,6 +355,25 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   return result;
 }
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+int PhysicalSocket::EnableKernelTlsTx(const void* crypto_info, size_t size) {
+#if !defined(SOL_TLS)
+  static constexpr int SOL_TLS = 282;
+#endif
+  if (udp_) {
+    return -1;
+  }
+  // Attaching the TLS upper layer protocol alone does not change what is
+  // sent, so there is nothing to undo if installing the keys fails.
+  if (::setsockopt(s_, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 ||
+      ::setsockopt(s_, SOL_TLS, TLS_TX, crypto_info, size) != 0) {
+    RTC_LOG(LS_INFO) << "Kernel TLS not available, error " << errno;
+    return -1;
+  }
+  return 0;
+}
+#endif
+
 int PhysicalSocket::Send(const void* pv, size_t cb) {
   int sent = DoSend(
       s_, reinterpret_cast<const char*>(pv), static_cast<int>(cb),
@@ -154,6 +154,9 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
   int GetOption(Option opt, int* value) override;
   int SetOption(Option opt, int value) override;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  int EnableKernelTlsTx(const void* crypto_info, size_t size) override;
+#endif
 
   int Send(const void* pv, size_t cb) override;
   int SendTo(const void* buffer,
@@ -70,7 +70,7 @@ void RateStatistics::Update(int64_t count, int64_t now_ms) {
                           << buckets_.back().timestamp << ", aligning to that.";
       now_ms = buckets_.back().timestamp;
     }
-    buckets_.emplace_back(now_ms);
+    buckets_.push_back(Bucket(now_ms));
   }
   Bucket& last_bucket = buckets_.back();
   last_bucket.sum += count;
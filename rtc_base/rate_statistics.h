@@ -14,10 +14,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <deque>
 #include <memory>
 
 #include "absl/types/optional.h"
+#include "rtc_base/containers/ring_deque.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -72,13 +72,15 @@ class RTC_EXPORT RateStatistics {
   void EraseOld(int64_t now_ms);
 
   struct Bucket {
+    Bucket() = default;
     explicit Bucket(int64_t timestamp);
-    int64_t sum;  // Sum of all samples in this bucket.
-    int num_samples;          // Number of samples in this bucket.
-    const int64_t timestamp;  // Timestamp this bucket corresponds to.
+    int64_t sum = 0;        // Sum of all samples in this bucket.
+    int num_samples = 0;    // Number of samples in this bucket.
+    int64_t timestamp = 0;  // Timestamp this bucket corresponds to.
   };
-  // All buckets within the time window, ordered by time.
-  std::deque<Bucket> buckets_;
+  // All buckets within the time window, ordered by time. A ring buffer, so
+  // that updates stop allocating once it has grown to fit the window.
+  RingDeque<Bucket> buckets_;
 
   // Total count recorded in all buckets.
   int64_t accumulated_count_;
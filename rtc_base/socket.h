@@ -127,6 +127,15 @@ class Socket {
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
 
+  // Hands the encryption of outgoing TLS records over to the kernel (Linux
+  // kernel TLS). `crypto_info` is one of the kernel's tls12_crypto_info_*
+  // structs, holding the keys and record sequence number to continue from.
+  // After this succeeds, Send() takes plaintext. Returns -1 if the socket
+  // does not support it, in which case the socket is left unchanged.
+  virtual int EnableKernelTlsTx(const void* crypto_info, size_t size) {
+    return -1;
+  }
+
   // SignalReadEvent and SignalWriteEvent use multi_threaded_local to allow
   // access concurrently from different thread.
   // For example SignalReadEvent::connect will be called in AsyncUDPSocket ctor
@@ -87,6 +87,12 @@ class SSLAdapter : public AsyncSocketAdapter {
   // Choose whether the socket acts as a server socket or client socket.
   virtual void SetRole(SSLRole role) = 0;
 
+  // Whether to hand the encryption of outgoing records over to the kernel
+  // once the handshake is done (see Socket::EnableKernelTlsTx). Records are
+  // encrypted in user space whenever the socket, the negotiated protocol
+  // version or the cipher do not support it.
+  virtual void SetKernelTlsOffload(bool enable) = 0;
+
   // StartSSL returns 0 if successful.
   // If StartSSL is called while the socket is closed or connecting, the SSL
   // negotiation will begin as soon as the socket connects.
@@ -16,9 +16,11 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "rtc_base/async_socket.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/message_digest.h"
+#include "rtc_base/physical_socket_server.h"
 #include "rtc_base/socket_stream.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
@@ -54,14 +56,59 @@ class MockCertVerifier : public rtc::SSLCertificateVerifier {
   MOCK_METHOD(bool, Verify, (const rtc::SSLCertificate&), (override));
 };
 
+// Socket that records the kernel TLS requests made through it. Unless it
+// forwards them, it pretends that the kernel took over record encryption.
+class KernelTlsSocket : public rtc::AsyncSocketAdapter {
+ public:
+  KernelTlsSocket(rtc::Socket* socket, bool forward_to_socket)
+      : AsyncSocketAdapter(socket), forward_to_socket_(forward_to_socket) {}
+
+  int EnableKernelTlsTx(const void* crypto_info, size_t size) override {
+    offload_requested_ = true;
+    offload_enabled_ =
+        !forward_to_socket_ ||
+        AsyncSocketAdapter::EnableKernelTlsTx(crypto_info, size) == 0;
+    return offload_enabled_ ? 0 : -1;
+  }
+
+  int Send(const void* pv, size_t cb) override {
+    if (offload_enabled_) {
+      bytes_sent_after_offload_ += cb;
+    }
+    return AsyncSocketAdapter::Send(pv, cb);
+  }
+
+  int Recv(void* pv, size_t cb, int64_t* timestamp) override {
+    int read = AsyncSocketAdapter::Recv(pv, cb, timestamp);
+    if (corrupt_reads_ && read > 0) {
+      static_cast<uint8_t*>(pv)[read - 1] ^= 1;
+    }
+    return read;
+  }
+
+  bool offload_requested() const { return offload_requested_; }
+  bool offload_enabled() const { return offload_enabled_; }
+  size_t bytes_sent_after_offload() const { return bytes_sent_after_offload_; }
+  void set_corrupt_reads(bool corrupt_reads) { corrupt_reads_ = corrupt_reads; }
+
+ private:
+  const bool forward_to_socket_;
+  bool offload_requested_ = false;
+  bool offload_enabled_ = false;
+  size_t bytes_sent_after_offload_ = 0;
+  bool corrupt_reads_ = false;
+};
+
 // TODO(benwright) - Move to using INSTANTIATE_TEST_SUITE_P instead of using
 // duplicate test cases for simple parameter changes.
 class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
  public:
   explicit SSLAdapterTestDummyClient(const rtc::SSLMode& ssl_mode)
-      : ssl_mode_(ssl_mode) {
-    rtc::Socket* socket = CreateSocket(ssl_mode_);
+      : SSLAdapterTestDummyClient(ssl_mode, CreateSocket(ssl_mode)) {}
 
+  // Takes ownership of `socket`.
+  SSLAdapterTestDummyClient(const rtc::SSLMode& ssl_mode, rtc::Socket* socket)
+      : ssl_mode_(ssl_mode) {
     ssl_adapter_.reset(rtc::SSLAdapter::Create(socket));
 
     ssl_adapter_->SetMode(ssl_mode_);
@@ -93,6 +140,10 @@ class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
     ssl_adapter_->SetEllipticCurves(curves);
   }
 
+  void SetKernelTlsOffload(bool enable) {
+    ssl_adapter_->SetKernelTlsOffload(enable);
+  }
+
   rtc::SocketAddress GetAddress() const {
     return ssl_adapter_->GetLocalAddress();
   }
@@ -323,6 +374,18 @@ class SSLAdapterTestBase : public ::testing::Test, public sigslot::has_slots<> {
     client_->SetEllipticCurves(curves);
   }
 
+  void SetKernelTlsOffload(bool enable) {
+    client_->SetKernelTlsOffload(enable);
+  }
+
+  // Replaces the client with one connecting through a KernelTlsSocket.
+  KernelTlsSocket* UseKernelTlsSocket(bool forward_to_socket) {
+    auto* socket =
+        new KernelTlsSocket(CreateSocket(ssl_mode_), forward_to_socket);
+    client_ = std::make_unique<SSLAdapterTestDummyClient>(ssl_mode_, socket);
+    return socket;
+  }
+
   void SetMockCertVerifier(bool return_value) {
     auto mock_verifier = std::make_unique<MockCertVerifier>();
     EXPECT_CALL(*mock_verifier, Verify(_)).WillRepeatedly(Return(return_value));
@@ -543,6 +606,64 @@ TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSEllipticCurves) {
   TestTransfer("Hello, world!");
 }
 
+// Test that records are still encrypted in user space when kernel TLS offload
+// is requested but the socket does not support it.
+TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSKernelOffloadFallback) {
+  SetKernelTlsOffload(true);
+  TestHandshake(true);
+  TestTransfer("Hello, world!");
+}
+
+// Test that once the kernel encrypts outgoing records, a read error that calls
+// for an alert closes the connection instead. The alert would be encrypted
+// with a nonce that the kernel has already used.
+TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSKernelOffloadClosesInsteadOfAlert) {
+  KernelTlsSocket* socket = UseKernelTlsSocket(/*forward_to_socket=*/false);
+  SetKernelTlsOffload(true);
+  TestHandshake(true);
+  if (!socket->offload_enabled()) {
+    GTEST_SKIP() << "Record keys can only be exported with BoringSSL.";
+  }
+
+  // The client fails to authenticate the server's next record.
+  socket->set_corrupt_reads(true);
+  ASSERT_GT(server_->Send("Hello, world!"), 0);
+  EXPECT_EQ_WAIT(rtc::Socket::CS_CLOSED, client_->GetState(), kTimeout);
+  EXPECT_EQ(0u, socket->bytes_sent_after_offload());
+  EXPECT_EQ("", client_->GetReceivedData());
+}
+
+// Test that the peer can read records encrypted by the kernel, over a real TCP
+// connection.
+TEST(SSLAdapterTestTLSKernelOffload, TestTransferOverLoopback) {
+  rtc::PhysicalSocketServer socket_server;
+  rtc::AutoSocketServerThread thread(&socket_server);
+  SSLAdapterTestDummyServer server(rtc::SSL_MODE_TLS, rtc::KeyParams::ECDSA());
+  auto* socket = new KernelTlsSocket(CreateSocket(rtc::SSL_MODE_TLS),
+                                     /*forward_to_socket=*/true);
+  SSLAdapterTestDummyClient client(rtc::SSL_MODE_TLS, socket);
+  client.SetKernelTlsOffload(true);
+
+  ASSERT_EQ(0, client.Connect(
+                   server.GetHostname(),
+                   rtc::SocketAddress(rtc::IPAddress(INADDR_LOOPBACK),
+                                      server.GetAddress().port())));
+  EXPECT_EQ_WAIT(rtc::Socket::CS_CONNECTED, client.GetState(), kTimeout);
+  if (!socket->offload_requested()) {
+    GTEST_SKIP() << "Record keys can only be exported with BoringSSL.";
+  }
+  if (!socket->offload_enabled()) {
+    GTEST_SKIP() << "TCP_ULP \"tls\" is not available.";
+  }
+
+  const std::string message = "Hello, world!";
+  ASSERT_EQ(static_cast<int>(message.size()), client.Send(message));
+  EXPECT_EQ_WAIT(message, server.GetReceivedData(), kTimeout);
+  EXPECT_EQ(message.size(), socket->bytes_sent_after_offload());
+  ASSERT_EQ(static_cast<int>(message.size()), server.Send(message));
+  EXPECT_EQ_WAIT(message, client.GetReceivedData(), kTimeout);
+}
+
 // Basic tests: DTLS
 
 // Test that handshake works, using RSA
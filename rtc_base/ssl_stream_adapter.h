@@ -151,6 +151,13 @@ class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
   // This should only be called before StartSSL().
   virtual void SetInitialRetransmissionTimeout(int timeout_ms) = 0;
 
+  // Allow a DTLS handshake with a peer we have connected to before, using the
+  // same local and peer certificates, to resume that session with an
+  // abbreviated handshake. Resumed sessions still derive fresh keying
+  // material. Off by default, unless the "WebRTC-DtlsSessionResumption" field
+  // trial is enabled. This should only be called before StartSSL().
+  virtual void SetSessionResumptionEnabled(bool enabled) {}
+
   // StartSSL starts negotiation with a peer, whose certificate is verified
   // using the certificate digest. Generally, SetIdentity() and possibly
   // SetServerRole() should have been called before this.
@@ -227,6 +234,10 @@ class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
   // SS_OPENING but IsTlsConnected should return true.
   virtual bool IsTlsConnected() = 0;
 
+  // Returns true if the established connection resumed an earlier session
+  // rather than doing a full handshake.
+  virtual bool IsResumedSession() const { return false; }
+
   // Capabilities testing.
   // Used to have "DTLS supported", "DTLS-SRTP supported" etc. methods, but now
   // that's assumed.
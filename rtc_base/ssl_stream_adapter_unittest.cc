@@ -1796,3 +1796,125 @@ TEST_F(SSLStreamAdapterTestDTLSLegacyProtocols,
   SetupProtocolVersions(rtc::SSL_PROTOCOL_DTLS_10, rtc::SSL_PROTOCOL_DTLS_10);
   TestHandshake(false);
 }
+
+// Tests for resuming a DTLS session when reconnecting to the same peer.
+class SSLStreamAdapterTestDTLSSessionResumption
+    : public SSLStreamAdapterTestDTLSBase {
+ public:
+  SSLStreamAdapterTestDTLSSessionResumption()
+      : SSLStreamAdapterTestDTLSBase(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256),
+                                     rtc::KeyParams::ECDSA(rtc::EC_NIST_P256)) {
+  }
+
+  void SetUp() override {
+    SSLStreamAdapterTestDTLSBase::SetUp();
+    client_ssl_->SetSessionResumptionEnabled(true);
+    server_ssl_->SetSessionResumptionEnabled(true);
+  }
+
+  // Replaces both ends with new adapters, as when the transport is torn down
+  // and recreated. The certificates are kept unless `new_server_identity` is
+  // given.
+  void Reconnect(
+      std::unique_ptr<rtc::SSLIdentity> new_server_identity = nullptr) {
+    std::unique_ptr<rtc::SSLIdentity> client_identity_copy =
+        client_identity()->Clone();
+    std::unique_ptr<rtc::SSLIdentity> server_identity_copy =
+        new_server_identity ? std::move(new_server_identity)
+                            : server_identity()->Clone();
+    client_ssl_.reset();
+    server_ssl_.reset();
+    // Drop anything the old connection left behind, such as close alerts.
+    DrainBuffer(&client_buffer_);
+    DrainBuffer(&server_buffer_);
+
+    CreateStreams();
+    client_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(client_stream_));
+    server_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(server_stream_));
+    client_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    client_ssl_->SetIdentity(std::move(client_identity_copy));
+    server_ssl_->SetIdentity(std::move(server_identity_copy));
+    client_ssl_->SetSessionResumptionEnabled(true);
+    server_ssl_->SetSessionResumptionEnabled(true);
+    identities_set_ = false;
+  }
+
+  std::vector<uint8_t> ExportKeys() {
+    std::vector<uint8_t> client_keys(32);
+    std::vector<uint8_t> server_keys(32);
+    EXPECT_TRUE(ExportKeyingMaterial(kExporterLabel, kExporterContext,
+                                     kExporterContextLen, true, true,
+                                     client_keys.data(), client_keys.size()));
+    EXPECT_TRUE(ExportKeyingMaterial(kExporterLabel, kExporterContext,
+                                     kExporterContextLen, true, false,
+                                     server_keys.data(), server_keys.size()));
+    EXPECT_EQ(client_keys, server_keys);
+    return client_keys;
+  }
+
+ private:
+  static void DrainBuffer(BufferQueueStream* buffer) {
+    uint8_t data[kDefaultBufferSize];
+    size_t read;
+    int error;
+    while (buffer->Read(data, read, error) == rtc::SR_SUCCESS) {
+    }
+  }
+};
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption, ResumesWithSamePeer) {
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+  EXPECT_FALSE(server_ssl_->IsResumedSession());
+  std::vector<uint8_t> first_keys = ExportKeys();
+
+  Reconnect();
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsResumedSession());
+  EXPECT_TRUE(server_ssl_->IsResumedSession());
+  // Both ends still know which certificate the peer is using.
+  EXPECT_TRUE(GetPeerCertificate(true));
+  EXPECT_TRUE(GetPeerCertificate(false));
+  // Resuming must not reuse the keys of the earlier connection.
+  EXPECT_NE(first_keys, ExportKeys());
+
+  TestTransfer(100);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption,
+       ResumesWithLostFirstPacket) {
+  TestHandshake();
+
+  Reconnect();
+  SetLoseFirstPacket(true);
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsResumedSession());
+  EXPECT_TRUE(server_ssl_->IsResumedSession());
+}
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption,
+       DoesNotResumeWithDifferentServerCertificate) {
+  TestHandshake();
+
+  Reconnect(rtc::SSLIdentity::Create("server", server_key_type_));
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+  EXPECT_FALSE(server_ssl_->IsResumedSession());
+}
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption, DoesNotResumeWhenDisabled) {
+  TestHandshake();
+
+  Reconnect();
+  client_ssl_->SetSessionResumptionEnabled(false);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsResumedSession());
+  EXPECT_FALSE(server_ssl_->IsResumedSession());
+}
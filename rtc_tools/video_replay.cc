@@ -144,6 +144,13 @@ ABSL_FLAG(uint32_t,
           "RTP stop timestamp, packets with larger timestamp will be ignored "
           "(no wraparound)");
 
+// Flag for where in the input file to start replaying.
+ABSL_FLAG(uint32_t,
+          start_time_ms,
+          0,
+          "Time in the input file to start replaying from, in ms. Earlier "
+          "packets are skipped without being read");
+
 // Flags for render window width and height
 ABSL_FLAG(uint32_t, render_width, 640, "Width of render window");
 ABSL_FLAG(uint32_t, render_height, 480, "Height of render window");
@@ -556,6 +563,10 @@ class RtpReplayer final {
     rtc::Event event(/*manual_reset=*/false, /*initially_signalled=*/false);
     uint32_t start_timestamp = absl::GetFlag(FLAGS_start_timestamp);
     uint32_t stop_timestamp = absl::GetFlag(FLAGS_stop_timestamp);
+    uint32_t start_time_ms = absl::GetFlag(FLAGS_start_time_ms);
+    if (start_time_ms > 0) {
+      rtp_reader_->SeekToTime(start_time_ms);
+    }
 
     RtpHeaderExtensionMap extensions;
     if (absl::GetFlag(FLAGS_transmission_offset_id) != -1) {
@@ -595,7 +606,8 @@ class RtpReplayer final {
         continue;
       }
 
-      int64_t deliver_in_ms = replay_start_ms + packet.time_ms - now_ms;
+      int64_t deliver_in_ms =
+          replay_start_ms + packet.time_ms - start_time_ms - now_ms;
       SleepOrAdvanceTime(deliver_in_ms);
 
       ++num_packets;
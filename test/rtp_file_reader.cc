@@ -11,16 +11,28 @@
 #include "test/rtp_file_reader.h"
 
 #include <stdio.h>
+#include <string.h>
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
+#include "rtc_base/system/file_wrapper.h"
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace webrtc {
 namespace test {
@@ -36,105 +48,290 @@ static uint16_t kPacketHeaderSize = 8;
     }                                       \
   } while (0)
 
-bool ReadUint32(uint32_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 4; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
-      return false;
-    *out |= tmp;
+// The contents of the file being read. The file is memory mapped if possible,
+// and otherwise read through a FileWrapper as the data is needed, so that it
+// never has to be loaded in full.
+class FileContents {
+ public:
+  static std::unique_ptr<FileContents> Open(absl::string_view filename) {
+    std::string filename_str = std::string(filename);
+    auto contents = std::unique_ptr<FileContents>(new FileContents());
+#if defined(WEBRTC_POSIX)
+    int fd = open(filename_str.c_str(), O_RDONLY);
+    if (fd < 0)
+      return nullptr;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void* mapped = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+                          fd, 0);
+      if (mapped != MAP_FAILED) {
+        // Packets are mostly read in order.
+        madvise(mapped, file_stat.st_size, MADV_SEQUENTIAL);
+        contents->mapped_ = mapped;
+        contents->data_ = rtc::ArrayView<const uint8_t>(
+            static_cast<const uint8_t*>(mapped), file_stat.st_size);
+        close(fd);
+        return contents;
+      }
+    }
+    close(fd);
+#endif
+    contents->file_ = FileWrapper::OpenReadOnly(filename_str);
+    if (!contents->file_.is_open())
+      return nullptr;
+    return contents;
   }
-  return true;
-}
 
-bool ReadUint16(uint16_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 2; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
-      return false;
-    *out |= tmp;
+  static std::unique_ptr<FileContents> Copy(const uint8_t* data, size_t size) {
+    auto contents = std::unique_ptr<FileContents>(new FileContents());
+    contents->buffer_.assign(data, data + size);
+    contents->data_ = contents->buffer_;
+    return contents;
   }
-  return true;
-}
 
-class RtpFileReaderImpl : public RtpFileReader {
- public:
-  virtual bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) = 0;
+  ~FileContents() {
+#if defined(WEBRTC_POSIX)
+    if (mapped_)
+      munmap(mapped_, data_.size());
+#endif
+  }
+
+  FileContents(const FileContents&) = delete;
+  FileContents& operator=(const FileContents&) = delete;
+
+  // Returns the `length` bytes at `pos`, or fewer if the file ends before
+  // that. If the file is read through `file_`, the data is only valid until
+  // the next call.
+  rtc::ArrayView<const uint8_t> Read(size_t pos, size_t length) const {
+    if (!file_.is_open())
+      return data_.subview(pos, length);
+    if (pos == buffer_pos_ && length <= buffer_.size())
+      return rtc::ArrayView<const uint8_t>(buffer_.data(), length);
+    // Indexing reads the file in order, so only seek when jumping around.
+    if (pos != file_pos_) {
+      if (!file_.SeekTo(pos))
+        return {};
+      file_pos_ = pos;
+    }
+    buffer_.resize(length);
+    buffer_.resize(file_.Read(buffer_.data(), length));
+    buffer_pos_ = pos;
+    file_pos_ += buffer_.size();
+    return buffer_;
+  }
+
+ private:
+  FileContents() = default;
+
+  void* mapped_ = nullptr;
+  rtc::ArrayView<const uint8_t> data_;
+  // Only open if the file couldn't be memory mapped.
+  mutable FileWrapper file_;
+  mutable size_t file_pos_ = 0;
+  // The data of Copy(), or the data last read from `file_`.
+  mutable std::vector<uint8_t> buffer_;
+  mutable size_t buffer_pos_ = 0;
 };
 
-class InterleavedRtpFileReader : public RtpFileReaderImpl {
+// Reads big endian integers from the file contents, keeping track of the
+// position.
+class Cursor {
  public:
-  ~InterleavedRtpFileReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
-    }
+  explicit Cursor(const FileContents& contents, size_t pos = 0)
+      : contents_(contents), pos_(pos) {}
+
+  size_t pos() const { return pos_; }
+
+  bool ReadUint32(uint32_t* out) {
+    rtc::ArrayView<const uint8_t> data = contents_.Read(pos_, 4);
+    if (data.size() < 4)
+      return false;
+    *out = ByteReader<uint32_t>::ReadBigEndian(data.data());
+    pos_ += 4;
+    return true;
   }
 
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    file_ = file;
+  bool ReadUint16(uint16_t* out) {
+    rtc::ArrayView<const uint8_t> data = contents_.Read(pos_, 2);
+    if (data.size() < 2)
+      return false;
+    *out = ByteReader<uint16_t>::ReadBigEndian(data.data());
+    pos_ += 2;
     return true;
   }
 
+  // Skips data that has been checked to be in the file, e.g. by AddPacket().
+  void Skip(size_t length) { pos_ += length; }
+
+ private:
+  const FileContents& contents_;
+  size_t pos_;
+};
+
+class RtpFileReaderImpl : public RtpFileReader {
+ public:
+  bool Init(std::unique_ptr<FileContents> contents,
+            const std::set<uint32_t>& ssrc_filter) {
+    contents_ = std::move(contents);
+    return Index(*contents_, ssrc_filter);
+  }
+
   bool NextPacket(RtpPacket* packet) override {
-    RTC_DCHECK(file_);
-    packet->length = RtpPacket::kMaxPacketBufferSize;
-    uint32_t len = 0;
-    TRY(ReadUint32(&len, file_));
-    if (packet->length < len) {
-      RTC_FATAL() << "Packet is too large to fit: " << len << " bytes vs "
-                  << packet->length
-                  << " bytes allocated. Consider increasing the buffer "
-                  << "size";
-    }
-    if (fread(packet->data, 1, len, file_) != len)
+    if (next_packet_ >= packets_.size())
+      return false;
+    RtpPacketView view = GetPacket(next_packet_);
+    if (view.data.size() > RtpPacket::kMaxPacketBufferSize) {
+      RTC_LOG(LS_ERROR) << "Packet is too large to fit: " << view.data.size()
+                        << " bytes vs " << RtpPacket::kMaxPacketBufferSize
+                        << " bytes allocated. Consider increasing the buffer "
+                           "size";
       return false;
+    }
+    memcpy(packet->data, view.data.data(), view.data.size());
+    packet->length = view.data.size();
+    packet->original_length = view.original_length;
+    packet->time_ms = view.time_ms;
+    ++next_packet_;
+    return true;
+  }
+
+  size_t NumPackets() const override { return packets_.size(); }
+
+  RtpPacketView GetPacket(size_t index) const override {
+    RTC_CHECK_LT(index, packets_.size());
+    const PacketEntry& entry = packets_[index];
+    return {contents_->Read(entry.pos, entry.length), entry.original_length,
+            entry.time_ms};
+  }
+
+  void SeekToPacket(size_t index) override {
+    RTC_DCHECK_LE(index, packets_.size());
+    next_packet_ = index;
+  }
 
-    packet->length = len;
-    packet->original_length = len;
-    packet->time_ms = time_ms_;
-    time_ms_ += 5;
+  size_t SeekToTime(uint32_t time_ms) override {
+    next_packet_ = std::lower_bound(packets_.begin(), packets_.end(), time_ms,
+                                    [](const PacketEntry& entry, uint32_t t) {
+                                      return entry.time_ms < t;
+                                    }) -
+                   packets_.begin();
+    return next_packet_;
+  }
+
+  std::vector<size_t> FindRtpPackets(
+      const std::set<uint32_t>& ssrcs,
+      const std::set<uint8_t>& payload_types) const override {
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < packets_.size(); ++i) {
+      const PacketEntry& entry = packets_[i];
+      if (entry.payload_type < 0)
+        continue;
+      if (!ssrcs.empty() && ssrcs.find(entry.ssrc) == ssrcs.end())
+        continue;
+      if (!payload_types.empty() &&
+          payload_types.find(entry.payload_type) == payload_types.end())
+        continue;
+      indices.push_back(i);
+    }
+    return indices;
+  }
+
+ protected:
+  // Builds the index of the packets in `contents`.
+  virtual bool Index(const FileContents& contents,
+                     const std::set<uint32_t>& ssrc_filter) = 0;
+
+  // Adds the packet at `pos` to the index. Returns false if the file ends
+  // before the end of the packet.
+  bool AddPacket(size_t pos,
+                 size_t length,
+                 size_t original_length,
+                 uint32_t time_ms) {
+    rtc::ArrayView<const uint8_t> packet = contents_->Read(pos, length);
+    if (packet.size() < length)
+      return false;
+    PacketEntry entry;
+    entry.pos = pos;
+    entry.length = length;
+    entry.original_length = original_length;
+    entry.time_ms = time_ms;
+    if (IsRtpPacket(packet)) {
+      entry.ssrc = ParseRtpSsrc(packet);
+      entry.payload_type = ParseRtpPayloadType(packet);
+    }
+    packets_.push_back(entry);
     return true;
   }
 
+  size_t num_packets() const { return packets_.size(); }
+
  private:
-  FILE* file_ = nullptr;
-  int64_t time_ms_ = 0;
+  struct PacketEntry {
+    size_t pos;
+    size_t length;
+    size_t original_length;
+    uint32_t time_ms;
+    uint32_t ssrc = 0;
+    // -1 if not an RTP packet.
+    int payload_type = -1;
+  };
+
+  std::unique_ptr<FileContents> contents_;
+  std::vector<PacketEntry> packets_;
+  size_t next_packet_ = 0;
+};
+
+class InterleavedRtpFileReader : public RtpFileReaderImpl {
+ private:
+  bool Index(const FileContents& contents,
+             const std::set<uint32_t>& ssrc_filter) override {
+    Cursor cursor(contents);
+    uint32_t time_ms = 0;
+    uint32_t len = 0;
+    while (cursor.ReadUint32(&len)) {
+      if (len > RtpPacket::kMaxPacketBufferSize) {
+        RTC_LOG(LS_ERROR) << "Packet is too large to fit: " << len
+                          << " bytes vs " << RtpPacket::kMaxPacketBufferSize
+                          << " bytes allocated.";
+        break;
+      }
+      if (!AddPacket(cursor.pos(), len, len, time_ms))
+        break;
+      cursor.Skip(len);
+      time_ms += 5;
+    }
+    return true;
+  }
 };
 
 // Read RTP packets from file in rtpdump format, as documented at:
 // http://www.cs.columbia.edu/irt/software/rtptools/
 class RtpDumpReader : public RtpFileReaderImpl {
- public:
-  RtpDumpReader() : file_(nullptr) {}
-  ~RtpDumpReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
+ private:
+  bool Index(const FileContents& contents,
+             const std::set<uint32_t>& ssrc_filter) override {
+    // The first line, up to its newline but no longer than
+    // `kFirstLineLength` - 1 characters.
+    rtc::ArrayView<const uint8_t> data =
+        contents.Read(0, kFirstLineLength - 1);
+    size_t first_line_length = 0;
+    while (first_line_length < data.size()) {
+      if (data[first_line_length++] == '\n')
+        break;
     }
-  }
-
-  RtpDumpReader(const RtpDumpReader&) = delete;
-  RtpDumpReader& operator=(const RtpDumpReader&) = delete;
-
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    file_ = file;
-
-    char firstline[kFirstLineLength + 1] = {0};
-    if (fgets(firstline, kFirstLineLength, file_) == nullptr) {
+    if (first_line_length == 0) {
       RTC_LOG(LS_INFO) << "Can't read from file";
       return false;
     }
-    if (strncmp(firstline, "#!rtpplay", 9) == 0) {
-      if (strncmp(firstline, "#!rtpplay1.0", 12) != 0) {
+    std::string firstline(reinterpret_cast<const char*>(data.data()),
+                          first_line_length);
+    if (strncmp(firstline.c_str(), "#!rtpplay", 9) == 0) {
+      if (strncmp(firstline.c_str(), "#!rtpplay1.0", 12) != 0) {
         RTC_LOG(LS_INFO) << "Wrong rtpplay version, must be 1.0";
         return false;
       }
-    } else if (strncmp(firstline, "#!RTPencode", 11) == 0) {
-      if (strncmp(firstline, "#!RTPencode1.0", 14) != 0) {
+    } else if (strncmp(firstline.c_str(), "#!RTPencode", 11) == 0) {
+      if (strncmp(firstline.c_str(), "#!RTPencode1.0", 14) != 0) {
         RTC_LOG(LS_INFO) << "Wrong RTPencode version, must be 1.0";
         return false;
       }
@@ -143,52 +340,31 @@ class RtpDumpReader : public RtpFileReaderImpl {
       return false;
     }
 
+    Cursor cursor(contents, first_line_length);
     uint32_t start_sec;
     uint32_t start_usec;
     uint32_t source;
     uint16_t port;
     uint16_t padding;
-    TRY(ReadUint32(&start_sec, file_));
-    TRY(ReadUint32(&start_usec, file_));
-    TRY(ReadUint32(&source, file_));
-    TRY(ReadUint16(&port, file_));
-    TRY(ReadUint16(&padding, file_));
-
-    return true;
-  }
-
-  bool NextPacket(RtpPacket* packet) override {
-    uint8_t* rtp_data = packet->data;
-    packet->length = RtpPacket::kMaxPacketBufferSize;
+    TRY(cursor.ReadUint32(&start_sec));
+    TRY(cursor.ReadUint32(&start_usec));
+    TRY(cursor.ReadUint32(&source));
+    TRY(cursor.ReadUint16(&port));
+    TRY(cursor.ReadUint16(&padding));
 
     uint16_t len;
     uint16_t plen;
     uint32_t offset;
-    TRY(ReadUint16(&len, file_));
-    TRY(ReadUint16(&plen, file_));
-    TRY(ReadUint32(&offset, file_));
-
-    // Use 'len' here because a 'plen' of 0 specifies rtcp.
-    len -= kPacketHeaderSize;
-    if (packet->length < len) {
-      RTC_LOG(LS_ERROR) << "Packet is too large to fit: " << len << " bytes vs "
-                        << packet->length
-                        << " bytes allocated. Consider increasing the buffer "
-                           "size";
-      return false;
-    }
-    if (fread(rtp_data, 1, len, file_) != len) {
-      return false;
+    while (cursor.ReadUint16(&len) && cursor.ReadUint16(&plen) &&
+           cursor.ReadUint32(&offset)) {
+      // Use 'len' here because a 'plen' of 0 specifies rtcp.
+      len -= kPacketHeaderSize;
+      if (!AddPacket(cursor.pos(), len, plen, offset))
+        break;
+      cursor.Skip(len);
     }
-
-    packet->length = len;
-    packet->original_length = plen;
-    packet->time_ms = offset;
     return true;
   }
-
- private:
-  FILE* file_;
 };
 
 enum {
@@ -233,35 +409,43 @@ const uint32_t kPcapBOMNoSwapOrder = 0xa1b2c3d4UL;
 class PcapReader : public RtpFileReaderImpl {
  public:
   PcapReader()
-      : file_(nullptr),
-        swap_pcap_byte_order_(false),
+      : swap_pcap_byte_order_(false),
 #ifdef WEBRTC_ARCH_BIG_ENDIAN
-        swap_network_byte_order_(false),
+        swap_network_byte_order_(false)
 #else
-        swap_network_byte_order_(true),
+        swap_network_byte_order_(true)
 #endif
-        read_buffer_(),
-        packets_by_ssrc_(),
-        packets_(),
-        next_packet_it_() {
-  }
-
-  ~PcapReader() override {
-    if (file_ != nullptr) {
-      fclose(file_);
-      file_ = nullptr;
-    }
+  {
   }
 
   PcapReader(const PcapReader&) = delete;
   PcapReader& operator=(const PcapReader&) = delete;
 
-  bool Init(FILE* file, const std::set<uint32_t>& ssrc_filter) override {
-    return Initialize(file, ssrc_filter) == kResultSuccess;
+ private:
+  // A marker of an RTP packet within the file.
+  struct RtpPacketMarker {
+    uint32_t packet_number;  // One-based index (like in WireShark)
+    uint32_t time_offset_ms;
+    uint32_t source_ip;
+    uint32_t dest_ip;
+    uint16_t source_port;
+    uint16_t dest_port;
+    // Payload type of the RTP packet,
+    // or RTCP packet type of the first RTCP packet in a compound RTCP packet.
+    int payload_type;
+    size_t pos_in_file;  // Byte offset of payload from start of file.
+    uint32_t payload_length;
+  };
+
+  bool Index(const FileContents& contents,
+             const std::set<uint32_t>& ssrc_filter) override {
+    return Initialize(contents, ssrc_filter) == kResultSuccess;
   }
 
-  int Initialize(FILE* file, const std::set<uint32_t>& ssrc_filter) {
-    file_ = file;
+  int Initialize(const FileContents& contents,
+                 const std::set<uint32_t>& ssrc_filter) {
+    file_ = &contents;
+    pos_ = 0;
 
     if (ReadGlobalHeader() < 0) {
       return kResultFail;
@@ -269,36 +453,52 @@ class PcapReader : public RtpFileReaderImpl {
 
     int total_packet_count = 0;
     uint32_t stream_start_ms = 0;
-    int32_t next_packet_pos = ftell(file_);
+    size_t next_packet_pos = pos_;
+    std::map<uint32_t, std::pair<size_t, int>> packets_by_ssrc;
     for (;;) {
-      TRY_PCAP(fseek(file_, next_packet_pos, SEEK_SET));
+      pos_ = next_packet_pos;
+      RtpPacketMarker marker;
       int result = ReadPacket(&next_packet_pos, stream_start_ms,
-                              ++total_packet_count, ssrc_filter);
+                              ++total_packet_count, &marker);
       if (result == kResultFail) {
         break;
-      } else if (result == kResultSuccess && packets_.size() == 1) {
+      } else if (result == kResultSkip) {
+        continue;
+      }
+      rtc::ArrayView<const uint8_t> packet =
+          file_->Read(marker.pos_in_file, marker.payload_length);
+      if (IsRtpPacket(packet) && !IsRtcpPacket(packet)) {
+        uint32_t ssrc = ParseRtpSsrc(packet);
+        if (!ssrc_filter.empty() &&
+            ssrc_filter.find(ssrc) == ssrc_filter.end()) {
+          continue;
+        }
+        auto& ssrc_stats = packets_by_ssrc[ssrc];
+        if (ssrc_stats.first++ == 0)
+          ssrc_stats.second = marker.payload_type;
+      }
+      if (num_packets() == 0) {
         RTC_DCHECK_EQ(stream_start_ms, 0);
-        PacketIterator it = packets_.begin();
-        stream_start_ms = it->time_offset_ms;
-        it->time_offset_ms = 0;
+        stream_start_ms = marker.time_offset_ms;
+        marker.time_offset_ms = 0;
+      }
+      if (!AddPacket(marker.pos_in_file, marker.payload_length,
+                     marker.payload_length, marker.time_offset_ms)) {
+        break;
       }
     }
 
-    if (feof(file_) == 0) {
+    if (!at_end_) {
       printf("Failed reading file!\n");
       return kResultFail;
     }
 
     printf("Total packets in file: %d\n", total_packet_count);
-    printf("Total RTP/RTCP packets: %zu\n", packets_.size());
+    printf("Total RTP/RTCP packets: %zu\n", num_packets());
 
-    for (SsrcMapIterator mit = packets_by_ssrc_.begin();
-         mit != packets_by_ssrc_.end(); ++mit) {
-      uint32_t ssrc = mit->first;
-      const std::vector<uint32_t>& packet_indices = mit->second;
-      int pt = packets_[packet_indices[0]].payload_type;
-      printf("SSRC: %08x, %zu packets, pt=%d\n", ssrc, packet_indices.size(),
-             pt);
+    for (const auto& [ssrc, stats] : packets_by_ssrc) {
+      printf("SSRC: %08x, %zu packets, pt=%d\n", ssrc, stats.first,
+             stats.second);
     }
 
     // TODO(solenberg): Better validation of identified SSRC streams.
@@ -317,59 +517,9 @@ class PcapReader : public RtpFileReaderImpl {
     // - Can also use srcip:port->dstip:port pairs, assuming few SSRC collisions
     //   for up/down streams.
 
-    next_packet_it_ = packets_.begin();
     return kResultSuccess;
   }
 
-  bool NextPacket(RtpPacket* packet) override {
-    uint32_t length = RtpPacket::kMaxPacketBufferSize;
-    if (NextPcap(packet->data, &length, &packet->time_ms) != kResultSuccess)
-      return false;
-    packet->length = static_cast<size_t>(length);
-    packet->original_length = packet->length;
-    return true;
-  }
-
-  virtual int NextPcap(uint8_t* data, uint32_t* length, uint32_t* time_ms) {
-    RTC_DCHECK(data);
-    RTC_DCHECK(length);
-    RTC_DCHECK(time_ms);
-
-    if (next_packet_it_ == packets_.end()) {
-      return -1;
-    }
-    if (*length < next_packet_it_->payload_length) {
-      return -1;
-    }
-    TRY_PCAP(fseek(file_, next_packet_it_->pos_in_file, SEEK_SET));
-    TRY_PCAP(Read(data, next_packet_it_->payload_length));
-    *length = next_packet_it_->payload_length;
-    *time_ms = next_packet_it_->time_offset_ms;
-    next_packet_it_++;
-
-    return 0;
-  }
-
- private:
-  // A marker of an RTP packet within the file.
-  struct RtpPacketMarker {
-    uint32_t packet_number;  // One-based index (like in WireShark)
-    uint32_t time_offset_ms;
-    uint32_t source_ip;
-    uint32_t dest_ip;
-    uint16_t source_port;
-    uint16_t dest_port;
-    // Payload type of the RTP packet,
-    // or RTCP packet type of the first RTCP packet in a compound RTCP packet.
-    int payload_type;
-    int32_t pos_in_file;  // Byte offset of payload from start of file.
-    uint32_t payload_length;
-  };
-
-  typedef std::vector<RtpPacketMarker>::iterator PacketIterator;
-  typedef std::map<uint32_t, std::vector<uint32_t> > SsrcMap;
-  typedef std::map<uint32_t, std::vector<uint32_t> >::iterator SsrcMapIterator;
-
   int ReadGlobalHeader() {
     uint32_t magic;
     TRY_PCAP(Read(&magic, false));
@@ -408,49 +558,47 @@ class PcapReader : public RtpFileReaderImpl {
     return kResultSuccess;
   }
 
-  int ReadPacket(int32_t* next_packet_pos,
+  // Reads the packet at the current position. Returns kResultSkip for packets
+  // that aren't RTP or RTCP over UDP, and kResultFail at the end of the file
+  // or on errors.
+  int ReadPacket(size_t* next_packet_pos,
                  uint32_t stream_start_ms,
                  uint32_t number,
-                 const std::set<uint32_t>& ssrc_filter) {
+                 RtpPacketMarker* marker) {
     RTC_DCHECK(next_packet_pos);
 
     uint32_t ts_sec;    // Timestamp seconds.
     uint32_t ts_usec;   // Timestamp microseconds.
     uint32_t incl_len;  // Number of octets of packet saved in file.
     uint32_t orig_len;  // Actual length of packet.
-    TRY_PCAP(Read(&ts_sec, false));
-    TRY_PCAP(Read(&ts_usec, false));
-    TRY_PCAP(Read(&incl_len, false));
-    TRY_PCAP(Read(&orig_len, false));
+    TRY_PCAP(ReadOrEnd(&ts_sec, false));
+    TRY_PCAP(ReadOrEnd(&ts_usec, false));
+    TRY_PCAP(ReadOrEnd(&incl_len, false));
+    TRY_PCAP(ReadOrEnd(&orig_len, false));
 
-    *next_packet_pos = ftell(file_) + incl_len;
+    *next_packet_pos = pos_ + incl_len;
 
-    RtpPacketMarker marker = {0};
-    marker.packet_number = number;
-    marker.time_offset_ms = CalcTimeDelta(ts_sec, ts_usec, stream_start_ms);
-    TRY_PCAP(ReadPacketHeader(&marker));
-    marker.pos_in_file = ftell(file_);
+    *marker = {0};
+    marker->packet_number = number;
+    marker->time_offset_ms = CalcTimeDelta(ts_sec, ts_usec, stream_start_ms);
+    TRY_PCAP(ReadPacketHeader(marker));
+    marker->pos_in_file = pos_;
 
-    if (marker.payload_length > sizeof(read_buffer_)) {
+    if (marker->payload_length > kMaxReadBufferSize) {
       printf("Packet too large!\n");
       return kResultFail;
     }
-    TRY_PCAP(Read(read_buffer_, marker.payload_length));
+    rtc::ArrayView<const uint8_t> packet =
+        file_->Read(pos_, marker->payload_length);
+    if (packet.size() < marker->payload_length) {
+      at_end_ = true;
+      return kResultFail;
+    }
 
-    rtc::ArrayView<const uint8_t> packet(read_buffer_, marker.payload_length);
     if (IsRtcpPacket(packet)) {
-      marker.payload_type = packet[1];
-      packets_.push_back(marker);
+      marker->payload_type = packet[1];
     } else if (IsRtpPacket(packet)) {
-      uint32_t ssrc = ParseRtpSsrc(packet);
-      marker.payload_type = ParseRtpPayloadType(packet);
-      if (ssrc_filter.empty() || ssrc_filter.find(ssrc) != ssrc_filter.end()) {
-        packets_by_ssrc_[ssrc].push_back(
-            static_cast<uint32_t>(packets_.size()));
-        packets_.push_back(marker);
-      } else {
-        return kResultSkip;
-      }
+      marker->payload_type = ParseRtpPayloadType(packet);
     } else {
       RTC_LOG(LS_INFO) << "Not recognized as RTP/RTCP";
       return kResultSkip;
@@ -460,14 +608,14 @@ class PcapReader : public RtpFileReaderImpl {
   }
 
   int ReadPacketHeader(RtpPacketMarker* marker) {
-    int32_t file_pos = ftell(file_);
+    size_t file_pos = pos_;
 
     // Check for BSD null/loopback frame header. The header is just 4 bytes in
     // native byte order, so we check for both versions as we don't care about
     // the header as such and will likely fail reading the IP header if this is
     // something else than null/loopback.
     uint32_t protocol;
-    TRY_PCAP(Read(&protocol, true));
+    TRY_PCAP(ReadOrEnd(&protocol, true));
     if (protocol == kBsdNullLoopback1 || protocol == kBsdNullLoopback2) {
       int result = ReadXxpIpHeader(marker);
       RTC_LOG(LS_INFO) << "Recognized loopback frame";
@@ -476,12 +624,12 @@ class PcapReader : public RtpFileReaderImpl {
       }
     }
 
-    TRY_PCAP(fseek(file_, file_pos, SEEK_SET));
+    pos_ = file_pos;
 
     // Check for Ethernet II, IP frame header.
     uint16_t type;
     TRY_PCAP(Skip(kEthernetIIHeaderMacSkip));  // Source+destination MAC.
-    TRY_PCAP(Read(&type, true));
+    TRY_PCAP(ReadOrEnd(&type, true));
     if (type == kEthertypeIp) {
       int result = ReadXxpIpHeader(marker);
       RTC_LOG(LS_INFO) << "Recognized ethernet 2 frame";
@@ -514,14 +662,14 @@ class PcapReader : public RtpFileReaderImpl {
     uint16_t fragment;
     uint16_t protocol;
     uint16_t checksum;
-    TRY_PCAP(Read(&version, true));
-    TRY_PCAP(Read(&length, true));
-    TRY_PCAP(Read(&id, true));
-    TRY_PCAP(Read(&fragment, true));
-    TRY_PCAP(Read(&protocol, true));
-    TRY_PCAP(Read(&checksum, true));
-    TRY_PCAP(Read(&marker->source_ip, true));
-    TRY_PCAP(Read(&marker->dest_ip, true));
+    TRY_PCAP(ReadOrEnd(&version, true));
+    TRY_PCAP(ReadOrEnd(&length, true));
+    TRY_PCAP(ReadOrEnd(&id, true));
+    TRY_PCAP(ReadOrEnd(&fragment, true));
+    TRY_PCAP(ReadOrEnd(&protocol, true));
+    TRY_PCAP(ReadOrEnd(&checksum, true));
+    TRY_PCAP(ReadOrEnd(&marker->source_ip, true));
+    TRY_PCAP(ReadOrEnd(&marker->dest_ip, true));
 
     if (((version >> 12) & 0x000f) != kIpVersion4) {
       RTC_LOG(LS_INFO) << "IP header is not IPv4";
@@ -546,10 +694,10 @@ class PcapReader : public RtpFileReaderImpl {
     } else if (protocol == kProtocolUdp) {
       uint16_t length;
       uint16_t checksum;
-      TRY_PCAP(Read(&marker->source_port, true));
-      TRY_PCAP(Read(&marker->dest_port, true));
-      TRY_PCAP(Read(&length, true));
-      TRY_PCAP(Read(&checksum, true));
+      TRY_PCAP(ReadOrEnd(&marker->source_port, true));
+      TRY_PCAP(ReadOrEnd(&marker->dest_port, true));
+      TRY_PCAP(ReadOrEnd(&length, true));
+      TRY_PCAP(ReadOrEnd(&checksum, true));
       marker->payload_length = length - kUdpHeaderLength;
     } else {
       RTC_LOG(LS_INFO) << "Unknown transport (expected UDP or TCP)";
@@ -559,11 +707,25 @@ class PcapReader : public RtpFileReaderImpl {
     return kResultSuccess;
   }
 
+  // Like Read(), but a truncated read is the end of the file.
+  template <typename T>
+  int ReadOrEnd(T* out, bool expect_network_order) {
+    int result = Read(out, expect_network_order);
+    if (result == kResultFail) {
+      at_end_ = true;
+    }
+    return result;
+  }
+
   int Read(uint32_t* out, bool expect_network_order) {
     uint32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
+    rtc::ArrayView<const uint8_t> data =
+        file_->Read(pos_, sizeof(uint32_t));
+    if (data.size() < sizeof(uint32_t)) {
       return kResultFail;
     }
+    memcpy(&tmp, data.data(), sizeof(uint32_t));
+    pos_ += sizeof(uint32_t);
     if ((!expect_network_order && swap_pcap_byte_order_) ||
         (expect_network_order && swap_network_byte_order_)) {
       tmp = ((tmp >> 24) & 0x000000ff) | (tmp << 24) |
@@ -575,9 +737,13 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Read(uint16_t* out, bool expect_network_order) {
     uint16_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint16_t), file_) != sizeof(uint16_t)) {
+    rtc::ArrayView<const uint8_t> data =
+        file_->Read(pos_, sizeof(uint16_t));
+    if (data.size() < sizeof(uint16_t)) {
       return kResultFail;
     }
+    memcpy(&tmp, data.data(), sizeof(uint16_t));
+    pos_ += sizeof(uint16_t);
     if ((!expect_network_order && swap_pcap_byte_order_) ||
         (expect_network_order && swap_network_byte_order_)) {
       tmp = ((tmp >> 8) & 0x00ff) | (tmp << 8);
@@ -586,42 +752,29 @@ class PcapReader : public RtpFileReaderImpl {
     return kResultSuccess;
   }
 
-  int Read(uint8_t* out, uint32_t count) {
-    if (fread(out, 1, count, file_) != count) {
-      return kResultFail;
-    }
-    return kResultSuccess;
-  }
-
   int Read(int32_t* out, bool expect_network_order) {
-    int32_t tmp = 0;
-    if (fread(&tmp, 1, sizeof(uint32_t), file_) != sizeof(uint32_t)) {
-      return kResultFail;
-    }
-    if ((!expect_network_order && swap_pcap_byte_order_) ||
-        (expect_network_order && swap_network_byte_order_)) {
-      tmp = ((tmp >> 24) & 0x000000ff) | (tmp << 24) |
-            ((tmp >> 8) & 0x0000ff00) | ((tmp << 8) & 0x00ff0000);
-    }
-    *out = tmp;
-    return kResultSuccess;
+    uint32_t tmp = 0;
+    int result = Read(&tmp, expect_network_order);
+    *out = static_cast<int32_t>(tmp);
+    return result;
   }
 
   int Skip(uint32_t length) {
-    if (fseek(file_, length, SEEK_CUR) != 0) {
+    if (file_->Read(pos_, length).size() < length) {
+      at_end_ = true;
       return kResultFail;
     }
+    pos_ += length;
     return kResultSuccess;
   }
 
-  FILE* file_;
   bool swap_pcap_byte_order_;
   const bool swap_network_byte_order_;
-  uint8_t read_buffer_[kMaxReadBufferSize];
 
-  SsrcMap packets_by_ssrc_;
-  std::vector<RtpPacketMarker> packets_;
-  PacketIterator next_packet_it_;
+  // Only used while indexing.
+  const FileContents* file_ = nullptr;
+  size_t pos_ = 0;
+  bool at_end_ = false;
 };
 
 RtpFileReaderImpl* CreateReaderForFormat(RtpFileReader::FileFormat format) {
@@ -645,20 +798,7 @@ RtpFileReader* RtpFileReader::Create(FileFormat format,
                                      size_t size,
                                      const std::set<uint32_t>& ssrc_filter) {
   std::unique_ptr<RtpFileReaderImpl> reader(CreateReaderForFormat(format));
-
-  FILE* file = tmpfile();
-  if (file == nullptr) {
-    printf("ERROR: Can't open file from memory buffer\n");
-    return nullptr;
-  }
-
-  if (fwrite(reinterpret_cast<const void*>(data), sizeof(uint8_t), size,
-             file) != size) {
-    return nullptr;
-  }
-  rewind(file);
-
-  if (!reader->Init(file, ssrc_filter)) {
+  if (!reader->Init(FileContents::Copy(data, size), ssrc_filter)) {
     return nullptr;
   }
   return reader.release();
@@ -667,19 +807,17 @@ RtpFileReader* RtpFileReader::Create(FileFormat format,
 RtpFileReader* RtpFileReader::Create(FileFormat format,
                                      absl::string_view filename,
                                      const std::set<uint32_t>& ssrc_filter) {
-  RtpFileReaderImpl* reader = CreateReaderForFormat(format);
-  std::string filename_str = std::string(filename);
-  FILE* file = fopen(filename_str.c_str(), "rb");
-  if (file == nullptr) {
-    printf("ERROR: Can't open file: %s\n", filename_str.c_str());
+  std::unique_ptr<FileContents> contents = FileContents::Open(filename);
+  if (!contents) {
+    printf("ERROR: Can't open file: %s\n", std::string(filename).c_str());
     return nullptr;
   }
 
-  if (!reader->Init(file, ssrc_filter)) {
-    delete reader;
+  std::unique_ptr<RtpFileReaderImpl> reader(CreateReaderForFormat(format));
+  if (!reader->Init(std::move(contents), ssrc_filter)) {
     return nullptr;
   }
-  return reader;
+  return reader.release();
 }
 
 RtpFileReader* RtpFileReader::Create(FileFormat format,
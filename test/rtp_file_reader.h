@@ -12,8 +12,10 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 
 namespace webrtc {
 namespace test {
@@ -31,6 +33,19 @@ struct RtpPacket {
   uint32_t time_ms;
 };
 
+// A packet returned by RtpFileReader::GetPacket().
+struct RtpPacketView {
+  rtc::ArrayView<const uint8_t> data;
+  // See RtpPacket.
+  size_t original_length;
+  uint32_t time_ms;
+};
+
+// Reads the packets of a file, which is indexed when the reader is created.
+// Besides reading the packets in order, they can be accessed by index and
+// looked up by time, SSRC and payload type. The file is memory mapped where
+// possible, so that accessing a packet doesn't copy it, and otherwise read
+// from disk as the packets are accessed.
 class RtpFileReader {
  public:
   enum FileFormat { kPcap, kRtpDump, kLengthPacketInterleaved };
@@ -45,6 +60,24 @@ class RtpFileReader {
                                absl::string_view filename,
                                const std::set<uint32_t>& ssrc_filter);
   virtual bool NextPacket(RtpPacket* packet) = 0;
+
+  // Returns the number of packets in the file that passed the SSRC filter.
+  virtual size_t NumPackets() const = 0;
+  // Returns packet `index`. Its data is only guaranteed to stay valid until the
+  // next call to GetPacket() or NextPacket().
+  virtual RtpPacketView GetPacket(size_t index) const = 0;
+  // Makes NextPacket() continue from packet `index`.
+  virtual void SeekToPacket(size_t index) = 0;
+  // Makes NextPacket() continue from the first packet at or after `time_ms`,
+  // assuming the packets are in time order, and returns its index. Returns
+  // NumPackets() if there is no such packet.
+  virtual size_t SeekToTime(uint32_t time_ms) = 0;
+  // Returns, in order, the indices of the RTP packets with one of `ssrcs` and
+  // one of `payload_types`. Empty sets match all packets. Only the index is
+  // searched, so this doesn't touch the packet data.
+  virtual std::vector<size_t> FindRtpPackets(
+      const std::set<uint32_t>& ssrcs,
+      const std::set<uint8_t>& payload_types) const = 0;
 };
 }  // namespace test
 }  // namespace webrtc
@@ -10,11 +10,17 @@
 
 #include "test/rtp_file_reader.h"
 
+#include <string.h>
+
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "api/array_view.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
+#include "rtc_base/system/file_wrapper.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -123,4 +129,251 @@ TEST_F(TestPcapFileReader, TestThreeSsrc) {
   EXPECT_EQ(113, pps[0x59fe6ef0]);
   EXPECT_EQ(61, pps[0xed2bd2ac]);
 }
+
+namespace {
+
+// Returns a 12 byte RTP header followed by `payload_size` bytes.
+std::vector<uint8_t> MakeRtpPacket(uint32_t ssrc,
+                                   uint8_t payload_type,
+                                   uint16_t sequence_number,
+                                   size_t payload_size = 4) {
+  std::vector<uint8_t> packet(12 + payload_size, 0xab);
+  packet[0] = 0x80;
+  packet[1] = payload_type;
+  ByteWriter<uint16_t>::WriteBigEndian(&packet[2], sequence_number);
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[4], 0);
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[8], ssrc);
+  return packet;
+}
+
+// Builds an rtpdump file of packets sent at `times_ms`.
+class RtpDumpBuilder {
+ public:
+  RtpDumpBuilder() {
+    const char kFirstLine[] = "#!rtpplay1.0 127.0.0.1/5000\n";
+    data_.assign(kFirstLine, kFirstLine + strlen(kFirstLine));
+    data_.resize(data_.size() + 16);
+  }
+
+  void AddPacket(const std::vector<uint8_t>& packet, uint32_t time_ms) {
+    size_t pos = data_.size();
+    data_.resize(pos + 8);
+    ByteWriter<uint16_t>::WriteBigEndian(&data_[pos], packet.size() + 8);
+    ByteWriter<uint16_t>::WriteBigEndian(&data_[pos + 2], packet.size());
+    ByteWriter<uint32_t>::WriteBigEndian(&data_[pos + 4], time_ms);
+    data_.insert(data_.end(), packet.begin(), packet.end());
+  }
+
+  const std::vector<uint8_t>& data() const { return data_; }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+// Builds a pcap file of IPv4 UDP packets on a BSD loopback interface.
+class PcapBuilder {
+ public:
+  PcapBuilder() {
+    AppendNative<uint32_t>(0xa1b2c3d4);  // Magic.
+    AppendNative<uint16_t>(2);           // Version.
+    AppendNative<uint16_t>(4);
+    AppendNative<int32_t>(0);       // Time zone.
+    AppendNative<uint32_t>(0);      // Timestamp accuracy.
+    AppendNative<uint32_t>(65535);  // Snapshot length.
+    AppendNative<uint32_t>(0);      // LINKTYPE_NULL.
+  }
+
+  void AddPacket(const std::vector<uint8_t>& payload, uint64_t time_us) {
+    const size_t udp_length = 8 + payload.size();
+    const size_t frame_length = 4 + 20 + udp_length;
+    AppendNative<uint32_t>(time_us / 1000000);
+    AppendNative<uint32_t>(time_us % 1000000);
+    AppendNative<uint32_t>(frame_length);
+    AppendNative<uint32_t>(frame_length);
+
+    AppendNative<uint32_t>(2);  // AF_INET.
+    size_t pos = data_.size();
+    data_.resize(pos + 20 + 8);
+    uint8_t* ip = &data_[pos];
+    ByteWriter<uint16_t>::WriteBigEndian(&ip[0], 0x4500);
+    ByteWriter<uint16_t>::WriteBigEndian(&ip[2], 20 + udp_length);
+    ByteWriter<uint16_t>::WriteBigEndian(&ip[8], 0x4011);  // TTL, UDP.
+    ByteWriter<uint32_t>::WriteBigEndian(&ip[12], 0x7f000001);
+    ByteWriter<uint32_t>::WriteBigEndian(&ip[16], 0x7f000001);
+    uint8_t* udp = ip + 20;
+    ByteWriter<uint16_t>::WriteBigEndian(&udp[0], 5000);
+    ByteWriter<uint16_t>::WriteBigEndian(&udp[2], 5001);
+    ByteWriter<uint16_t>::WriteBigEndian(&udp[4], udp_length);
+    data_.insert(data_.end(), payload.begin(), payload.end());
+  }
+
+  const std::vector<uint8_t>& data() const { return data_; }
+
+ private:
+  template <typename T>
+  void AppendNative(T value) {
+    size_t pos = data_.size();
+    data_.resize(pos + sizeof(T));
+    memcpy(&data_[pos], &value, sizeof(T));
+  }
+
+  std::vector<uint8_t> data_;
+};
+
+std::unique_ptr<test::RtpFileReader> CreateReader(
+    test::RtpFileReader::FileFormat format,
+    const std::vector<uint8_t>& data,
+    const std::set<uint32_t>& ssrc_filter = {}) {
+  return std::unique_ptr<test::RtpFileReader>(test::RtpFileReader::Create(
+      format, data.data(), data.size(), ssrc_filter));
+}
+
+}  // namespace
+
+TEST(RtpFileReaderIndexTest, GetsRtpDumpPacketsByIndex) {
+  RtpDumpBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(1, 96, 1, /*payload_size=*/10), 20);
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kRtpDump, builder.data());
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->NumPackets(), 2u);
+
+  test::RtpPacketView view = reader->GetPacket(1);
+  EXPECT_EQ(view.data.size(), 22u);
+  EXPECT_EQ(view.original_length, 22u);
+  EXPECT_EQ(view.time_ms, 20u);
+  EXPECT_EQ(ParseRtpSequenceNumber(view.data), 1);
+
+  // Reading by index doesn't move the read position.
+  test::RtpPacket packet;
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.time_ms, 0u);
+  EXPECT_EQ(packet.length, 16u);
+}
+
+TEST(RtpFileReaderIndexTest, IgnoresTruncatedRtpDumpPacket) {
+  RtpDumpBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(1, 96, 1), 20);
+  std::vector<uint8_t> data = builder.data();
+  data.pop_back();
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kRtpDump, data);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->NumPackets(), 1u);
+}
+
+TEST(RtpFileReaderIndexTest, SeeksToTimeAndPacket) {
+  RtpDumpBuilder builder;
+  for (uint16_t i = 0; i < 10; ++i)
+    builder.AddPacket(MakeRtpPacket(1, 96, i), i * 10);
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kRtpDump, builder.data());
+  ASSERT_TRUE(reader);
+
+  test::RtpPacket packet;
+  EXPECT_EQ(reader->SeekToTime(35), 4u);
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.time_ms, 40u);
+  EXPECT_EQ(reader->SeekToTime(50), 5u);
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.time_ms, 50u);
+
+  EXPECT_EQ(reader->SeekToTime(1000), 10u);
+  EXPECT_FALSE(reader->NextPacket(&packet));
+
+  reader->SeekToPacket(0);
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.time_ms, 0u);
+}
+
+TEST(RtpFileReaderIndexTest, FindsRtpPacketsBySsrcAndPayloadType) {
+  RtpDumpBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(2, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(1, 97, 1), 10);
+  builder.AddPacket({0x80, 200, 0, 1, 0, 0, 0, 1}, 10);  // RTCP SR.
+  builder.AddPacket(MakeRtpPacket(2, 97, 1), 10);
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kRtpDump, builder.data());
+  ASSERT_TRUE(reader);
+
+  EXPECT_EQ(reader->FindRtpPackets({}, {}), (std::vector<size_t>{0, 1, 2, 4}));
+  EXPECT_EQ(reader->FindRtpPackets({1}, {}), (std::vector<size_t>{0, 2}));
+  EXPECT_EQ(reader->FindRtpPackets({}, {97}), (std::vector<size_t>{2, 4}));
+  EXPECT_EQ(reader->FindRtpPackets({2}, {96}), (std::vector<size_t>{1}));
+  EXPECT_TRUE(reader->FindRtpPackets({3}, {}).empty());
+}
+
+TEST(RtpFileReaderIndexTest, IndexesPcapPackets) {
+  PcapBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 1000000);
+  builder.AddPacket(MakeRtpPacket(2, 97, 0), 1020400);
+  builder.AddPacket(MakeRtpPacket(1, 96, 1), 1040600);
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kPcap, builder.data());
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->NumPackets(), 3u);
+
+  // Times are relative to the first packet, rounded to ms.
+  EXPECT_EQ(reader->GetPacket(0).time_ms, 0u);
+  EXPECT_EQ(reader->GetPacket(1).time_ms, 20u);
+  EXPECT_EQ(reader->GetPacket(2).time_ms, 41u);
+  EXPECT_EQ(ParseRtpSsrc(reader->GetPacket(1).data), 2u);
+  EXPECT_EQ(reader->FindRtpPackets({1}, {}), (std::vector<size_t>{0, 2}));
+
+  test::RtpPacket packet;
+  reader->SeekToPacket(2);
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.length, 16u);
+  EXPECT_EQ(ParseRtpSequenceNumber(
+                rtc::ArrayView<const uint8_t>(packet.data, packet.length)),
+            1);
+  EXPECT_FALSE(reader->NextPacket(&packet));
+}
+
+TEST(RtpFileReaderIndexTest, FiltersPcapPacketsBySsrc) {
+  PcapBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(2, 97, 0), 10000);
+  builder.AddPacket(MakeRtpPacket(1, 96, 1), 20000);
+  std::unique_ptr<test::RtpFileReader> reader =
+      CreateReader(test::RtpFileReader::kPcap, builder.data(), {2});
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->NumPackets(), 1u);
+  EXPECT_EQ(ParseRtpSsrc(reader->GetPacket(0).data), 2u);
+}
+
+TEST(RtpFileReaderIndexTest, ReadsPacketsFromFile) {
+  PcapBuilder builder;
+  builder.AddPacket(MakeRtpPacket(1, 96, 0), 0);
+  builder.AddPacket(MakeRtpPacket(2, 97, 0, /*payload_size=*/100), 10000);
+  builder.AddPacket(MakeRtpPacket(1, 96, 1), 20000);
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "rtp_file_reader");
+  FileWrapper file = FileWrapper::OpenWriteOnly(filename);
+  ASSERT_TRUE(file.is_open());
+  ASSERT_TRUE(file.Write(builder.data().data(), builder.data().size()));
+  file.Close();
+
+  std::unique_ptr<test::RtpFileReader> reader(
+      test::RtpFileReader::Create(test::RtpFileReader::kPcap, filename));
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->NumPackets(), 3u);
+  EXPECT_EQ(reader->GetPacket(1).data.size(), 112u);
+  EXPECT_EQ(ParseRtpSequenceNumber(reader->GetPacket(2).data), 1);
+  EXPECT_EQ(ParseRtpSsrc(reader->GetPacket(1).data), 2u);
+
+  test::RtpPacket packet;
+  ASSERT_TRUE(reader->NextPacket(&packet));
+  EXPECT_EQ(packet.length, 16u);
+  EXPECT_EQ(ParseRtpSsrc(
+                rtc::ArrayView<const uint8_t>(packet.data, packet.length)),
+            1u);
+
+  reader.reset();
+  test::RemoveFile(filename);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoded_stream_recorder.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Keeps what the recording needs from a frame, which is only valid during the
+// recording callback. The encoded data is shared, not copied.
+class RecordedFrame : public RecordableEncodedFrame {
+ public:
+  explicit RecordedFrame(const RecordableEncodedFrame& frame)
+      : buffer_(frame.encoded_buffer()),
+        codec_(frame.codec()),
+        is_key_frame_(frame.is_key_frame()),
+        resolution_(frame.resolution()),
+        render_time_(frame.render_time()) {}
+
+  rtc::scoped_refptr<const EncodedImageBufferInterface> encoded_buffer()
+      const override {
+    return buffer_;
+  }
+  absl::optional<ColorSpace> color_space() const override {
+    return absl::nullopt;
+  }
+  VideoCodecType codec() const override { return codec_; }
+  bool is_key_frame() const override { return is_key_frame_; }
+  EncodedResolution resolution() const override { return resolution_; }
+  Timestamp render_time() const override { return render_time_; }
+
+ private:
+  const rtc::scoped_refptr<const EncodedImageBufferInterface> buffer_;
+  const VideoCodecType codec_;
+  const bool is_key_frame_;
+  const EncodedResolution resolution_;
+  const Timestamp render_time_;
+};
+
+}  // namespace
+
+constexpr TimeDelta EncodedStreamRecorder::kWriteInterval;
+
+EncodedStreamRecorder::EncodedStreamRecorder(
+    TaskQueueFactory* task_queue_factory)
+    : task_queue_(task_queue_factory->CreateTaskQueue(
+          "EncodedStreamRecorder",
+          TaskQueueFactory::Priority::LOW)) {
+  sequence_checker_.Detach();
+}
+
+EncodedStreamRecorder::~EncodedStreamRecorder() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // The streams would otherwise keep delivering frames to `this`.
+  while (!streams_.empty()) {
+    StopRecording(*streams_.begin());
+  }
+  recording_ids_.clear();
+  rtc::Event done;
+  task_queue_->PostTask([this, &done] {
+    WritePendingFrames();
+    recordings_.clear();
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+}
+
+bool EncodedStreamRecorder::StartRecording(VideoReceiveStreamInterface* stream,
+                                           FileWrapper file,
+                                           size_t byte_limit) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  FrameCallback callback = AddRecording(stream, std::move(file), byte_limit);
+  if (!callback)
+    return false;
+  streams_.insert(stream);
+  // The previous recording state, if any, is dropped.
+  stream->SetAndGetRecordingState(
+      VideoReceiveStreamInterface::RecordingState(std::move(callback)),
+      /*generate_key_frame=*/true);
+  return true;
+}
+
+void EncodedStreamRecorder::StopRecording(
+    VideoReceiveStreamInterface* stream) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (streams_.erase(stream) == 0)
+    return;
+  // Once this returns, the stream no longer delivers frames.
+  stream->SetAndGetRecordingState(VideoReceiveStreamInterface::RecordingState(),
+                                  /*generate_key_frame=*/false);
+  RemoveRecording(stream);
+}
+
+EncodedStreamRecorder::FrameCallback EncodedStreamRecorder::AddRecording(
+    const void* source,
+    FileWrapper file,
+    size_t byte_limit) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (!file.is_open() || recording_ids_.find(source) != recording_ids_.end())
+    return nullptr;
+  const int recording_id = next_recording_id_++;
+  recording_ids_[source] = recording_id;
+  task_queue_->PostTask([this, recording_id, file = std::move(file),
+                         byte_limit]() mutable {
+    recordings_[recording_id].writer =
+        IvfFileWriter::Wrap(std::move(file), byte_limit);
+  });
+  return [this, recording_id](const RecordableEncodedFrame& frame) {
+    OnFrame(recording_id, frame);
+  };
+}
+
+void EncodedStreamRecorder::RemoveRecording(const void* source) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = recording_ids_.find(source);
+  if (it == recording_ids_.end())
+    return;
+  const int recording_id = it->second;
+  recording_ids_.erase(it);
+  task_queue_->PostTask([this, recording_id] {
+    WritePendingFrames();
+    recordings_.erase(recording_id);
+  });
+}
+
+void EncodedStreamRecorder::OnFrame(int recording_id,
+                                    const RecordableEncodedFrame& frame) {
+  MutexLock lock(&mutex_);
+  pending_frames_.push_back(
+      {recording_id, std::make_unique<RecordedFrame>(frame)});
+  if (write_scheduled_)
+    return;
+  write_scheduled_ = true;
+  task_queue_->PostDelayedTask([this] { WritePendingFrames(); },
+                               kWriteInterval);
+}
+
+void EncodedStreamRecorder::WritePendingFrames() {
+  RTC_DCHECK_RUN_ON(task_queue_.get());
+  std::vector<PendingFrame> frames;
+  {
+    MutexLock lock(&mutex_);
+    frames.swap(pending_frames_);
+    write_scheduled_ = false;
+  }
+  for (const PendingFrame& pending : frames) {
+    auto it = recordings_.find(pending.recording_id);
+    if (it == recordings_.end())
+      continue;
+    Recording& recording = it->second;
+    if (!recording.got_key_frame) {
+      if (!pending.frame->is_key_frame())
+        continue;
+      recording.got_key_frame = true;
+    }
+    if (!recording.writer->WriteFrame(*pending.frame)) {
+      RTC_LOG(LS_WARNING) << "Stopped recording after failing to write a "
+                             "frame.";
+      recordings_.erase(it);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ENCODED_STREAM_RECORDER_H_
+#define VIDEO_ENCODED_STREAM_RECORDER_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/video/recordable_encoded_frame.h"
+#include "call/video_receive_stream.h"
+#include "modules/video_coding/utility/ivf_file_writer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Records the encoded video of receive streams to IVF files, without decoding
+// it. The frames are handed to a background task queue, which writes them in
+// batches, so the receive path only pays for taking a reference to each
+// frame.
+class EncodedStreamRecorder {
+ public:
+  // Callback taking the frames of a recording, on any thread.
+  using FrameCallback = std::function<void(const RecordableEncodedFrame&)>;
+
+  // Pending frames are written at least this often.
+  static constexpr TimeDelta kWriteInterval = TimeDelta::Millis(200);
+
+  explicit EncodedStreamRecorder(TaskQueueFactory* task_queue_factory);
+  // Stops all the recordings, and blocks until their files are written. Must
+  // be called on the worker thread of the streams still being recorded, which
+  // must not have been destroyed yet. The callbacks returned by
+  // AddRecording() must not be called anymore.
+  ~EncodedStreamRecorder();
+
+  // Records `stream` to `file`, which is closed when reaching `byte_limit`
+  // (0 for no limit). Asks the sender for a key frame, since the frames before
+  // the first key frame can't be decoded from the file and are dropped. Must be
+  // called on the stream's worker thread. Returns false if the stream is
+  // already being recorded or the file isn't open.
+  bool StartRecording(VideoReceiveStreamInterface* stream,
+                      FileWrapper file,
+                      size_t byte_limit = 0);
+  // Stops recording `stream`. Its file is closed once the frames received so
+  // far are written.
+  void StopRecording(VideoReceiveStreamInterface* stream);
+
+  // Same as above for frames that don't come from a receive stream: they are
+  // passed to the returned callback, and `source` identifies the recording.
+  // Returns nullptr if `source` is already being recorded or the file isn't
+  // open.
+  FrameCallback AddRecording(const void* source,
+                             FileWrapper file,
+                             size_t byte_limit = 0);
+  void RemoveRecording(const void* source);
+
+ private:
+  struct Recording {
+    std::unique_ptr<IvfFileWriter> writer;
+    bool got_key_frame = false;
+  };
+  struct PendingFrame {
+    int recording_id;
+    std::unique_ptr<RecordableEncodedFrame> frame;
+  };
+
+  void OnFrame(int recording_id, const RecordableEncodedFrame& frame);
+  void WritePendingFrames();
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  std::map<const void*, int> recording_ids_ RTC_GUARDED_BY(sequence_checker_);
+  // The streams recorded with StartRecording().
+  std::set<VideoReceiveStreamInterface*> streams_
+      RTC_GUARDED_BY(sequence_checker_);
+  int next_recording_id_ RTC_GUARDED_BY(sequence_checker_) = 0;
+
+  Mutex mutex_;
+  std::vector<PendingFrame> pending_frames_ RTC_GUARDED_BY(mutex_);
+  bool write_scheduled_ RTC_GUARDED_BY(mutex_) = false;
+
+  // Only accessed on `task_queue_`.
+  std::map<int, Recording> recordings_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ENCODED_STREAM_RECORDER_H_
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2023 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoded_stream_recorder.h"
+
+#include <memory>
+#include <string>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/video/encoded_image.h"
+#include "modules/video_coding/utility/ivf_file_reader.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+class FakeFrame : public RecordableEncodedFrame {
+ public:
+  FakeFrame(uint8_t value, bool key_frame, int64_t render_time_ms)
+      : buffer_(EncodedImageBuffer::Create(&value, 1)),
+        key_frame_(key_frame),
+        render_time_ms_(render_time_ms) {}
+
+  rtc::scoped_refptr<const EncodedImageBufferInterface> encoded_buffer()
+      const override {
+    return buffer_;
+  }
+  absl::optional<ColorSpace> color_space() const override {
+    return absl::nullopt;
+  }
+  VideoCodecType codec() const override { return kVideoCodecVP8; }
+  bool is_key_frame() const override { return key_frame_; }
+  EncodedResolution resolution() const override { return {320, 180}; }
+  Timestamp render_time() const override {
+    return Timestamp::Millis(render_time_ms_);
+  }
+
+ private:
+  const rtc::scoped_refptr<EncodedImageBuffer> buffer_;
+  const bool key_frame_;
+  const int64_t render_time_ms_;
+};
+
+class EncodedStreamRecorderTest : public ::testing::Test {
+ protected:
+  EncodedStreamRecorderTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        recorder_(
+            std::make_unique<EncodedStreamRecorder>(task_queue_factory_.get())),
+        file_name_(test::TempFilename(test::OutputPath(), "recording")),
+        other_file_name_(test::TempFilename(test::OutputPath(), "recording")) {
+  }
+  ~EncodedStreamRecorderTest() override {
+    remove(file_name_.c_str());
+    remove(other_file_name_.c_str());
+  }
+
+  std::unique_ptr<IvfFileReader> OpenRecording(const std::string& file_name) {
+    return IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name));
+  }
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  std::unique_ptr<EncodedStreamRecorder> recorder_;
+  const std::string file_name_;
+  const std::string other_file_name_;
+  const int source_ = 0;
+  const int other_source_ = 0;
+};
+
+TEST_F(EncodedStreamRecorderTest, StartsAtFirstKeyFrame) {
+  EncodedStreamRecorder::FrameCallback callback = recorder_->AddRecording(
+      &source_, FileWrapper::OpenWriteOnly(file_name_));
+  ASSERT_TRUE(callback);
+  callback(FakeFrame(1, /*key_frame=*/false, 10));
+  callback(FakeFrame(2, /*key_frame=*/true, 20));
+  callback(FakeFrame(3, /*key_frame=*/false, 30));
+  recorder_->RemoveRecording(&source_);
+  recorder_ = nullptr;
+
+  std::unique_ptr<IvfFileReader> reader = OpenRecording(file_name_);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetVideoCodecType(), kVideoCodecVP8);
+  EXPECT_EQ(reader->GetFrameWidth(), 320);
+  EXPECT_EQ(reader->GetFrameHeight(), 180);
+  ASSERT_EQ(reader->GetFramesCount(), 2u);
+  absl::optional<EncodedImage> frame = reader->NextFrame();
+  ASSERT_TRUE(frame);
+  ASSERT_EQ(frame->size(), 1u);
+  EXPECT_EQ(frame->data()[0], 2);
+  EXPECT_EQ(frame->capture_time_ms_, 20);
+  frame = reader->NextFrame();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->data()[0], 3);
+}
+
+TEST_F(EncodedStreamRecorderTest, RecordsSourcesToSeparateFiles) {
+  EncodedStreamRecorder::FrameCallback callback = recorder_->AddRecording(
+      &source_, FileWrapper::OpenWriteOnly(file_name_));
+  EncodedStreamRecorder::FrameCallback other_callback =
+      recorder_->AddRecording(&other_source_,
+                              FileWrapper::OpenWriteOnly(other_file_name_));
+  ASSERT_TRUE(callback);
+  ASSERT_TRUE(other_callback);
+  // Only one recording per source.
+  EXPECT_FALSE(recorder_->AddRecording(
+      &source_, FileWrapper::OpenWriteOnly(other_file_name_)));
+
+  callback(FakeFrame(1, /*key_frame=*/true, 10));
+  other_callback(FakeFrame(2, /*key_frame=*/true, 10));
+  other_callback(FakeFrame(3, /*key_frame=*/false, 20));
+  recorder_->RemoveRecording(&source_);
+  recorder_->RemoveRecording(&other_source_);
+  recorder_ = nullptr;
+
+  std::unique_ptr<IvfFileReader> reader = OpenRecording(file_name_);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetFramesCount(), 1u);
+  reader = OpenRecording(other_file_name_);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetFramesCount(), 2u);
+}
+
+TEST_F(EncodedStreamRecorderTest, IgnoresFramesAfterRemoval) {
+  EncodedStreamRecorder::FrameCallback callback = recorder_->AddRecording(
+      &source_, FileWrapper::OpenWriteOnly(file_name_));
+  callback(FakeFrame(1, /*key_frame=*/true, 10));
+  recorder_->RemoveRecording(&source_);
+  callback(FakeFrame(2, /*key_frame=*/false, 20));
+  recorder_ = nullptr;
+
+  std::unique_ptr<IvfFileReader> reader = OpenRecording(file_name_);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetFramesCount(), 1u);
+}
+
+TEST_F(EncodedStreamRecorderTest, RejectsClosedFile) {
+  EXPECT_FALSE(recorder_->AddRecording(&source_, FileWrapper()));
+}
+
+}  // namespace
+}  // namespace webrtc
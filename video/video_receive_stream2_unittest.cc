@@ -17,6 +17,7 @@
 #include <memory>
 #include <ostream>
 #include <queue>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
 #include "api/metronome/test/fake_metronome.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/test/mock_video_decoder.h"
 #include "api/test/mock_video_decoder_factory.h"
 #include "api/test/time_controller.h"
@@ -42,7 +44,10 @@
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/video_coding/encoded_frame.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/ivf_file_reader.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/system/file_wrapper.h"
 #include "system_wrappers/include/clock.h"
 #include "test/fake_decoder.h"
 #include "test/fake_encoded_frame.h"
@@ -50,9 +55,11 @@
 #include "test/gtest.h"
 #include "test/mock_transport.h"
 #include "test/rtcp_packet_parser.h"
+#include "test/testsupport/file_utils.h"
 #include "test/time_controller/simulated_time_controller.h"
 #include "test/video_decoder_proxy_factory.h"
 #include "video/call_stats2.h"
+#include "video/encoded_stream_recorder.h"
 
 namespace webrtc {
 
@@ -680,6 +687,51 @@ TEST_P(VideoReceiveStream2Test, MovesEncodedFrameDispatchStateWhenReCreating) {
   video_receive_stream_->Stop();
 }
 
+TEST_P(VideoReceiveStream2Test, EncodedStreamRecorderRecordsFromKeyFrame) {
+  auto make_h264_frame = [](VideoFrameType frame_type, int picture_id) {
+    std::unique_ptr<test::FakeEncodedFrame> frame =
+        MakeFrame(frame_type, picture_id);
+    CodecSpecificInfo codec_specific;
+    codec_specific.codecType = kVideoCodecH264;
+    frame->SetCodecSpecific(&codec_specific);
+    return frame;
+  };
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "recording");
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  auto recorder =
+      std::make_unique<EncodedStreamRecorder>(task_queue_factory.get());
+  video_receive_stream_->Start();
+
+  ASSERT_TRUE(recorder->StartRecording(video_receive_stream_.get(),
+                                       FileWrapper::OpenWriteOnly(file_name)));
+  EXPECT_FALSE(recorder->StartRecording(
+      video_receive_stream_.get(), FileWrapper::OpenWriteOnly(file_name)));
+  video_receive_stream_->OnCompleteFrame(
+      make_h264_frame(VideoFrameType::kVideoFrameKey, 0));
+  EXPECT_THAT(fake_renderer_.WaitForFrame(kDefaultTimeOut), RenderedFrame());
+  EXPECT_THAT(rtcp_packet_parser_.pli()->num_packets(), Eq(1));
+  video_receive_stream_->OnCompleteFrame(
+      make_h264_frame(VideoFrameType::kVideoFrameDelta, 1));
+  EXPECT_THAT(fake_renderer_.WaitForFrame(kDefaultTimeOut), RenderedFrame());
+
+  // Destroying the recorder detaches it from the stream, which keeps running.
+  recorder = nullptr;
+  video_receive_stream_->OnCompleteFrame(
+      make_h264_frame(VideoFrameType::kVideoFrameDelta, 2));
+  EXPECT_THAT(fake_renderer_.WaitForFrame(kDefaultTimeOut), RenderedFrame());
+  video_receive_stream_->Stop();
+
+  std::unique_ptr<IvfFileReader> reader =
+      IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name));
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetVideoCodecType(), kVideoCodecH264);
+  EXPECT_EQ(reader->GetFramesCount(), 2u);
+  reader = nullptr;
+  remove(file_name.c_str());
+}
+
 TEST_P(VideoReceiveStream2Test, RequestsKeyFramesUntilKeyFrameReceived) {
   // Recreate receive stream with shorter delay to test rtx.
   TimeDelta rtx_delay = TimeDelta::Millis(50);